@@ -19,11 +19,13 @@ class OperatorType(Enum):
     RETURN = "return"
     WHILE = "while"
     FOR = "for"
+    LIST_COMPREHENSION = "list_comprehension"
     FUNC_DECLARATION = "func_declaration"
     CLASS_DECLARATION = "class_declaration"
     PASS = "pass"
     BREAK = "break"
     CONTINUE = "continue"
+    KEYWORD_ARGUMENT = "keyword_argument"
 
     def __repr__(self) -> str:
         return self.value.lower()
@@ -61,6 +63,9 @@ class Operand(Enum):
 
     ARGUMENT = 21
     DEFAULT = 22
+    ELEMENT = 23
+    KEYWORD = 24
+    VALUE = 25
 
     def __repr__(self) -> str:
         return str(self.name).lower()
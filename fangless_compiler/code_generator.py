@@ -9,6 +9,14 @@ from abstract_syntax_tree.name_node import (
 from common import (
     BUILTIN_FUNCTIONS,
     BUILTIN_METHODS,
+    KEY_FUNCTIONS,
+)
+from exceptions import GeneratorError
+from string_formatting import (
+    FormatError,
+    parse_format_spec,
+    split_format_string,
+    split_percent_string,
 )
 
 from graph_operations import topological_sort
@@ -26,11 +34,70 @@ NOT_A_OPERATOR_NODE = (
     NameNode,
 )
 
+# Int literals whose digits do not fit in a C++ int64 literal, INT64_MIN
+# included, are built from their digits
+INT64_MAX = 2**63 - 1
+
+# Augmented assignments without a C++ compound operator, the builtins
+# update the target in place like the operators do
+IN_PLACE_BUILTINS = {
+    "//=": "intDivAssign",
+    "**=": "powAssign",
+}
+
+# Operators the C++ objects lack, a key function can not apply them to the
+# elements it receives
+OBJECT_ARITHMETIC = {
+    "+", "-", "*", "/", "%", "&", "|", "^", "<<", ">>", "~", "**", "//",
+    "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>=", "**=",
+    "//=",
+}
+
+# StringFormat::Spec setters, in the order the spec syntax lists them
+SPEC_FIELDS = (
+    "fill",
+    "align",
+    "sign",
+    "noNegativeZero",
+    "alternate",
+    "zero",
+    "width",
+    "grouping",
+    "precision",
+    "type",
+    "conversion",
+    "percent",
+)
+
+
+def cpp_string(text: str) -> str:
+    """Quotes text as a C++ literal, escape sequences are kept as written"""
+    quoted = ""
+    escaped = False
+    for char in text:
+        if char == '"' and not escaped:
+            quoted += "\\"
+        escaped = char == "\\" and not escaped
+        quoted += char
+    return f'"{quoted}"'
+
+
+def cpp_spec_value(field: str, value) -> str:
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    if isinstance(value, int):
+        return str(value)
+    if field == "fill":
+        return cpp_string(value)
+    return f"'{value}'"
+
+
 class FanglessGenerator:
     def __init__(self) -> None:
         self.iter_count = 0
 
         self.function_definitions: dict = {}
+        self.function_trees: dict = {}
 
         self.operator_handlers: dict = {
             OperatorType.TERNARY: self.visit_ternary,
@@ -47,6 +114,7 @@ class FanglessGenerator:
             OperatorType.RETURN: self.visit_return,
             OperatorType.WHILE: self.visit_while,
             OperatorType.FOR: self.visit_for,
+            OperatorType.LIST_COMPREHENSION: self.visit_list_comprehension,
             OperatorType.FUNC_DECLARATION: self.visit_func_declaration,
             OperatorType.CLASS_DECLARATION: self.visit_class_declaration,
             OperatorType.PASS: self.visit_pass,
@@ -56,7 +124,7 @@ class FanglessGenerator:
             "-": self.visit_unary_or_binary,
             "*": self.visit_direct_binary,
             "/": self.visit_direct_binary,
-            "%": self.visit_direct_binary,
+            "%": self.visit_modulo,
             "&": self.visit_direct_binary,
             "|": self.visit_direct_binary,
             "^": self.visit_direct_binary,
@@ -148,10 +216,17 @@ class FanglessGenerator:
             bool_instance = "true" if instance else "false"
             return f"Bool::spawn({bool_instance})"
         if isinstance(instance, str):
-            return f'String::spawn("{instance}")'
+            return f'String::literal<"{instance}">()'
         if instance is None:
             return "None::spawn()"
-        if isinstance(instance, (int, float)):
+        if isinstance(instance, int) and abs(instance) > INT64_MAX:
+            return (
+                f'Number::spawn(BigInt::fromDigits("{abs(instance)}", 10, '
+                f'{"true" if instance < 0 else "false"}))'
+            )
+        if isinstance(instance, int):
+            return f"Number::literal<{instance}>()"
+        if isinstance(instance, float):
             return f"Number::spawn({instance})"
 
         return f"{instance.id}"
@@ -221,18 +296,22 @@ class FanglessGenerator:
         return operation
 
     def visit_function_call(self, tree: OperatorNode) -> None:
-        parameters_str = ""
         parameters = tree.get_adjacent(Operand.ARGUMENTS)
 
-        for parameter in parameters:
-            parameters_str += f"{self.visit_tree([parameter])}, "
-
-        if len(parameters) > 0:
-            parameters_str = parameters_str[:-2]
-
         function_name = tree.get_adjacent(Operand.FUNCTION_NAME)
         function_name = function_name.id
 
+        column_sum = self.column_sum(function_name, parameters)
+        if column_sum is not None:
+            return column_sum
+
+        parameters_str = ", ".join(
+            self.visit_call_arguments(function_name, parameters)
+        )
+
+        if function_name == "format" and 1 <= len(parameters) <= 2:
+            return self.visit_format_builtin(parameters)
+
         builtin_function: bool = (function_name in BUILTIN_FUNCTIONS)
         namespace = ""
         if  builtin_function or function_name in BUILTIN_METHODS:
@@ -243,14 +322,200 @@ class FanglessGenerator:
             )
             if function_name in {"bool", "float", "int", "union", "isascii"}:
                 function_name += "_"
+            # module functions live in a namespace named after the module
+            function_name = function_name.replace(".", "::")
         else:
             namespace = "GF::"
             parameters_str = f"Function::spawnArgs({parameters_str})"
 
         return f"{namespace}{function_name}({parameters_str})"
 
+    def column_sum(self, function_name: str, parameters: list) -> str | None:
+        """sum([r[1] for r in rows]) adds the field up without building the
+        list, over the stored values when rows is a column list
+        """
+        if not (
+            function_name == "sum"
+            and len(parameters) == 1
+            and isinstance(parameters[0], OperatorNode)
+            and parameters[0].operator == OperatorType.LIST_COMPREHENSION
+        ):
+            return None
+
+        comprehension = parameters[0]
+        field = self.column_field(
+            comprehension.get_adjacent(Operand.SYMBOLS),
+            comprehension.get_adjacent(Operand.ELEMENT),
+        )
+        if field is None:
+            return None
+
+        source = self.visit_tree(
+            [comprehension.get_adjacent(Operand.FOR_LITERAL)]
+        )
+        return f"BF::columnSum({source}, {field})"
+
+    def visit_call_arguments(
+        self, function_name: str, parameters: list
+    ) -> list:
+        """Keyword arguments are only taken by sort and sorted, their key
+        and reverse are passed positionally, in that order
+        """
+        arguments = []
+        keywords = {}
+        for parameter in parameters:
+            if (
+                isinstance(parameter, OperatorNode)
+                and parameter.operator == OperatorType.KEYWORD_ARGUMENT
+            ):
+                keyword = parameter.get_adjacent(Operand.KEYWORD)
+                keywords[keyword] = parameter.get_adjacent(Operand.VALUE)
+            else:
+                arguments.append(self.visit_tree([parameter]))
+
+        if not keywords:
+            return arguments
+        if function_name not in {"sort", "sorted"} or not (
+            set(keywords) <= {"key", "reverse"}
+        ):
+            raise GeneratorError(
+                f"{function_name}() does not take the keyword arguments "
+                f"{', '.join(keywords)}"
+            )
+
+        key = keywords.get("key")
+        if key is not None:
+            arguments.append(self.visit_key_function(key))
+        if "reverse" in keywords:
+            arguments.append(self.visit_tree([keywords["reverse"]]))
+        return arguments
+
+    def visit_key_function(self, key) -> str:
+        """A key function is given by name, it is called on every element.
+        Elements come as Objects, so a builtin key must take any object
+        """
+        if not isinstance(key, NameNode):
+            raise GeneratorError("key must be the name of a function")
+        if key.id in BUILTIN_FUNCTIONS and key.id not in KEY_FUNCTIONS:
+            raise GeneratorError(
+                f"{key.id} can not be used as a key function, the builtin "
+                f"keys are {', '.join(sorted(KEY_FUNCTIONS))}"
+            )
+        self.check_key_function(key.id)
+
+        call = OperatorNode(OperatorType.FUNCTION_CALL)
+        call.add_named_adjacent(Operand.FUNCTION_NAME, NameNode(key.id))
+        call.add_named_adjacent(Operand.ARGUMENTS, [NameNode("item")])
+        return (
+            "[](const std::shared_ptr<Object>& item) { "
+            f"return {self.visit_function_call(call)}; }}"
+        )
+
+    def check_key_function(self, name: str) -> None:
+        """The body of a key function defined by the program receives the
+        element as an Object, which it can index, compare and pass on to
+        the builtin keys. Anything else would only fail in the C++ compiler
+        """
+        declaration = self.function_trees.get(name)
+        if declaration is None:
+            return
+
+        elements = set()
+        for argument in declaration.get_adjacent(Operand.ARGUMENTS):
+            if isinstance(argument, dict):
+                argument = argument[Operand.ARGUMENT]
+            elements.add(argument.id)
+
+        # names assigned an element, or an item of one, are objects too
+        pending = list(declaration.get_adjacent(Operand.BODY))
+        while pending:
+            node = pending.pop(0)
+            if isinstance(node, (list, tuple)):
+                pending[:0] = node
+                continue
+            if isinstance(node, dict):
+                pending[:0] = node.values()
+                continue
+            if not isinstance(node, OperatorNode):
+                continue
+
+            if node.operator in {
+                OperatorType.ASSIGNATION, OperatorType.VAR_DECLARATION,
+            }:
+                target = node.get_left_operand()
+                if isinstance(target, NameNode) and self.is_key_element(
+                    node.get_right_operand(), elements,
+                ):
+                    elements.add(target.id)
+
+            action = self.key_element_use(node, elements)
+            if action is not None:
+                raise GeneratorError(
+                    f"key function {name} {action} an element. Elements "
+                    "reach key functions as objects, which can only be "
+                    "indexed, compared and passed to "
+                    f"{', '.join(sorted(KEY_FUNCTIONS))}"
+                )
+            pending[:0] = node.adjacents.values()
+
+    def is_key_element(self, node, elements: set) -> bool:
+        if isinstance(node, NameNode):
+            return node.id in elements
+        return (
+            isinstance(node, OperatorNode)
+            and node.operator == OperatorType.INDEXING
+            and self.is_key_element(
+                node.get_adjacent(Operand.INSTANCE), elements,
+            )
+        )
+
+    def key_element_use(
+        self, node: OperatorNode, elements: set,
+    ) -> str | None:
+        """What node does to an element that objects do not support"""
+        if node.operator in OBJECT_ARITHMETIC:
+            if Operand.CENTER in node.adjacents:
+                operands = [node.get_adjacent(Operand.CENTER)]
+            else:
+                operands = [node.get_left_operand(), node.get_right_operand()]
+            # text concatenated with an object is its str()
+            if node.operator == "+" and any(
+                isinstance(operand, str) for operand in operands
+            ):
+                return None
+            if any(
+                self.is_key_element(operand, elements) for operand in operands
+            ):
+                return f"applies {node.operator} to"
+            return None
+
+        uses = {
+            OperatorType.METHOD_CALL: (Operand.INSTANCE, "calls a method of"),
+            OperatorType.ATTRIBUTE_CALL: (
+                Operand.INSTANCE, "reads an attribute of",
+            ),
+            OperatorType.SLICING: (Operand.INSTANCE, "slices"),
+            OperatorType.FOR: (Operand.FOR_LITERAL, "loops over"),
+        }
+        if node.operator not in uses:
+            return None
+        operand, action = uses[node.operator]
+        if self.is_key_element(node.get_adjacent(operand), elements):
+            return action
+        return None
+
     def visit_method_call(self, tree: OperatorNode) -> str:
         left_child = tree.get_adjacent(Operand.INSTANCE)
+        method = tree.get_adjacent(Operand.METHOD)
+        if (
+            isinstance(left_child, str)
+            and isinstance(method, OperatorNode)
+            and method.operator == OperatorType.FUNCTION_CALL
+            and method.get_adjacent(Operand.FUNCTION_NAME).id == "format"
+        ):
+            arguments = method.get_adjacent(Operand.ARGUMENTS)
+            return self.visit_format_template(left_child, arguments)
+
         left_child = self.visit_tree([left_child])
 
         right_child = tree.get_adjacent(Operand.METHOD)
@@ -289,6 +554,14 @@ class FanglessGenerator:
 
     def visit_assignation(self, tree: OperatorNode) -> str:
         left_child = tree.get_left_operand()
+        if (
+            isinstance(left_child, OperatorNode)
+            and left_child.operator == OperatorType.INDEXING
+        ):
+            return self.visit_item_assignation(
+                left_child, tree.get_right_operand()
+            )
+
         left_child = self.visit_tree([left_child])
 
         right_child = tree.get_right_operand()
@@ -304,6 +577,10 @@ class FanglessGenerator:
             code += right_child
             right_child = true_right_child
 
+        elif self.is_self_concatenation(tree):
+            value = self.visit_tree([right_child.get_right_operand()])
+            return f"BF::addAssign({left_child}, {value})"
+
         else:
             right_child = self.visit_tree([right_child])
 
@@ -313,6 +590,17 @@ class FanglessGenerator:
 
         return code
 
+    def visit_item_assignation(self, target: OperatorNode, value) -> str:
+        instance = target.get_adjacent(Operand.INSTANCE)
+        instance = self.visit_tree([instance])
+
+        index = target.get_adjacent(Operand.INDEX)
+        index = self.visit_tree([index])
+
+        value = self.visit_tree([value])
+
+        return f"BF::setItem({instance}, {index}, {value})"
+
     def visit_unpack_assignation(self, tree: OperatorNode) -> None:
         names = tree.get_left_operand()
         value = tree.get_right_operand()
@@ -426,24 +714,127 @@ class FanglessGenerator:
                 f"{post_define}"
             )
 
-        # Multiple symbols
-        body_pre_define = ""
-        body_pre_define += "auto tuple = symbols->asTuple();\n"
+        # Multiple symbols, the fields are read from each record in place
+        records = f"records_{self.iter_count}"
+        self.iter_count += 1
 
+        body_pre_define = ""
         for i, name in enumerate(for_symbols):
-            body_pre_define += (
-                f"auto {name.id} = tuple->at(Number::spawn({i}));\n"
-            )
+            body_pre_define += f"auto {name.id} = {records}.field({i});\n"
 
         body = self.visit_tree(body, is_standalone=True)
 
         return (
             f"{pre_define}"
-            f"for (auto symbols : *{for_literal})"
+            f"for (auto {records} = "
+            f"BF::records({for_literal}, {len(for_symbols)}); "
+            f"{records}.next();)"
             f" {{ \n {body_pre_define} {body} }}"
             f"{post_define}"
         )
   
+    def visit_list_comprehension(self, tree: OperatorNode) -> str:
+        for_literal = tree.get_adjacent(Operand.FOR_LITERAL)
+        for_symbols = tree.get_adjacent(Operand.SYMBOLS)
+        element = tree.get_adjacent(Operand.ELEMENT)
+
+        bulk = self.split_conversion(for_symbols, for_literal, element)
+        if bulk is not None:
+            return bulk
+
+        field = self.column_field(for_symbols, element)
+        if field is not None:
+            source = self.visit_tree([for_literal])
+            return f"BF::column({source}, {field})"
+
+        # the loop is a for statement appending the elements to the result
+        result = f"comprehension_{self.iter_count}"
+        self.iter_count += 1
+        append = OperatorNode(OperatorType.FUNCTION_CALL)
+        append.add_named_adjacent(Operand.FUNCTION_NAME, NameNode("append"))
+        append.add_named_adjacent(Operand.ARGUMENTS, [element])
+        append_call = OperatorNode(OperatorType.METHOD_CALL)
+        append_call.add_named_adjacent(Operand.INSTANCE, NameNode(result))
+        append_call.add_named_adjacent(Operand.METHOD, append)
+
+        loop = OperatorNode(OperatorType.FOR, max_adjacents=4)
+        loop.add_named_adjacent(Operand.SYMBOLS, for_symbols)
+        loop.add_named_adjacent(Operand.FOR_LITERAL, for_literal)
+        loop.add_named_adjacent(Operand.BODY, [append_call])
+
+        return (
+            f"[&]() {{\nauto {result} = List::spawn();\n"
+            f"{self.visit_for(loop)}\nreturn {result};\n}}()"
+        )
+
+    def split_conversion(
+        self, for_symbols: list, for_literal, element,
+    ) -> str | None:
+        """[int(x) for x in text.split()] and its float twin parse the
+        fields straight from the text
+        """
+        if not (
+            len(for_symbols) == 1
+            and isinstance(element, OperatorNode)
+            and element.operator == OperatorType.FUNCTION_CALL
+            and isinstance(for_literal, OperatorNode)
+            and for_literal.operator == OperatorType.METHOD_CALL
+        ):
+            return None
+
+        conversion = element.get_adjacent(Operand.FUNCTION_NAME).id
+        arguments = element.get_adjacent(Operand.ARGUMENTS)
+        method = for_literal.get_adjacent(Operand.METHOD)
+        if not (
+            conversion in {"int", "float"}
+            and len(arguments) == 1
+            and isinstance(arguments[0], NameNode)
+            and arguments[0].id == for_symbols[0].id
+            and isinstance(method, OperatorNode)
+            and method.operator == OperatorType.FUNCTION_CALL
+            and method.get_adjacent(Operand.FUNCTION_NAME).id == "split"
+            and len(method.get_adjacent(Operand.ARGUMENTS)) == 0
+        ):
+            return None
+
+        instance = self.visit_tree([for_literal.get_adjacent(Operand.INSTANCE)])
+        kernel = "splitInts" if conversion == "int" else "splitFloats"
+        return f"{instance}->{kernel}()"
+
+    def column_field(self, for_symbols: list, element) -> str | None:
+        """[r[2] for r in rows] and [b for a, b in rows] read one field of
+        every record, returns the field and the names unpacked for
+        BF::column, which reads column lists in place
+        """
+        if (
+            len(for_symbols) > 1
+            and isinstance(element, NameNode)
+            and element.id in [symbol.id for symbol in for_symbols]
+        ):
+            names = [symbol.id for symbol in for_symbols]
+            # the last of repeated names keeps its value, as in Python
+            field = len(names) - 1 - names[::-1].index(element.id)
+            return f"{field}, {len(names)}"
+
+        if not (
+            len(for_symbols) == 1
+            and isinstance(element, OperatorNode)
+            and element.operator == OperatorType.INDEXING
+        ):
+            return None
+
+        record = element.get_adjacent(Operand.INSTANCE)
+        index = element.get_adjacent(Operand.INDEX)
+        if (
+            isinstance(record, NameNode)
+            and record.id == for_symbols[0].id
+            and isinstance(index, int)
+            and not isinstance(index, bool)
+            and index >= 0
+        ):
+            return f"{index}"
+        return None
+
     def visit_func_declaration(self, tree: OperatorNode) -> str:
         func_name = tree.get_adjacent(Operand.FUNCTION_NAME)
         arguments = tree.get_adjacent(Operand.ARGUMENTS)
@@ -464,6 +855,7 @@ class FanglessGenerator:
                 )
 
         body = tree.get_adjacent(Operand.BODY)
+        self.function_trees[func_name.id] = tree
         argument_strs = []
         for arg in arguments:
             if isinstance(arg, dict):
@@ -546,18 +938,149 @@ class FanglessGenerator:
     def visit_other_operators(self, tree: OperatorNode) -> None:
         pass
 
+    # ============================ STRING FORMATTING ==========================
+    # Templates and format specs are parsed here, the runtime only receives
+    # the pieces and renders the fields
+    def visit_modulo(self, tree: OperatorNode) -> str:
+        if not isinstance(tree.get_left_operand(), str):
+            return self.visit_direct_binary(tree)
+
+        try:
+            pieces = split_percent_string(tree.get_left_operand())
+        except FormatError as e:
+            raise GeneratorError(f"{e}") from e
+
+        # the fields take the arguments in order
+        fields = []
+        count = 0
+        for piece in pieces:
+            if isinstance(piece, dict):
+                piece = (count, piece)
+                count += 1
+            fields.append(piece)
+        pieces_str = self.format_pieces(fields)
+
+        value = tree.get_right_operand()
+        if not isinstance(value, tuple):
+            value = self.visit_tree([value])
+            return f"StringFormat::percent({pieces_str}, {count}, {value})"
+
+        if len(value) < count:
+            raise GeneratorError("not enough arguments for format string")
+        if len(value) > count:
+            raise GeneratorError(
+                "not all arguments converted during string formatting"
+            )
+        return self.format_call(pieces_str, value)
+
+    def visit_format_template(self, template: str, arguments: list) -> str:
+        try:
+            pieces = split_format_string(template)
+        except FormatError as e:
+            raise GeneratorError(f"{e}") from e
+
+        fields = []
+        automatic = None
+        for piece in pieces:
+            if isinstance(piece, str):
+                fields.append(piece)
+                continue
+
+            name, conversion, spec = piece
+            if name and not name.isdigit():
+                raise GeneratorError(
+                    f"Only positional replacement fields are supported, "
+                    f"found '{{{name}}}'"
+                )
+            if automatic is None:
+                automatic = not name
+            if automatic != (not name):
+                raise GeneratorError(
+                    "cannot switch between automatic field numbering "
+                    "and manual field specification"
+                )
+
+            index = int(name) if name else len(
+                [field for field in fields if not isinstance(field, str)]
+            )
+            if index >= len(arguments):
+                raise GeneratorError(
+                    f"Replacement index {index} out of range for "
+                    "positional args tuple"
+                )
+
+            try:
+                spec = parse_format_spec(spec)
+            except FormatError as e:
+                raise GeneratorError(f"{e}") from e
+            if conversion:
+                spec["conversion"] = "s" if conversion == "s" else "r"
+            fields.append((index, spec))
+
+        return self.format_call(self.format_pieces(fields), arguments)
+
+    def visit_format_builtin(self, parameters: list) -> str:
+        spec = parameters[1] if len(parameters) == 2 else ""
+        if not isinstance(spec, str):
+            raise GeneratorError("format() specs must be string literals")
+
+        try:
+            spec = parse_format_spec(spec)
+        except FormatError as e:
+            raise GeneratorError(f"{e}") from e
+
+        return self.format_call(
+            self.format_pieces([(0, spec)]), parameters[:1],
+        )
+
+    def format_call(self, pieces: str, arguments) -> str:
+        arguments_str = "".join(
+            f", {self.visit_tree([argument])}" for argument in arguments
+        )
+        return f"StringFormat::format({pieces}{arguments_str})"
+
+    def format_pieces(self, pieces) -> str:
+        """Writes the initializer list of StringFormat pieces, text pieces
+        are strings and fields are (argument index, spec fields) tuples
+        """
+        pieces_str = []
+        for piece in pieces:
+            if isinstance(piece, str):
+                pieces_str.append(cpp_string(piece))
+                continue
+
+            index, spec = piece
+            spec_str = "".join(
+                f".{field}({cpp_spec_value(field, spec[field])})"
+                for field in SPEC_FIELDS
+                if field in spec
+            )
+            pieces_str.append(f"{{{index}, StringFormat::Spec(){spec_str}}}")
+
+        return f"{{{', '.join(pieces_str)}}}"
+
     def visit_binary_func(self, tree: OperatorNode) -> str:
         left_child = tree.get_left_operand()
         left_child = self.visit_tree([left_child])
 
         right_child = tree.get_right_operand()
-        right_child = self.visit_tree([right_child])
+        range_arguments = (
+            self.get_range_arguments(right_child)
+            if "in" in tree.operator else
+            None
+        )
+        if range_arguments is None:
+            right_child = self.visit_tree([right_child])
 
         func = "BF::"
         if tree.operator == "**":
             func += "pow"
         elif tree.operator == "//":
             func += "intDiv"
+        elif "in" in tree.operator and range_arguments is not None:
+            # membership on a range literal is answered arithmetically
+            func += "inRange"
+            right_child = range_arguments
         elif "in" in tree.operator:
             func += "in"
         elif "is" in tree.operator:
@@ -573,14 +1096,40 @@ class FanglessGenerator:
             return f"({func})"
         return func
     
+    def get_range_arguments(self, tree) -> str | None:
+        if (not isinstance(tree, OperatorNode) or
+            tree.operator != OperatorType.FUNCTION_CALL):
+            return None
+
+        function_name = tree.get_adjacent(Operand.FUNCTION_NAME)
+        arguments = tree.get_adjacent(Operand.ARGUMENTS)
+        if function_name.id != "range" or not 1 <= len(arguments) <= 3:
+            return None
+
+        return ", ".join(self.visit_tree([argument]) for argument in arguments)
+
+    def is_self_concatenation(self, tree: OperatorNode) -> bool:
+        target = tree.get_left_operand()
+        value = tree.get_right_operand()
+
+        return (
+            tree.operator == OperatorType.ASSIGNATION
+            and isinstance(target, NameNode)
+            and isinstance(value, OperatorNode)
+            and value.operator == "+"
+            and Operand.CENTER not in value.adjacents
+            and isinstance(value.get_left_operand(), NameNode)
+            and value.get_left_operand().id == target.id
+        )
+
     def visit_func_assignation(self, tree: OperatorNode) -> str:
         name = tree.get_left_operand()
         name = self.visit_tree([name])
 
-        tree.operator = tree.operator[:-1]
-        right = self.visit_tree([tree])
+        right = tree.get_right_operand()
+        right = self.visit_tree([right])
 
-        return f"{name} = {right}"
+        return f"BF::{IN_PLACE_BUILTINS[tree.operator]}({name}, {right})"
 
     def update_args(self, body: list, update: str) -> bool: 
         has_return = False
@@ -162,6 +162,7 @@ TOKENS = (
         "TRIPLE_STRING",
         "RAW_STRING",
         "UNICODE_STRING",
+        "FORMAT_STRING",
         ###
         # Indentation
         "INDENT",
@@ -270,7 +271,7 @@ BUILTIN_METHODS = {
     'format_map', 'index', 'isalnum', 'isalpha', 'isascii', 'isdecimal', 'isdigit', 
     'isidentifier', 'islower', 'isnumeric', 'isprintable', 'isspace', 'istitle', 
     'isupper', 'join', 'ljust', 'lower', 'lstrip', 'partition', 'replace', 'rfind', 
-    'rjust', 'rpartition', 'rsplit', 'rstrip', 'split', 'splitlines', 'startswith', 
+    'rindex', 'rjust', 'rpartition', 'rsplit', 'rstrip', 'split', 'splitlines', 'startswith', 
     'strip', 'swapcase', 'title', 'upper', 'zfill',
 
     # Dictionary methods
@@ -284,7 +285,13 @@ BUILTIN_METHODS = {
     'conjugate', 'denominator', 'from_bytes', 'imag', 'numerator', 'real',
 
     # Float methods
-    'as_integer_ratio', 'conjugate', 'imag', 'is_integer', 'real'
+    'as_integer_ratio', 'conjugate', 'imag', 'is_integer', 'real',
+
+    # Array methods
+    'fromfile', 'fromlist', 'tofile', 'tolist',
+
+    # File methods
+    'close',
 }
 
 
@@ -292,6 +299,20 @@ BUILTIN_FUNCTIONS = (
     "abs",
     "all",
     "any",
+    "array.add",
+    "array.array",
+    "array.compress",
+    "array.cumsum",
+    "array.divide",
+    "array.dot",
+    "array.equal",
+    "array.greater",
+    "array.greater_equal",
+    "array.less",
+    "array.less_equal",
+    "array.multiply",
+    "array.not_equal",
+    "array.subtract",
     "ascii",
     "bin",
     "bool",
@@ -301,6 +322,7 @@ BUILTIN_FUNCTIONS = (
     "callable",
     "chr",
     "classmethod",
+    "column_list",
     "compile",
     "complex",
     "delattr",
@@ -330,6 +352,9 @@ BUILTIN_FUNCTIONS = (
     "list",
     "locals",
     "map",
+    "math.gcd",
+    "math.isqrt",
+    "math.lcm",
     "max",
     "memoryview",
     "min",
@@ -349,16 +374,34 @@ BUILTIN_FUNCTIONS = (
     "setattr",
     "slice",
     "sorted",
+    "spilled_list",
     "staticmethod",
     "str",
     "sum",
     "super",
+    "sys.intern",
     "tuple",
     "type",
     "vars",
     "zip",
 )
 
+# Builtins that take any object, the only ones that can be the key function
+# of sort and sorted
+KEY_FUNCTIONS = {"abs", "bool", "float", "hash", "int", "len", "str"}
+
+# Functions of the modules a program may import, compiled as the builtins
+# named module.function
+MODULE_FUNCTIONS = {
+    "array": {
+        "add", "array", "compress", "cumsum", "divide", "dot", "equal",
+        "greater", "greater_equal", "less", "less_equal", "multiply",
+        "not_equal", "subtract",
+    },
+    "math": {"gcd", "isqrt", "lcm"},
+    "sys": {"intern"},
+}
+
 CPP_RESERVED_W = {
     "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool",
     "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class",
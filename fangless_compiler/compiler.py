@@ -2,6 +2,7 @@ from pathlib import Path
 import sys
 import common
 from exceptions import (
+    GeneratorError,
     IndentationMismatchError,
     LexerError,
     ParserError,
@@ -46,7 +47,13 @@ class FanglessCompiler:
                 sys.exit()
 
             common.print_step("Generating the code")
-            code = self.generator.generate_code(tree, function_dependencies)
+            try:
+                code = self.generator.generate_code(
+                    tree, function_dependencies,
+                )
+            except GeneratorError as e:
+                common.print_catastrophic_error("Could not generate", f"{e}")
+                sys.exit()
 
             OUTPUT_FILE.touch(exist_ok=True)
             OUTPUT_FILE.write_text(code, encoding="utf-8")
@@ -0,0 +1,881 @@
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Bool.hpp"
+#include "Iterable.hpp"
+#include "List.hpp"
+#include "Number.hpp"
+#include "NumberFormat.hpp"
+#include "NumericKernels.hpp"
+#include "Object.hpp"
+#include "Slice.hpp"
+
+// array.array: numbers stored unboxed and contiguous as the C type of the
+// typecode, '?' bool, 'b' int8, 'h' int16, 'i' int32, 'l' and 'q' int64, 'f'
+// float and 'd' double. Slices with step 1 are views on the buffer of the
+// array they are taken from. An array copies its range before it is
+// changed while the buffer is shared (copy on write), so a view behaves as
+// the copy Python makes.
+class Array : public Object {
+ public:
+  using Buffer = std::vector<std::byte>;
+
+ private:
+  char typecode_;
+  std::shared_ptr<Buffer> buffer_;
+  size_t offset_ = 0;  // in elements
+  size_t length_ = 0;
+
+  // Calls visitor with the std::type_identity of the typecode's C type
+  template <typename TVisitor>
+  static decltype(auto) visit(char typecode, TVisitor&& visitor) {
+    switch (typecode) {
+      case '?': return visitor(std::type_identity<bool>());
+      case 'b': return visitor(std::type_identity<int8_t>());
+      case 'h': return visitor(std::type_identity<int16_t>());
+      case 'i': return visitor(std::type_identity<int32_t>());
+      case 'l':
+      case 'q': return visitor(std::type_identity<int64_t>());
+      case 'f': return visitor(std::type_identity<float>());
+      default: return visitor(std::type_identity<double>());
+    }
+  }
+
+  template <typename T>
+  T* data() {
+    return reinterpret_cast<T*>(buffer_->data()) + offset_;
+  }
+
+  template <typename T>
+  const T* data() const {
+    return reinterpret_cast<const T*>(buffer_->data()) + offset_;
+  }
+
+  std::byte* bytes() { return buffer_->data() + offset_ * itemSize(); }
+  const std::byte* bytes() const {
+    return buffer_->data() + offset_ * itemSize();
+  }
+
+  template <typename T>
+  static std::shared_ptr<Number> box(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return Number::spawn(static_cast<double>(value));
+    } else {
+      return Number::spawn(static_cast<int64_t>(value));
+    }
+  }
+
+  // The C value of a Python number, with the errors CPython raises
+  template <typename T>
+  static T unbox(const Object& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return value.toBool();
+    } else {
+      if (const auto* boolean = dynamic_cast<const Bool*>(&value)) {
+        return static_cast<T>(boolean->toBool());
+      }
+      const auto* number = dynamic_cast<const Number*>(&value);
+      if (number == nullptr) {
+        throw std::runtime_error(
+            std::is_floating_point_v<T>
+                ? "must be real number, not " + value.type()
+                : "'" + value.type() +
+                      "' object cannot be interpreted as an integer");
+      }
+
+      if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(number->getDouble());
+      } else {
+        if (number->isDouble()) {
+          throw std::runtime_error(
+              "'float' object cannot be interpreted as an integer");
+        }
+        if (number->isBig() ||
+            number->getInt() > std::numeric_limits<T>::max()) {
+          throw std::overflow_error("array item is greater than maximum");
+        }
+        if (number->getInt() < std::numeric_limits<T>::min()) {
+          throw std::overflow_error("array item is less than minimum");
+        }
+        return static_cast<T>(number->getInt());
+      }
+    }
+  }
+
+  // Gives the array a buffer of its own, holding exactly its elements,
+  // before it is changed
+  void own() {
+    const size_t size = length_ * itemSize();
+    if (buffer_.use_count() == 1 && offset_ == 0 && buffer_->size() == size) {
+      return;
+    }
+    buffer_ = std::make_shared<Buffer>(bytes(), bytes() + size);
+    offset_ = 0;
+  }
+
+  void resize(size_t length) {
+    own();
+    buffer_->resize(length * itemSize());
+    length_ = length;
+  }
+
+  size_t normalize(int64_t index, const char* message) const {
+    if (index < 0) index += static_cast<int64_t>(length_);
+    if (index < 0 || index >= static_cast<int64_t>(length_)) {
+      throw std::out_of_range(message);
+    }
+    return static_cast<size_t>(index);
+  }
+
+  static int64_t indexOf(const Object& index) {
+    if (const auto* boolean = dynamic_cast<const Bool*>(&index)) {
+      return boolean->toBool() ? 1 : 0;
+    }
+    const auto* number = dynamic_cast<const Number*>(&index);
+    if (number == nullptr || number->isDouble()) {
+      throw std::runtime_error("array indices must be integers");
+    }
+    return number->getInt();
+  }
+
+  // Position of the first element equal to value, length_ if there is none.
+  // A value the typecode can not hold exactly equals no element.
+  size_t find(const Object& value) const {
+    const auto* number = dynamic_cast<const Number*>(&value);
+    const auto* boolean = dynamic_cast<const Bool*>(&value);
+    if (number == nullptr && boolean == nullptr) return length_;
+    if (number != nullptr && number->isBig()) return length_;
+
+    const double probe =
+        number != nullptr ? number->getDouble() : (boolean->toBool() ? 1 : 0);
+    return visit(typecode_, [&](auto type) -> size_t {
+      using T = typename decltype(type)::type;
+      if constexpr (std::is_floating_point_v<T>) {
+        for (size_t i = 0; i < length_; ++i) {
+          if (static_cast<double>(data<T>()[i]) == probe) return i;
+        }
+        return length_;
+      } else {
+        int64_t integer = boolean != nullptr ? static_cast<int64_t>(probe)
+                                             : number->getInt();
+        if (number != nullptr && number->isDouble() &&
+            static_cast<double>(integer) != probe) {
+          return length_;
+        }
+        if (integer < std::numeric_limits<T>::min() ||
+            integer > std::numeric_limits<T>::max()) {
+          return length_;
+        }
+        return NumericKernels::find(data<T>(), length_,
+                                    static_cast<T>(integer));
+      }
+    });
+  }
+
+ public:
+  class Iterator {
+    const Array* array_ = nullptr;
+    size_t position_ = 0;
+    std::shared_ptr<Object> current_;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::shared_ptr<Object>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    Iterator() = default;
+    Iterator(const Array* array, size_t position)
+      : array_(array), position_(position) {}
+
+    reference operator*() {
+      if (current_.get() == nullptr) current_ = array_->item(position_);
+      return current_;
+    }
+
+    pointer operator->() { return &operator*(); }
+
+    Iterator& operator++() {
+      ++position_;
+      current_.reset();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return position_ == other.position_;
+    }
+  };
+
+  Array(char typecode, std::shared_ptr<Buffer> buffer, size_t offset,
+        size_t length)
+    : typecode_(typecode),
+      buffer_(std::move(buffer)),
+      offset_(offset),
+      length_(length) {}
+
+  Array(char typecode, size_t length)
+    : Array(typecode,
+            std::make_shared<Buffer>(length * itemSize(typecode)), 0,
+            length) {}
+
+  static std::shared_ptr<Array> spawn(char typecode, size_t length = 0) {
+    if (std::string("?bhilqfd").find(typecode) == std::string::npos) {
+      throw std::invalid_argument(
+          "bad typecode (must be ?, b, h, i, l, q, f or d)");
+    }
+    return std::make_shared<Array>(typecode, length);
+  }
+
+  template <typename TItems>
+  static std::shared_ptr<Array> spawn(char typecode,
+                                      const std::shared_ptr<TItems>& items) {
+    auto array = spawn(typecode);
+    array->extend(items);
+    return array;
+  }
+
+  static size_t itemSize(char typecode) {
+    return visit(typecode, [](auto type) {
+      return sizeof(typename decltype(type)::type);
+    });
+  }
+
+  size_t itemSize() const { return itemSize(typecode_); }
+  char typecode() const { return typecode_; }
+  size_t size() const { return length_; }
+
+  static bool isFloating(char typecode) {
+    return typecode == 'f' || typecode == 'd';
+  }
+
+  // Elements of the array as a T buffer: its own when it already holds Ts,
+  // otherwise they are converted into storage
+  template <typename T>
+  const T* elementsAs(std::unique_ptr<T[]>& storage) const {
+    return visit(typecode_, [&](auto type) -> const T* {
+      using TFrom = typename decltype(type)::type;
+      if constexpr (std::is_same_v<TFrom, T>) {
+        return data<T>();
+      } else {
+        storage = std::make_unique<T[]>(length_);
+        NumericKernels::convert(storage.get(), data<TFrom>(), length_);
+        return storage.get();
+      }
+    });
+  }
+
+  template <typename T>
+  T* mutableData() {
+    own();
+    return data<T>();
+  }
+
+  std::shared_ptr<Number> item(size_t index) const {
+    return visit(typecode_, [&](auto type) {
+      return box(data<typename decltype(type)::type>()[index]);
+    });
+  }
+
+  std::string type() const override { return "array"; }
+
+  std::string toString() const override {
+    std::string result = "array('";
+    result += typecode_;
+    result += '\'';
+    if (length_ == 0) return result + ")";
+
+    result += ", [";
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      for (size_t i = 0; i < length_; ++i) {
+        if (i > 0) result += ", ";
+        const T value = data<T>()[i];
+        if constexpr (std::is_same_v<T, bool>) {
+          result += value ? "True" : "False";
+        } else if constexpr (std::is_floating_point_v<T>) {
+          result += NumberFormat::floatText(value);
+        } else {
+          result += NumberFormat::integerText(value);
+        }
+      }
+    });
+    return result + "])";
+  }
+
+  bool equals(const Object& other) const override {
+    const auto* array = dynamic_cast<const Array*>(&other);
+    if (array == nullptr || array->length_ != length_) return false;
+
+    if (array->typecode_ == typecode_) {
+      return visit(typecode_, [&](auto type) {
+        using T = typename decltype(type)::type;
+        return std::equal(data<T>(), data<T>() + length_, array->data<T>());
+      });
+    }
+
+    for (size_t i = 0; i < length_; ++i) {
+      if (!item(i)->equals(*array->item(i))) return false;
+    }
+    return true;
+  }
+
+  std::strong_ordering compare(const Object& other) const override {
+    const auto* array = dynamic_cast<const Array*>(&other);
+    if (array == nullptr) return Object::compare(other);
+
+    const size_t shared = std::min(length_, array->length_);
+    for (size_t i = 0; i < shared; ++i) {
+      const auto order = item(i)->compare(*array->item(i));
+      if (order != std::strong_ordering::equal) return order;
+    }
+    return length_ <=> array->length_;
+  }
+
+  size_t hash() const override {
+    throw std::runtime_error("unhashable type: 'array.array'");
+  }
+
+  bool toBool() const override { return length_ > 0; }
+
+  bool isInstance(const std::string& type) const override {
+    return type == "array" || type == "object";
+  }
+
+  std::shared_ptr<Object> getAttr(const std::string& name) const override {
+    throw std::runtime_error("'array.array' object has no attribute '" + name +
+                             "'");
+  }
+
+  void setAttr(const std::string&, std::shared_ptr<Object>) override {
+    throw std::runtime_error("'array.array' object has no attributes");
+  }
+
+  std::shared_ptr<Number> len() const {
+    return Number::spawn(static_cast<int64_t>(length_));
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, length_); }
+
+  std::shared_ptr<Number> operator[](
+      const std::shared_ptr<Number>& index) const {
+    return item(normalize(indexOf(*index), "array index out of range"));
+  }
+
+  std::shared_ptr<Number> operator[](
+      const std::shared_ptr<Object>& index) const {
+    return item(normalize(indexOf(*index), "array index out of range"));
+  }
+
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return (*this)[index];
+  }
+
+  void setItem(const std::shared_ptr<Object>& index,
+               const std::shared_ptr<Object>& value) {
+    const size_t position = normalize(indexOf(*index),
+                                      "array assignment index out of range");
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      const T converted = unbox<T>(*value);
+      mutableData<T>()[position] = converted;
+    });
+  }
+
+  // Step 1 slices are views sharing the buffer, other steps gather a copy
+  std::shared_ptr<Array> operator[](const Slice& slice) const {
+    const int64_t size = static_cast<int64_t>(length_);
+    const int64_t step = slice.step == 0 ?
+      throw std::invalid_argument("slice step cannot be zero") : slice.step;
+    int64_t start = slice.start == INT_MAX ?
+      (step > 0 ? 0 : size - 1) : slice.start;
+    int64_t end = slice.end == INT_MAX ? (step > 0 ? size : -1) : slice.end;
+
+    if (slice.start != INT_MAX && start < 0) start += size;
+    if (slice.end != INT_MAX && end < 0) end += size;
+
+    if (step > 0) {
+      start = std::clamp<int64_t>(start, 0, size);
+      end = std::clamp<int64_t>(end, start, size);
+    } else {
+      start = std::clamp<int64_t>(start, -1, size - 1);
+      end = std::clamp<int64_t>(end, -1, start);
+    }
+
+    if (step == 1) {
+      return std::make_shared<Array>(typecode_, buffer_, offset_ + start,
+                                     end - start);
+    }
+
+    const int64_t count = step > 0 ? (end - start + step - 1) / step
+                                   : (start - end - step - 1) / -step;
+    auto result = std::make_shared<Array>(typecode_, count);
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      T* out = result->template data<T>();
+      for (int64_t i = 0; i < count; ++i) out[i] = data<T>()[start + i * step];
+    });
+    return result;
+  }
+
+  std::shared_ptr<Array> slice(const Slice& slice) const {
+    return this->operator[](slice);
+  }
+
+  std::shared_ptr<Array> slice(std::shared_ptr<Slice> slice) const {
+    return this->operator[](*slice);
+  }
+
+  void append(const std::shared_ptr<Object>& value) {
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      const T converted = unbox<T>(*value);
+      resize(length_ + 1);
+      data<T>()[length_ - 1] = converted;
+    });
+  }
+
+  // Arrays of the same typecode are copied in bulk, like CPython other
+  // arrays are refused. If an item can not be stored nothing is added.
+  template <TIterable TItems>
+  void extend(const std::shared_ptr<TItems>& items) {
+    if constexpr (std::is_same_v<TItems, Array>) {
+      if (items->typecode_ != typecode_) {
+        throw std::runtime_error("can only extend with array of same kind");
+      }
+      const Array source(items->typecode_, items->buffer_, items->offset_,
+                         items->length_);
+      const size_t start = length_;
+      resize(length_ + source.length_);
+      std::memcpy(bytes() + start * itemSize(), source.bytes(),
+                  source.length_ * itemSize());
+    } else {
+      const size_t start = length_;
+      try {
+        for (const auto& item : *items) append(item);
+      } catch (...) {
+        resize(start);
+        throw;
+      }
+    }
+  }
+
+  void fromlist(const std::shared_ptr<List>& items) { extend(items); }
+
+  void insert(const std::shared_ptr<Number>& index,
+              const std::shared_ptr<Object>& value) {
+    int64_t position = index->getInt();
+    const int64_t size = static_cast<int64_t>(length_);
+    if (position < 0) position += size;
+    position = std::clamp<int64_t>(position, 0, size);
+
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      const T converted = unbox<T>(*value);
+      resize(length_ + 1);
+      T* elements = data<T>();
+      std::move_backward(elements + position, elements + length_ - 1,
+                         elements + length_);
+      elements[position] = converted;
+    });
+  }
+
+  std::shared_ptr<Number> pop(
+      const std::shared_ptr<Number>& index = Number::spawn(int64_t{-1})) {
+    if (length_ == 0) throw std::out_of_range("pop from empty array");
+    const size_t position =
+        normalize(index->getInt(), "pop index out of range");
+    auto value = item(position);
+    erase(position);
+    return value;
+  }
+
+  void remove(const std::shared_ptr<Object>& value) {
+    const size_t position = find(*value);
+    if (position == length_) {
+      throw std::invalid_argument("array.remove(x): x not in array");
+    }
+    erase(position);
+  }
+
+  void erase(size_t position) {
+    own();
+    const size_t size = itemSize();
+    std::memmove(bytes() + position * size, bytes() + (position + 1) * size,
+                 (length_ - position - 1) * size);
+    resize(length_ - 1);
+  }
+
+  void reverse() {
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      T* first = mutableData<T>();
+      std::reverse(first, first + length_);
+    });
+  }
+
+  bool contains(const std::shared_ptr<Object>& value) const {
+    return find(*value) != length_;
+  }
+
+  std::shared_ptr<Number> count(const std::shared_ptr<Object>& value) const {
+    const size_t first = find(*value);
+    if (first == length_) return Number::spawn(int64_t{0});
+
+    return visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      const T* elements = data<T>();
+      return Number::spawn(static_cast<int64_t>(NumericKernels::count(
+          elements + first, length_ - first, elements[first])));
+    });
+  }
+
+  std::shared_ptr<Number> index(const std::shared_ptr<Object>& value) const {
+    const size_t position = find(*value);
+    if (position == length_) {
+      throw std::invalid_argument("array.index(x): x not in array");
+    }
+    return Number::spawn(static_cast<int64_t>(position));
+  }
+
+  std::shared_ptr<List> tolist() const {
+    auto list = List::spawn();
+    auto& elements = list->getElements();
+    elements.reserve(length_);
+    for (size_t i = 0; i < length_; ++i) elements.push_back(item(i));
+    return list;
+  }
+
+  // The raw machine representation, as CPython writes it
+  void tofile(const std::shared_ptr<std::fstream>& file) const {
+    file->write(reinterpret_cast<const char*>(bytes()),
+                static_cast<std::streamsize>(length_ * itemSize()));
+    if (!*file) throw std::runtime_error("array.tofile(): write failed");
+  }
+
+  // Reads count items, the ones read are kept if the file ends first
+  void fromfile(const std::shared_ptr<std::fstream>& file,
+                const std::shared_ptr<Number>& count) {
+    const size_t size = itemSize();
+    const size_t start = length_;
+    resize(length_ + static_cast<size_t>(count->getInt()));
+    file->read(reinterpret_cast<char*>(bytes() + start * size),
+               static_cast<std::streamsize>((length_ - start) * size));
+
+    const size_t read = static_cast<size_t>(file->gcount()) / size;
+    if (start + read < length_) {
+      resize(start + read);
+      throw std::runtime_error("read() didn't return enough bytes");
+    }
+  }
+
+  std::shared_ptr<Number> sum() const {
+    return visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      if constexpr (std::is_floating_point_v<T>) {
+        return Number::spawn(NumericKernels::floatSum(data<T>(), length_));
+      } else {
+        return Number::fromInt128(
+            NumericKernels::intSum(data<T>(), length_));
+      }
+    });
+  }
+
+  template <bool MAXIMUM>
+  std::shared_ptr<Number> extreme() const {
+    if (length_ == 0) {
+      throw std::invalid_argument(std::string(MAXIMUM ? "max" : "min") +
+                                  "() arg is an empty sequence");
+    }
+    return visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      return item(NumericKernels::extreme<MAXIMUM>(data<T>(), length_));
+    });
+  }
+
+  // Operand of the vectorized operations: an array, or a number (scalar)
+  // that stands for every element
+  struct Operand {
+    std::shared_ptr<Array> values;
+    bool scalar;
+  };
+
+  static Operand operand(const std::shared_ptr<Array>& array) {
+    return {array, false};
+  }
+
+  static Operand operand(const std::shared_ptr<Number>& number) {
+    if (number->isBig()) {
+      throw std::overflow_error("Python int too large to convert to C long");
+    }
+    auto values = std::make_shared<Array>(number->isDouble() ? 'd' : 'q', 1);
+    if (number->isDouble()) {
+      values->data<double>()[0] = number->getDouble();
+    } else {
+      values->data<int64_t>()[0] = number->getInt();
+    }
+    return {values, true};
+  }
+
+  static Operand operand(const std::shared_ptr<Bool>& boolean) {
+    return operand(Number::spawn(int64_t{boolean->toBool() ? 1 : 0}));
+  }
+
+  static Operand operand(const std::shared_ptr<Object>& object) {
+    if (auto array = std::dynamic_pointer_cast<Array>(object)) {
+      return operand(array);
+    }
+    if (auto number = std::dynamic_pointer_cast<Number>(object)) {
+      return operand(number);
+    }
+    if (auto boolean = std::dynamic_pointer_cast<Bool>(object)) {
+      return operand(boolean);
+    }
+    throw std::runtime_error("unsupported operand type for array: '" +
+                             object->type() + "'");
+  }
+
+  // Typecode both operands are brought to, the wider one. A scalar takes the
+  // type of the array unless it is a float and the array holds ints. For
+  // comparisons (widen) an int scalar meets int arrays as an int64, so it is
+  // compared exactly whatever its size.
+  static char common(const Operand& lhs, const Operand& rhs,
+                     bool widen = false) {
+    static constexpr std::string_view RANKS = "?bhiqfd";
+    const char left = lhs.values->typecode_;
+    const char right = rhs.values->typecode_;
+
+    if (lhs.scalar != rhs.scalar) {
+      const char array = lhs.scalar ? right : left;
+      const char scalar = lhs.scalar ? left : right;
+      if (isFloating(scalar) && !isFloating(array)) return 'd';
+      if (widen && !isFloating(array)) return 'q';
+      return array;
+    }
+
+    const size_t leftRank = RANKS.find(left == 'l' ? 'q' : left);
+    const size_t rightRank = RANKS.find(right == 'l' ? 'q' : right);
+    return leftRank >= rightRank ? left : right;
+  }
+
+  static size_t lengthOf(const Operand& lhs, const Operand& rhs) {
+    if (lhs.scalar) return rhs.values->length_;
+    if (rhs.scalar || lhs.values->length_ == rhs.values->length_) {
+      return lhs.values->length_;
+    }
+    throw std::invalid_argument(
+        "operands could not be broadcast together with shapes (" +
+        std::to_string(lhs.values->length_) + ",) (" +
+        std::to_string(rhs.values->length_) + ",)");
+  }
+
+  // Calls kernel(left, right, length) with each operand as a T pointer to
+  // length elements, or as a single T value if it is a scalar
+  template <typename T, typename TKernel>
+  static void withOperands(const Operand& lhs, const Operand& rhs,
+                           TKernel&& kernel) {
+    const size_t length = lengthOf(lhs, rhs);
+    std::unique_ptr<T[]> lhsStorage;
+    std::unique_ptr<T[]> rhsStorage;
+    if (lhs.scalar && !rhs.scalar) {
+      kernel(unbox<T>(*lhs.values->item(0)),
+             rhs.values->elementsAs<T>(rhsStorage), length);
+    } else if (rhs.scalar && !lhs.scalar) {
+      kernel(lhs.values->elementsAs<T>(lhsStorage),
+             unbox<T>(*rhs.values->item(0)), length);
+    } else {
+      kernel(lhs.values->elementsAs<T>(lhsStorage),
+             rhs.values->elementsAs<T>(rhsStorage), length);
+    }
+  }
+
+  // +, - and * elementwise, ints wrap around on overflow as in numpy
+  template <typename TOperation>
+  static std::shared_ptr<Array> arithmetic(const Operand& lhs,
+                                           const Operand& rhs,
+                                           TOperation operation) {
+    char typecode = common(lhs, rhs);
+    if (typecode == '?') typecode = 'b';
+
+    return visit(typecode, [&](auto type) {
+      using T = typename decltype(type)::type;
+      std::shared_ptr<Array> result;
+      withOperands<T>(lhs, rhs, [&](const auto& left, const auto& right,
+                                    size_t length) {
+        result = std::make_shared<Array>(typecode, length);
+        NumericKernels::elementwise(result->data<T>(), left, right, length,
+                                    operation);
+      });
+      return result;
+    });
+  }
+
+  // True division, always to floats, by zero gives inf or nan
+  static std::shared_ptr<Array> divide(const Operand& lhs,
+                                       const Operand& rhs) {
+    auto quotients = [&]<typename T>(std::type_identity<T>, char typecode) {
+      std::shared_ptr<Array> result;
+      withOperands<T>(lhs, rhs, [&](const auto& left, const auto& right,
+                                    size_t length) {
+        result = std::make_shared<Array>(typecode, length);
+        NumericKernels::elementwise(result->data<T>(), left, right, length,
+                                    std::divides<>());
+      });
+      return result;
+    };
+
+    if (common(lhs, rhs) == 'f') {
+      return quotients(std::type_identity<float>(), 'f');
+    }
+    return quotients(std::type_identity<double>(), 'd');
+  }
+
+  // A '?' array telling for each element whether compare holds
+  template <typename TCompare>
+  static std::shared_ptr<Array> mask(const Operand& lhs, const Operand& rhs,
+                                     TCompare compare) {
+    return visit(common(lhs, rhs, true), [&](auto type) {
+      using T = typename decltype(type)::type;
+      std::shared_ptr<Array> result;
+      withOperands<T>(lhs, rhs, [&](const auto& left, const auto& right,
+                                    size_t length) {
+        result = std::make_shared<Array>('?', length);
+        NumericKernels::mask(result->data<bool>(), left, right, length,
+                             compare);
+      });
+      return result;
+    });
+  }
+
+  static std::shared_ptr<Number> dot(const Operand& lhs, const Operand& rhs) {
+    if (lhs.scalar || rhs.scalar) {
+      throw std::runtime_error("dot() arguments must be arrays");
+    }
+    const size_t length = lengthOf(lhs, rhs);
+
+    return visit(common(lhs, rhs), [&](auto type) {
+      using T = typename decltype(type)::type;
+      std::unique_ptr<T[]> lhsStorage;
+      std::unique_ptr<T[]> rhsStorage;
+      const T* left = lhs.values->elementsAs<T>(lhsStorage);
+      const T* right = rhs.values->elementsAs<T>(rhsStorage);
+
+      if constexpr (std::is_floating_point_v<T>) {
+        return Number::spawn(NumericKernels::floatDot(left, right, length));
+      } else {
+        __int128 total = 0;
+        if (NumericKernels::intDot(left, right, length, total)) {
+          return Number::fromInt128(total);
+        }
+        // past 128 bits the products are added as Python ints
+        std::shared_ptr<Number> exact = Number::spawn(int64_t{0});
+        for (size_t i = 0; i < length; ++i) {
+          exact = exact + box(left[i]) * box(right[i]);
+        }
+        return exact;
+      }
+    });
+  }
+
+  // Running totals, as int64 (wrapping around) or as doubles
+  std::shared_ptr<Array> cumsum() const {
+    const char typecode = isFloating(typecode_) ? 'd' : 'q';
+    auto result = std::make_shared<Array>(typecode, length_);
+    visit(typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      using TTotal =
+          std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+      NumericKernels::cumulativeSum(result->data<TTotal>(), data<T>(),
+                                    length_);
+    });
+    return result;
+  }
+
+  // The elements of values whose mask element is true
+  static std::shared_ptr<Array> compress(const Array& mask,
+                                         const Array& values) {
+    if (mask.length_ != values.length_) {
+      throw std::invalid_argument(
+          "mask and values must have the same length");
+    }
+
+    std::vector<size_t> selected;
+    visit(mask.typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      const T* flags = mask.data<T>();
+      for (size_t i = 0; i < mask.length_; ++i) {
+        if (flags[i] != T{}) selected.push_back(i);
+      }
+    });
+
+    auto result = std::make_shared<Array>(values.typecode_, selected.size());
+    visit(values.typecode_, [&](auto type) {
+      using T = typename decltype(type)::type;
+      T* out = result->data<T>();
+      for (size_t i = 0; i < selected.size(); ++i) {
+        out[i] = values.data<T>()[selected[i]];
+      }
+    });
+    return result;
+  }
+
+  friend std::shared_ptr<Array> operator+(const std::shared_ptr<Array>& lhs,
+                                          const std::shared_ptr<Array>& rhs) {
+    if (lhs->typecode_ != rhs->typecode_) {
+      throw std::runtime_error("bad argument type for built-in operation");
+    }
+    auto result = std::make_shared<Array>(lhs->typecode_, lhs->buffer_,
+                                          lhs->offset_, lhs->length_);
+    result->extend(rhs);
+    return result;
+  }
+
+  friend std::shared_ptr<Array> operator*(
+      const std::shared_ptr<Array>& array,
+      const std::shared_ptr<Number>& times) {
+    const int64_t count = std::max<int64_t>(times->getInt(), 0);
+    const size_t size = array->length_ * array->itemSize();
+    auto result = std::make_shared<Array>(array->typecode_,
+                                          array->length_ * count);
+    for (int64_t i = 0; i < count; ++i) {
+      std::memcpy(result->bytes() + i * size, array->bytes(), size);
+    }
+    return result;
+  }
+
+  friend std::shared_ptr<Array> operator*(const std::shared_ptr<Number>& times,
+                                          const std::shared_ptr<Array>& array) {
+    return array * times;
+  }
+
+  friend bool operator==(const std::shared_ptr<Array>& lhs,
+                         const std::shared_ptr<Array>& rhs) {
+    return lhs->equals(*rhs);
+  }
+};
+
+#endif  // ARRAY_HPP
@@ -0,0 +1,743 @@
+#ifndef BIG_INT_HPP
+#define BIG_INT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Integer of any size in sign and magnitude form, the slow path Number
+// switches to when an int64 operation overflows. The magnitude is a little
+// endian vector of 32 bit limbs without leading zero limbs, zero has no
+// limbs and is never negative. Division and shifts to the right round
+// towards negative infinity and the bitwise operators act on the infinite
+// two's complement form, as they do in Python.
+class BigInt {
+ public:
+  using Limb = uint32_t;
+  using Wide = uint64_t;
+  using Magnitude = std::vector<Limb>;
+
+  static constexpr int LIMB_BITS = 32;
+
+  // Products where the shorter operand has fewer limbs are done the
+  // schoolbook way, Karatsuba's three half size products are slower there
+  static constexpr size_t KARATSUBA_THRESHOLD = 40;
+
+  // Magnitudes of fewer limbs are printed by repeated division by 10^9,
+  // longer ones are split in halves by a power of 10^9 first
+  static constexpr size_t SPLIT_THRESHOLD = 60;
+
+  BigInt() = default;
+
+  explicit BigInt(int64_t value) : negative_(value < 0) {
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (negative_) magnitude = 0 - magnitude;
+    setMagnitude(magnitude);
+  }
+
+  static BigInt fromUnsigned(uint64_t value) {
+    BigInt result;
+    result.setMagnitude(value);
+    return result;
+  }
+
+  static BigInt fromMagnitude(Magnitude limbs) {
+    return BigInt(false, std::move(limbs));
+  }
+
+  // `digits` holds only valid digits of the base, without sign or prefix
+  static BigInt fromDigits(std::string_view digits, int base, bool negative) {
+    // as many digits as fit in a limb are added per multiplication
+    int chunkDigits = 1;
+    Wide chunkBase = base;
+    while (chunkBase * base <= UINT32_MAX) {
+      chunkBase *= base;
+      ++chunkDigits;
+    }
+
+    BigInt result;
+    size_t first = digits.size() % chunkDigits;
+    if (first == 0) first = chunkDigits;
+    for (size_t start = 0; start < digits.size();) {
+      size_t size = start == 0 ? first : chunkDigits;
+      Limb chunk = 0;
+      std::from_chars(digits.data() + start, digits.data() + start + size,
+                      chunk, base);
+      Wide scale = start == 0 ? 1 : chunkBase;
+      multiplyAdd(result.limbs_, static_cast<Limb>(scale), chunk);
+      start += size;
+    }
+    result.negative_ = negative && !result.isZero();
+    return result;
+  }
+
+  // The integer part of a finite double
+  static BigInt fromDouble(double value) {
+    int exponent = 0;
+    double mantissa = std::frexp(std::trunc(value), &exponent);
+    if (exponent <= 63) return BigInt(static_cast<int64_t>(std::trunc(value)));
+    // all 53 bits of the mantissa as an int, then scaled back up
+    BigInt bits(static_cast<int64_t>(std::ldexp(mantissa, 53)));
+    return bits << static_cast<uint64_t>(exponent - 53);
+  }
+
+  bool isZero() const { return limbs_.empty(); }
+  bool isNegative() const { return negative_; }
+
+  size_t bitLength() const {
+    if (limbs_.empty()) return 0;
+    return (limbs_.size() - 1) * LIMB_BITS + std::bit_width(limbs_.back());
+  }
+
+  const Magnitude& magnitude() const { return limbs_; }
+
+  // Bit `index` of the magnitude
+  bool testBit(size_t index) const {
+    size_t limb = index / LIMB_BITS;
+    return limb < limbs_.size() && (limbs_[limb] >> (index % LIMB_BITS)) & 1;
+  }
+
+  // The lowest 64 bits of the magnitude
+  uint64_t lowBits() const {
+    uint64_t bits = limbs_.empty() ? 0 : limbs_[0];
+    if (limbs_.size() > 1) bits |= static_cast<uint64_t>(limbs_[1]) << 32;
+    return bits;
+  }
+
+  // Stores the value and returns true when it fits in an int64
+  bool toInt64(int64_t& value) const {
+    if (limbs_.size() > 2) return false;
+    uint64_t magnitude = lowBits();
+    if (negative_) {
+      if (magnitude > static_cast<uint64_t>(INT64_MAX) + 1) return false;
+      value = static_cast<int64_t>(0 - magnitude);
+      return true;
+    }
+    if (magnitude > static_cast<uint64_t>(INT64_MAX)) return false;
+    value = static_cast<int64_t>(magnitude);
+    return true;
+  }
+
+  // Rounds half to even like int.__float__
+  double toDouble() const {
+    size_t bits = bitLength();
+    double magnitude = 0.0;
+    if (bits <= 64) {
+      magnitude = static_cast<double>(lowBits());
+    } else {
+      // the top 64 bits with the rest folded into the lowest one, which
+      // is below the rounding position and only breaks ties
+      size_t shift = bits - 64;
+      uint64_t top = static_cast<uint64_t>(bitsFrom(shift));
+      if (hasBitsBelow(shift)) top |= 1;
+      magnitude = std::ldexp(static_cast<double>(top),
+                             static_cast<int>(shift));
+      if (std::isinf(magnitude)) {
+        throw std::overflow_error("int too large to convert to float");
+      }
+    }
+    return negative_ ? -magnitude : magnitude;
+  }
+
+  // Decimal text, or the digits in base 2, 8 or 16 read straight off the
+  // bits
+  std::string toString(int base = 10) const {
+    if (limbs_.empty()) return "0";
+    std::string text;
+    if (negative_) text += '-';
+    if (base == 10) {
+      appendDecimal(limbs_, 0, text);
+      return text;
+    }
+
+    int digitBits = std::countr_zero(static_cast<unsigned>(base));
+    size_t digits = (bitLength() + digitBits - 1) / digitBits;
+    for (size_t i = digits; i-- > 0;) {
+      uint64_t digit = static_cast<uint64_t>(bitsFrom(i * digitBits)) &
+                       (base - 1);
+      text += "0123456789abcdef"[digit];
+    }
+    return text;
+  }
+
+  friend bool operator==(const BigInt& lhs, const BigInt& rhs) {
+    return lhs.negative_ == rhs.negative_ && lhs.limbs_ == rhs.limbs_;
+  }
+
+  friend std::strong_ordering operator<=>(const BigInt& lhs,
+                                          const BigInt& rhs) {
+    if (lhs.negative_ != rhs.negative_) {
+      return lhs.negative_ ? std::strong_ordering::less
+                           : std::strong_ordering::greater;
+    }
+    int order = compareMagnitude(lhs.limbs_, rhs.limbs_);
+    if (lhs.negative_) order = -order;
+    return order <=> 0;
+  }
+
+  BigInt operator-() const {
+    BigInt result = *this;
+    result.negative_ = !negative_ && !limbs_.empty();
+    return result;
+  }
+
+  BigInt abs() const {
+    BigInt result = *this;
+    result.negative_ = false;
+    return result;
+  }
+
+  friend BigInt operator+(const BigInt& lhs, const BigInt& rhs) {
+    return addSigned(lhs, rhs.negative_, rhs.limbs_);
+  }
+
+  friend BigInt operator-(const BigInt& lhs, const BigInt& rhs) {
+    return addSigned(lhs, !rhs.negative_ && !rhs.isZero(), rhs.limbs_);
+  }
+
+  friend BigInt operator*(const BigInt& lhs, const BigInt& rhs) {
+    return BigInt(lhs.negative_ != rhs.negative_,
+                  multiplyMagnitude(lhs.limbs_.data(), lhs.limbs_.size(),
+                                    rhs.limbs_.data(), rhs.limbs_.size()));
+  }
+
+  // Floor division and the remainder with the sign of the divisor
+  static void divMod(const BigInt& dividend, const BigInt& divisor,
+                     BigInt& quotient, BigInt& remainder) {
+    if (divisor.isZero()) {
+      throw std::runtime_error("Division by zero");
+    }
+    Magnitude quotientLimbs;
+    Magnitude remainderLimbs;
+    divideMagnitude(dividend.limbs_, divisor.limbs_, quotientLimbs,
+                    remainderLimbs);
+    quotient = BigInt(dividend.negative_ != divisor.negative_,
+                      std::move(quotientLimbs));
+    remainder = BigInt(dividend.negative_, std::move(remainderLimbs));
+
+    if (!remainder.isZero() && remainder.negative_ != divisor.negative_) {
+      quotient = quotient - BigInt(1);
+      remainder = remainder + divisor;
+    }
+  }
+
+  friend BigInt operator/(const BigInt& lhs, const BigInt& rhs) {
+    BigInt quotient;
+    BigInt remainder;
+    divMod(lhs, rhs, quotient, remainder);
+    return quotient;
+  }
+
+  friend BigInt operator%(const BigInt& lhs, const BigInt& rhs) {
+    BigInt quotient;
+    BigInt remainder;
+    divMod(lhs, rhs, quotient, remainder);
+    return remainder;
+  }
+
+  // The correctly rounded quotient as int.__truediv__ gives it
+  static double trueDivide(const BigInt& dividend, const BigInt& divisor) {
+    if (divisor.isZero()) {
+      throw std::runtime_error("Division by zero");
+    }
+    if (dividend.isZero()) {
+      return dividend.negative_ != divisor.negative_ ? -0.0 : 0.0;
+    }
+
+    // scale the dividend so the quotient keeps 55 bits or more, its last
+    // bit then tells whether anything was left over
+    int64_t scale = 55 - (static_cast<int64_t>(dividend.bitLength()) -
+                          static_cast<int64_t>(divisor.bitLength()));
+    if (scale < 0) scale = 0;
+    Magnitude quotient;
+    Magnitude remainder;
+    divideMagnitude(shiftLeftMagnitude(dividend.limbs_, scale),
+                    divisor.limbs_, quotient, remainder);
+    Magnitude doubled = shiftLeftMagnitude(quotient, 1);
+    if (!remainder.empty()) doubled[0] |= 1;
+
+    double magnitude = 0.0;
+    try {
+      magnitude = std::ldexp(BigInt(false, std::move(doubled)).toDouble(),
+                             static_cast<int>(-scale - 1));
+    } catch (const std::overflow_error&) {
+      throw std::overflow_error(
+        "integer division result too large for a float");
+    }
+    return dividend.negative_ != divisor.negative_ ? -magnitude : magnitude;
+  }
+
+  // Square and multiply from the highest bit of the exponent down
+  static BigInt power(const BigInt& base, uint64_t exponent) {
+    BigInt result(1);
+    for (int bit = std::bit_width(exponent) - 1; bit >= 0; --bit) {
+      result = result * result;
+      if ((exponent >> bit) & 1) result = result * base;
+    }
+    return result;
+  }
+
+  BigInt operator<<(uint64_t shift) const {
+    return BigInt(negative_, shiftLeftMagnitude(limbs_, shift));
+  }
+
+  BigInt operator>>(uint64_t shift) const {
+    if (!negative_) {
+      return BigInt(false, shiftRightMagnitude(limbs_, shift));
+    }
+    // -((|x| - 1) >> shift) - 1 rounds towards negative infinity
+    BigInt lowered = abs() - BigInt(1);
+    BigInt shifted(false, shiftRightMagnitude(lowered.limbs_, shift));
+    return -shifted - BigInt(1);
+  }
+
+  BigInt operator~() const { return -*this - BigInt(1); }
+
+  friend BigInt operator&(const BigInt& lhs, const BigInt& rhs) {
+    return bitwise(lhs, rhs, [](Limb a, Limb b) { return a & b; });
+  }
+
+  friend BigInt operator|(const BigInt& lhs, const BigInt& rhs) {
+    return bitwise(lhs, rhs, [](Limb a, Limb b) { return a | b; });
+  }
+
+  friend BigInt operator^(const BigInt& lhs, const BigInt& rhs) {
+    return bitwise(lhs, rhs, [](Limb a, Limb b) { return a ^ b; });
+  }
+
+ private:
+  bool negative_ = false;
+  Magnitude limbs_;
+
+  BigInt(bool negative, Magnitude limbs) : limbs_(std::move(limbs)) {
+    trim(limbs_);
+    negative_ = negative && !limbs_.empty();
+  }
+
+  void setMagnitude(uint64_t magnitude) {
+    limbs_.clear();
+    if (magnitude != 0) limbs_.push_back(static_cast<Limb>(magnitude));
+    if (magnitude >> LIMB_BITS) {
+      limbs_.push_back(static_cast<Limb>(magnitude >> LIMB_BITS));
+    }
+  }
+
+  // The 64 bits of the magnitude starting at bit `shift`
+  unsigned __int128 bitsFrom(size_t shift) const {
+    size_t index = shift / LIMB_BITS;
+    unsigned __int128 window = 0;
+    for (size_t i = 0; i < 3 && index + i < limbs_.size(); ++i) {
+      window |= static_cast<unsigned __int128>(limbs_[index + i])
+                << (LIMB_BITS * i);
+    }
+    return (window >> (shift % LIMB_BITS)) & UINT64_MAX;
+  }
+
+  bool hasBitsBelow(size_t shift) const {
+    size_t index = shift / LIMB_BITS;
+    for (size_t i = 0; i < index; ++i) {
+      if (limbs_[i] != 0) return true;
+    }
+    Limb mask = (Limb{1} << (shift % LIMB_BITS)) - 1;
+    return (limbs_[index] & mask) != 0;
+  }
+
+  static void trim(Magnitude& limbs) {
+    while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+  }
+
+  static int compareMagnitude(const Magnitude& lhs, const Magnitude& rhs) {
+    if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+    for (size_t i = lhs.size(); i-- > 0;) {
+      if (lhs[i] != rhs[i]) return lhs[i] < rhs[i] ? -1 : 1;
+    }
+    return 0;
+  }
+
+  static BigInt addSigned(const BigInt& lhs, bool rhsNegative,
+                          const Magnitude& rhs) {
+    if (lhs.negative_ == rhsNegative) {
+      return BigInt(rhsNegative,
+                    addMagnitude(lhs.limbs_.data(), lhs.limbs_.size(),
+                                 rhs.data(), rhs.size()));
+    }
+    if (compareMagnitude(lhs.limbs_, rhs) >= 0) {
+      return BigInt(lhs.negative_, subtractMagnitude(lhs.limbs_, rhs));
+    }
+    return BigInt(rhsNegative, subtractMagnitude(rhs, lhs.limbs_));
+  }
+
+  static Magnitude addMagnitude(const Limb* lhs, size_t lhsSize,
+                                const Limb* rhs, size_t rhsSize) {
+    if (lhsSize < rhsSize) {
+      std::swap(lhs, rhs);
+      std::swap(lhsSize, rhsSize);
+    }
+    Magnitude sum(lhsSize + 1);
+    Wide carry = 0;
+    for (size_t i = 0; i < lhsSize; ++i) {
+      carry += lhs[i];
+      if (i < rhsSize) carry += rhs[i];
+      sum[i] = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+    sum[lhsSize] = static_cast<Limb>(carry);
+    trim(sum);
+    return sum;
+  }
+
+  // |lhs| >= |rhs|
+  static Magnitude subtractMagnitude(const Magnitude& lhs,
+                                     const Magnitude& rhs) {
+    Magnitude difference = lhs;
+    subtractInPlace(difference, rhs.data(), rhs.size(), 0);
+    trim(difference);
+    return difference;
+  }
+
+  // target -= value << (offset limbs), the result must not be negative
+  static void subtractInPlace(Magnitude& target, const Limb* value,
+                              size_t size, size_t offset) {
+    Wide borrow = 0;
+    for (size_t i = 0; i < size || borrow != 0; ++i) {
+      Wide subtrahend = borrow + (i < size ? value[i] : 0);
+      Limb& limb = target[offset + i];
+      borrow = limb < subtrahend ? 1 : 0;
+      limb = static_cast<Limb>(limb - subtrahend);
+    }
+  }
+
+  // target += value << (offset limbs), target is long enough for the sum
+  static void addInPlace(Magnitude& target, const Limb* value, size_t size,
+                         size_t offset) {
+    Wide carry = 0;
+    for (size_t i = 0; i < size || carry != 0; ++i) {
+      carry += target[offset + i];
+      if (i < size) carry += value[i];
+      target[offset + i] = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+  }
+
+  // limbs = limbs * factor + addend
+  static void multiplyAdd(Magnitude& limbs, Limb factor, Limb addend) {
+    Wide carry = addend;
+    for (Limb& limb : limbs) {
+      carry += static_cast<Wide>(limb) * factor;
+      limb = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+    if (carry != 0) limbs.push_back(static_cast<Limb>(carry));
+  }
+
+  static Magnitude multiplyMagnitude(const Limb* lhs, size_t lhsSize,
+                                     const Limb* rhs, size_t rhsSize) {
+    bool square = lhs == rhs && lhsSize == rhsSize;
+    while (lhsSize > 0 && lhs[lhsSize - 1] == 0) --lhsSize;
+    while (rhsSize > 0 && rhs[rhsSize - 1] == 0) --rhsSize;
+    if (lhsSize < rhsSize) {
+      std::swap(lhs, rhs);
+      std::swap(lhsSize, rhsSize);
+    }
+    if (rhsSize == 0) return {};
+
+    if (square && rhsSize < KARATSUBA_THRESHOLD) {
+      return squareMagnitude(lhs, lhsSize);
+    }
+    Magnitude product(lhsSize + rhsSize);
+    if (rhsSize < KARATSUBA_THRESHOLD) {
+      for (size_t i = 0; i < rhsSize; ++i) {
+        Wide carry = 0;
+        for (size_t j = 0; j < lhsSize; ++j) {
+          carry += static_cast<Wide>(lhs[j]) * rhs[i] + product[i + j];
+          product[i + j] = static_cast<Limb>(carry);
+          carry >>= LIMB_BITS;
+        }
+        product[i + lhsSize] = static_cast<Limb>(carry);
+      }
+      trim(product);
+      return product;
+    }
+
+    // a much longer lhs is cut in pieces as long as rhs, so each product
+    // is balanced enough for the split below
+    if (lhsSize >= 2 * rhsSize) {
+      for (size_t offset = 0; offset < lhsSize; offset += rhsSize) {
+        size_t size = std::min(rhsSize, lhsSize - offset);
+        Magnitude part = multiplyMagnitude(lhs + offset, size, rhs, rhsSize);
+        addInPlace(product, part.data(), part.size(), offset);
+      }
+      trim(product);
+      return product;
+    }
+
+    // (a1 B + a0)(b1 B + b0) = a1 b1 B^2 + ((a1 + a0)(b1 + b0) - a1 b1 -
+    // a0 b0) B + a0 b0, with rhs longer than half the split
+    size_t half = (lhsSize + 1) / 2;
+    Magnitude low = multiplyMagnitude(lhs, half, rhs, half);
+    Magnitude high = multiplyMagnitude(lhs + half, lhsSize - half, rhs + half,
+                                       rhsSize - half);
+    Magnitude lhsSum = addMagnitude(lhs, half, lhs + half, lhsSize - half);
+    Magnitude rhsSum = square ? Magnitude()
+                              : addMagnitude(rhs, half, rhs + half,
+                                             rhsSize - half);
+    const Magnitude& rhsFactor = square ? lhsSum : rhsSum;
+    Magnitude middle = multiplyMagnitude(lhsSum.data(), lhsSum.size(),
+                                         rhsFactor.data(), rhsFactor.size());
+    subtractInPlace(middle, low.data(), low.size(), 0);
+    subtractInPlace(middle, high.data(), high.size(), 0);
+    trim(middle);
+
+    std::copy(low.begin(), low.end(), product.begin());
+    std::copy(high.begin(), high.end(), product.begin() + 2 * half);
+    addInPlace(product, middle.data(), middle.size(), half);
+    trim(product);
+    return product;
+  }
+
+  // Each cross product a_i a_j appears twice in a square, it is computed
+  // once and the sum doubled with a shift before the a_i^2 are added
+  static Magnitude squareMagnitude(const Limb* limbs, size_t size) {
+    Magnitude square(2 * size);
+    for (size_t i = 0; i < size; ++i) {
+      Wide carry = 0;
+      for (size_t j = i + 1; j < size; ++j) {
+        carry += static_cast<Wide>(limbs[i]) * limbs[j] + square[i + j];
+        square[i + j] = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+      }
+      square[i + size] = static_cast<Limb>(carry);
+    }
+
+    Limb shifted = 0;
+    for (Limb& limb : square) {
+      Limb top = limb >> (LIMB_BITS - 1);
+      limb = (limb << 1) | shifted;
+      shifted = top;
+    }
+
+    Wide carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+      carry += static_cast<Wide>(limbs[i]) * limbs[i] + square[2 * i];
+      square[2 * i] = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+      carry += square[2 * i + 1];
+      square[2 * i + 1] = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+    trim(square);
+    return square;
+  }
+
+  // Divides in place and returns the remainder
+  static Limb divideSmall(Magnitude& limbs, Limb divisor) {
+    Wide remainder = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+      Wide current = (remainder << LIMB_BITS) | limbs[i];
+      limbs[i] = static_cast<Limb>(current / divisor);
+      remainder = current % divisor;
+    }
+    trim(limbs);
+    return static_cast<Limb>(remainder);
+  }
+
+  // Truncating division of magnitudes, Knuth's algorithm D
+  static void divideMagnitude(const Magnitude& dividend,
+                              const Magnitude& divisor, Magnitude& quotient,
+                              Magnitude& remainder) {
+    if (compareMagnitude(dividend, divisor) < 0) {
+      quotient.clear();
+      remainder = dividend;
+      return;
+    }
+    if (divisor.size() == 1) {
+      quotient = dividend;
+      Limb rest = divideSmall(quotient, divisor[0]);
+      remainder.clear();
+      if (rest != 0) remainder.push_back(rest);
+      return;
+    }
+
+    // normalize so the top limb of the divisor has its high bit set, which
+    // keeps each estimated quotient limb at most two above the real one
+    int shift = std::countl_zero(divisor.back());
+    Magnitude normalizedDivisor = shiftLeftMagnitude(divisor, shift);
+    Magnitude rest = shiftLeftMagnitude(dividend, shift);
+    rest.resize(dividend.size() + 1);
+
+    size_t divisorSize = normalizedDivisor.size();
+    Limb top = normalizedDivisor[divisorSize - 1];
+    Limb next = normalizedDivisor[divisorSize - 2];
+    quotient.assign(dividend.size() - divisorSize + 1, 0);
+
+    for (size_t j = quotient.size(); j-- > 0;) {
+      Wide numerator = (static_cast<Wide>(rest[j + divisorSize]) << LIMB_BITS)
+                       | rest[j + divisorSize - 1];
+      Wide estimate = numerator / top;
+      Wide estimateRest = numerator % top;
+      while (estimate > UINT32_MAX ||
+             estimate * next > ((estimateRest << LIMB_BITS) |
+                                rest[j + divisorSize - 2])) {
+        --estimate;
+        estimateRest += top;
+        if (estimateRest > UINT32_MAX) break;
+      }
+
+      // rest -= estimate * divisor << j limbs
+      int64_t borrow = 0;
+      Wide carry = 0;
+      for (size_t i = 0; i < divisorSize; ++i) {
+        Wide product = estimate * normalizedDivisor[i] + carry;
+        carry = product >> LIMB_BITS;
+        int64_t difference = static_cast<int64_t>(rest[i + j]) - borrow -
+                             static_cast<int64_t>(product & UINT32_MAX);
+        rest[i + j] = static_cast<Limb>(difference);
+        borrow = difference < 0 ? 1 : 0;
+      }
+      int64_t difference = static_cast<int64_t>(rest[j + divisorSize]) -
+                           borrow - static_cast<int64_t>(carry);
+      rest[j + divisorSize] = static_cast<Limb>(difference);
+
+      // the estimate was one too large, add the divisor back
+      if (difference < 0) {
+        --estimate;
+        Wide sum = 0;
+        for (size_t i = 0; i < divisorSize; ++i) {
+          sum += static_cast<Wide>(rest[i + j]) + normalizedDivisor[i];
+          rest[i + j] = static_cast<Limb>(sum);
+          sum >>= LIMB_BITS;
+        }
+        rest[j + divisorSize] += static_cast<Limb>(sum);
+      }
+      quotient[j] = static_cast<Limb>(estimate);
+    }
+
+    trim(quotient);
+    rest.resize(divisorSize);
+    remainder = shiftRightMagnitude(rest, shift);
+  }
+
+  static Magnitude shiftLeftMagnitude(const Magnitude& limbs,
+                                      uint64_t shift) {
+    if (limbs.empty()) return {};
+    size_t limbShift = shift / LIMB_BITS;
+    int bitShift = shift % LIMB_BITS;
+    Magnitude shifted(limbs.size() + limbShift + 1, 0);
+    for (size_t i = 0; i < limbs.size(); ++i) {
+      Wide moved = static_cast<Wide>(limbs[i]) << bitShift;
+      shifted[i + limbShift] |= static_cast<Limb>(moved);
+      shifted[i + limbShift + 1] = static_cast<Limb>(moved >> LIMB_BITS);
+    }
+    trim(shifted);
+    return shifted;
+  }
+
+  static Magnitude shiftRightMagnitude(const Magnitude& limbs,
+                                       uint64_t shift) {
+    size_t limbShift = shift / LIMB_BITS;
+    if (limbShift >= limbs.size()) return {};
+    int bitShift = shift % LIMB_BITS;
+    Magnitude shifted(limbs.size() - limbShift);
+    for (size_t i = 0; i < shifted.size(); ++i) {
+      Wide window = limbs[i + limbShift];
+      if (i + limbShift + 1 < limbs.size()) {
+        window |= static_cast<Wide>(limbs[i + limbShift + 1]) << LIMB_BITS;
+      }
+      shifted[i] = static_cast<Limb>(window >> bitShift);
+    }
+    trim(shifted);
+    return shifted;
+  }
+
+  // Applies the operation to the two's complement limbs of both operands,
+  // one limb longer than the longest so the sign limb is always there
+  template <typename TOperation>
+  static BigInt bitwise(const BigInt& lhs, const BigInt& rhs,
+                        TOperation operation) {
+    size_t size = std::max(lhs.limbs_.size(), rhs.limbs_.size()) + 1;
+    Magnitude lhsBits = twosComplement(lhs, size);
+    Magnitude rhsBits = twosComplement(rhs, size);
+    for (size_t i = 0; i < size; ++i) {
+      lhsBits[i] = operation(lhsBits[i], rhsBits[i]);
+    }
+
+    bool negative = (lhsBits.back() >> (LIMB_BITS - 1)) != 0;
+    if (negative) negateLimbs(lhsBits);
+    return BigInt(negative, std::move(lhsBits));
+  }
+
+  static Magnitude twosComplement(const BigInt& value, size_t size) {
+    Magnitude bits = value.limbs_;
+    bits.resize(size, 0);
+    if (value.negative_) negateLimbs(bits);
+    return bits;
+  }
+
+  // Two's complement negation: invert and add one
+  static void negateLimbs(Magnitude& bits) {
+    Wide carry = 1;
+    for (Limb& limb : bits) {
+      carry += static_cast<Limb>(~limb);
+      limb = static_cast<Limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+  }
+
+  // 10^(9 * 2^k) for k = 0, 1, ..., shared by every conversion
+  static const Magnitude& decimalPower(size_t level) {
+    static std::vector<Magnitude> powers{Magnitude{1000000000}};
+    while (powers.size() <= level) {
+      const Magnitude& last = powers.back();
+      powers.push_back(multiplyMagnitude(last.data(), last.size(),
+                                         last.data(), last.size()));
+    }
+    return powers[level];
+  }
+
+  // Appends the decimal digits of the magnitude, left padded with zeros to
+  // `width` digits when width is not zero. Long magnitudes are divided by
+  // the largest cached power of ten no longer than half of them and both
+  // parts are converted on their own.
+  static void appendDecimal(const Magnitude& limbs, size_t width,
+                            std::string& text) {
+    if (limbs.size() >= SPLIT_THRESHOLD) {
+      size_t level = 0;
+      while (decimalPower(level + 1).size() * 2 <= limbs.size() + 1) ++level;
+      Magnitude high;
+      Magnitude low;
+      divideMagnitude(limbs, decimalPower(level), high, low);
+      size_t lowWidth = size_t{9} << level;
+      appendDecimal(high, width > lowWidth ? width - lowWidth : 0, text);
+      appendDecimal(low, lowWidth, text);
+      return;
+    }
+
+    // nine digits per division, the last ones come out first
+    Magnitude rest = limbs;
+    std::vector<Limb> chunks;
+    while (!rest.empty()) chunks.push_back(divideSmall(rest, 1000000000));
+
+    size_t start = text.size();
+    char buffer[16];
+    for (size_t i = chunks.size(); i-- > 0;) {
+      char* end = std::to_chars(buffer, buffer + sizeof(buffer),
+                                chunks[i]).ptr;
+      size_t digits = end - buffer;
+      if (i + 1 != chunks.size()) text.append(9 - digits, '0');
+      text.append(buffer, digits);
+    }
+    size_t written = text.size() - start;
+    if (written < width) text.insert(start, width - written, '0');
+  }
+};
+
+#endif  // BIG_INT_HPP
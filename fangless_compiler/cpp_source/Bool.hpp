@@ -30,6 +30,9 @@ class Bool : public Object {
   explicit operator bool() const { return value_; }
 
   bool equals(const Object& other) const override {
+    if (auto* number = dynamic_cast<const Number*>(&other)) {
+      return number->equals(Number(value_ ? 1 : 0));
+    }
     if (other.type() != "Bool") return false;
 
     auto* otherBool = dynamic_cast<const Bool*>(&other);
@@ -74,529 +77,6 @@ class Bool : public Object {
     return lhs == (*rhs).value_;
   }
 
-  std::shared_ptr<Number> operator+(const Bool& other) const {
-    return Number(value_? 1:0) + Number(other.value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0) + Number(other->value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator+(const Number& other) const {
-    return Number(value_? 1:0) + other;
-  }
-
-  std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& other)
-    const {
-    return Number(value_? 1:0) + *other;
-  }
-
-  std::shared_ptr<Number> operator+(const bool& other) const {
-    return Number(value_? 1:0) + Number(other? 1:0);
-  }
-
-  std::shared_ptr<Number> operator+(const int& other) const {
-    return Number(value_? 1:0) + Number(other);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& lhs,
-    const Bool& rhs) {
-    return Number(lhs->value_? 1:0) + Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0) + Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->value_? 1:0) + *rhs;
-  }
-
-  friend std::shared_ptr<Number> operator+(const Number& lhs,
-    const Bool& rhs) {
-    return lhs + Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs + Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return *lhs + Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return *lhs + Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0) + Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0) + Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs) + Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs) + Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->value_? 1:0) + Number(rhs? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->value_? 1:0) + Number(rhs);
-  }
-
-  std::shared_ptr<Number> operator-(const Bool& other) const {
-    return Number(value_? 1:0) - Number(other.value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0) - Number(other->value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator-(const Number& other) const {
-    return Number(value_? 1:0) - other;
-  }
-
-  std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& other)
-    const {
-    return Number(value_? 1:0) - *other;
-  }
-
-  std::shared_ptr<Number> operator-(const bool& other) const {
-    return Number(value_? 1:0) - Number(other? 1:0);
-  }
-
-  std::shared_ptr<Number> operator-(const int& other) const {
-    return Number(value_? 1:0) - Number(other);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& lhs,
-    const Bool& rhs) {
-    return Number(lhs->value_? 1:0) - Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0) - Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const Number& lhs,
-    const Bool& rhs) {
-    return lhs - Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs - Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return *lhs - Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return *lhs - Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0) - Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0) - Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs) - Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs) - Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->value_? 1:0) - *rhs;
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->value_? 1:0) - Number(rhs? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->value_? 1:0) - Number(rhs);
-  }
-
-  std::shared_ptr<Number> operator*(const Bool& other) const {
-    return Number(value_? 1:0) * Number(other.value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0) * Number(other->value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator*(const Number& other) const {
-    return Number(value_? 1:0) * other;
-  }
-
-  std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& other)
-    const {
-    return Number(value_? 1:0) * *other;
-  }
-
-  std::shared_ptr<Number> operator*(const bool& other) const {
-    return Number(value_? 1:0) * Number(other? 1:0);
-  }
-
-  std::shared_ptr<Number> operator*(const int& other) const {
-    return Number(value_? 1:0) * Number(other);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& lhs,
-    const Bool& rhs) {
-    return Number(lhs->value_? 1:0) * Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0) * Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const Number& lhs,
-    const Bool& rhs) {
-    return lhs * Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs * Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return *lhs * Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return *lhs * Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0) * Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0) * Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs) * Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs) * Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->value_? 1:0) * *rhs;
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->value_? 1:0) * Number(rhs? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->value_? 1:0) * Number(rhs);
-  }
-
-  std::shared_ptr<Number> operator%(const Bool& other) const {
-    return Number(value_? 1:0) % Number(other.value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0) % Number(other->value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator%(const Number& other) const {
-    return Number(value_? 1:0) % other;
-  }
-
-  std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& other)
-    const {
-    return Number(value_? 1:0) % *other;
-  }
-
-  std::shared_ptr<Number> operator%(const bool& other) const {
-    return Number(value_? 1:0) % Number(other? 1:0);
-  }
-
-  std::shared_ptr<Number> operator%(const int& other) const {
-    return Number(value_? 1:0) % Number(other);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& lhs,
-    const Bool& rhs) {
-    return Number(lhs->value_? 1:0) % Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0) % Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const Number& lhs,
-    const Bool& rhs) {
-    return lhs % Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs % Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return *lhs % Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return *lhs % Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0) % Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0) % Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs) % Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs) % Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->value_? 1:0) % *rhs;
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->value_? 1:0) % Number(rhs? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->value_? 1:0) % Number(rhs);
-  }
-
-  std::shared_ptr<Number> operator/(const Bool& other) const {
-    return Number(value_? 1:0) / Number(other.value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0) / Number(other->value_? 1:0);
-  }
-
-  std::shared_ptr<Number> operator/(const Number& other) const {
-    return Number(value_? 1:0) / other;
-  }
-
-  std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& other)
-    const {
-    return Number(value_? 1:0) / *other;
-  }
-
-  std::shared_ptr<Number> operator/(const bool& other) const {
-    return Number(value_? 1:0) / Number(other? 1:0);
-  }
-
-  std::shared_ptr<Number> operator/(const int& other) const {
-    return Number(value_? 1:0) / Number(other);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& lhs,
-    const Bool& rhs) {
-    return Number(lhs->value_? 1:0) / Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0) / Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const Number& lhs,
-    const Bool& rhs) {
-    return lhs / Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs / Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return *lhs / Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return *lhs / Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0) / Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0) / Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs) / Number(rhs.value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs) / Number(rhs->value_? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->value_? 1:0) / *rhs;
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->value_? 1:0) / Number(rhs? 1:0);
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->value_? 1:0) / Number(rhs);
-  }
-
-  std::shared_ptr<Number> pow(const Bool& other) const {
-    return Number(value_? 1:0).pow(Number::spawn(other.value_? 1:0));
-  }
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& other) const {
-    return Number(value_? 1:0).pow(Number::spawn(other->value_? 1:0));
-  }
-  std::shared_ptr<Number> pow(const Number& other) const {
-    return Number(value_? 1:0).pow(std::make_shared<Number>(other));
-  }
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& other) const {
-    return Number(value_? 1:0).pow(other);
-  }
-  std::shared_ptr<Number> pow(const bool& other) const {
-    return Number(value_? 1:0).pow(Number::spawn(other? 1:0));
-  }
-  std::shared_ptr<Number> pow(const int& other) const {
-    return Number(value_? 1:0).pow(Number::spawn(other));
-  }
-
-  friend std::shared_ptr<Number> pow(const Bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs.value_? 1:0).pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs->value_? 1:0).pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const Number& lhs, const Bool& rhs) {
-    return lhs.pow(Number::spawn(rhs.value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const Number& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs.pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Number>& lhs,
-    const Bool& rhs) {
-    return lhs->pow(Number::spawn(rhs.value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Number>& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return lhs->pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const bool& lhs,
-    const Bool& rhs) {
-    return Number(lhs? 1:0).pow(Number::spawn(rhs.value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const bool& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs? 1:0).pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const int& lhs,
-    const Bool& rhs) {
-    return Number(lhs).pow(Number::spawn(rhs.value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const int& lhs,
-    const std::shared_ptr<Bool>& rhs) {
-    return Number(lhs).pow(Number::spawn(rhs->value_? 1:0));
-  }
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return Number(lhs->toBool()? 1:0).pow(rhs);
-  }
-
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& lhs,
-    const bool& rhs) {
-    return Number(lhs->toBool()? 1:0).pow(Number::spawn(rhs? 1:0));
-  }
-
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& lhs,
-    const int& rhs) {
-    return Number(lhs->toBool()? 1:0).pow(Number::spawn(rhs));
-  }
-
   friend std::shared_ptr<Number> operator<<(const std::shared_ptr<Bool>& lhs,
     const std::shared_ptr<Bool>& rhs) {
     return Number(lhs->toBool()? 1:0) << Number(rhs->toBool()? 1:0);
@@ -612,9 +92,10 @@ class Bool : public Object {
     return Number(lhs->toBool()? 1:0) << *rhs;
   }
 
-  friend std::shared_ptr<Number> operator<<=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator<<=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator<<=(Number(rhs->toBool() ? 1 : 0));
+    Number::unshare(lhs)->operator<<=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
   friend std::shared_ptr<Number> operator>>(const std::shared_ptr<Bool>& lhs,
@@ -632,34 +113,40 @@ class Bool : public Object {
     return Number(lhs->toBool()? 1:0) >> *rhs;
   }
 
-  friend std::shared_ptr<Number> operator>>=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator>>=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator>>=(Number(rhs->toBool() ? 1 : 0));
+    Number::unshare(lhs)->operator>>=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator+=(const std::shared_ptr<Number>& lhs,
-                                           const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator+=( Number(rhs->toBool() ? 1 : 0) );
+  friend std::shared_ptr<Number>& operator+=(std::shared_ptr<Number>& lhs,
+                                             const std::shared_ptr<Bool>& rhs) {
+    Number::unshare(lhs)->operator+=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator-=(const std::shared_ptr<Number>& lhs,
-                                           const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator-=( Number(rhs->toBool() ? 1 : 0) );
+  friend std::shared_ptr<Number>& operator-=(std::shared_ptr<Number>& lhs,
+                                             const std::shared_ptr<Bool>& rhs) {
+    Number::unshare(lhs)->operator-=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator%=(const std::shared_ptr<Number>& lhs,
-                                           const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator%=( Number(rhs->toBool() ? 1 : 0) );
+  friend std::shared_ptr<Number>& operator%=(std::shared_ptr<Number>& lhs,
+                                             const std::shared_ptr<Bool>& rhs) {
+    Number::unshare(lhs)->operator%=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator/=(const std::shared_ptr<Number>& lhs,
-                                           const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator/=( Number(rhs->toBool() ? 1 : 0) );
+  friend std::shared_ptr<Number>& operator/=(std::shared_ptr<Number>& lhs,
+                                             const std::shared_ptr<Bool>& rhs) {
+    Number::unshare(lhs)->operator/=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator*=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator*=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Bool>& rhs) {
-    return lhs->operator*=(Number(rhs->toBool() ? 1 : 0));
+    Number::unshare(lhs)->operator*=(Number(rhs->toBool() ? 1 : 0));
+    return lhs;
   }
 
 
@@ -1036,7 +523,7 @@ class Bool : public Object {
     return a;
   }
 
-  size_t hash() const override { return std::hash<bool>{}(value_); }
+  size_t hash() const override { return value_ ? 1 : 0; }
 
   bool toBool() const override { return value_; }
 
@@ -1089,7 +576,10 @@ class Bool : public Object {
   }
 
   std::strong_ordering compare(const Object& other) const override {
-    if (other.type() != "Bool") return other.toBool() <=> value_;
+    if (auto* number = dynamic_cast<const Number*>(&other)) {
+      return Number(value_ ? 1 : 0).compare(*number);
+    }
+    if (other.type() != "Bool") return value_ <=> other.toBool();
 
     auto* otherBool = dynamic_cast<const Bool*>(&other);
 
@@ -1106,7 +596,7 @@ class Bool : public Object {
   }
   friend std::strong_ordering operator<=>(const std::shared_ptr<Object>& lhs,
                                           const Bool& rhs) {
-    return rhs.compare(*lhs);
+    return 0 <=> rhs.compare(*lhs);
   }
 
   friend std::strong_ordering operator<=>(const std::shared_ptr<Bool>& lhs,
@@ -1116,7 +606,7 @@ class Bool : public Object {
 
   friend std::strong_ordering operator<=>(const std::shared_ptr<Number>& lhs,
                                           const Bool& rhs) {
-    return rhs.compare(*lhs);
+    return 0 <=> rhs.compare(*lhs);
   } 
   friend std::strong_ordering operator<=>(const Bool& lhs,
                                           const std::shared_ptr<Number>& rhs) {
@@ -1124,7 +614,7 @@ class Bool : public Object {
   }
   friend std::strong_ordering operator<=>(const std::shared_ptr<Number>& lhs,
                                           const std::shared_ptr<Bool>& rhs) {
-    return rhs->compare(*lhs);
+    return 0 <=> rhs->compare(*lhs);
   }
   friend std::strong_ordering operator<=>(const std::shared_ptr<Bool>& lhs,
                                           const std::shared_ptr<Number>& rhs) {
@@ -1133,7 +623,7 @@ class Bool : public Object {
 
   friend std::strong_ordering operator<=>(const std::shared_ptr<Object>& lhs,
                                           const std::shared_ptr<Bool>& rhs) {
-    return rhs->compare(*lhs);
+    return 0 <=> rhs->compare(*lhs);
   }
 
   bool isInstance(const std::string& type) const override {
@@ -1146,4 +636,13 @@ class Bool : public Object {
   }
 };
 
+// A bool in arithmetic is the int 0 or 1
+inline Number::Operand numericOperand(const Bool& value) {
+  return Number::Operand::of(value.toBool() ? 1 : 0);
+}
+
+inline Number::Operand numericOperand(const std::shared_ptr<Bool>& value) {
+  return Number::Operand::of(value->toBool() ? 1 : 0);
+}
+
 #endif  // BOOL_HPP
\ No newline at end of file
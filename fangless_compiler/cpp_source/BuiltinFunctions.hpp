@@ -1,8 +1,12 @@
 #ifndef BUILTIN_FUNCTIONS_HPP
 #define BUILTIN_FUNCTIONS_HPP
 #include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstdlib>
 #include <cmath>
+#include <concepts>
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -13,14 +17,19 @@
 #include <filesystem>
 #include <type_traits>
 
+#include "Array.hpp"
 #include "Bool.hpp"
+#include "ColumnList.hpp"
 #include "Dictionary.hpp"
 #include "Iterable.hpp"
 #include "Function.hpp"
+#include "IntegerMath.hpp"
 #include "List.hpp"
 #include "None.hpp"
 #include "Number.hpp"
+#include "RecordCursor.hpp"
 #include "Set.hpp"
+#include "SpilledList.hpp"
 #include "String.hpp"
 #include "Tuple.hpp"
 
@@ -31,6 +40,9 @@ namespace BF {
     if (num->isDouble()) {
       return Number::spawn(std::abs(num->getDouble()));
     }
+    if (num->isBig() || num->getInt() == INT64_MIN) [[unlikely]] {
+      return Number::spawn(num->toBigInt().abs());
+    }
     return Number::spawn(static_cast<int64_t>(std::abs(num->getInt())));
   }
 
@@ -42,6 +54,18 @@ namespace BF {
     return abs(Number::spawn(num));
   }
 
+  // Elements of containers, for example as sort keys, come as Objects
+  std::shared_ptr<Number> abs(const std::shared_ptr<Object>& object) {
+    if (auto number = std::dynamic_pointer_cast<Number>(object)) {
+      return abs(number);
+    }
+    if (dynamic_cast<const Bool*>(object.get()) != nullptr) {
+      return abs(object->toBool());
+    }
+    throw std::runtime_error("bad operand type for abs(): '" +
+                             object->type() + "'");
+  }
+
   std::shared_ptr<Bool> any(const std::shared_ptr<String>& string) {
     return Bool::spawn(string->toBool());
   }
@@ -107,33 +131,25 @@ namespace BF {
     return String::spawn(anything->type());
   }
 
-  std::shared_ptr<std::wstring> chr(const std::shared_ptr<Number>& code) {
-    std::wstring str;
-    const int codeInt = code->getInt();
-
-    if (codeInt <= 0xFFFF) {
-      str += static_cast<wchar_t>(codeInt);
-    } else if (codeInt <= 0x10FFFF) {
-      str += static_cast<wchar_t>(0xD800 + ((codeInt - 0x10000) >> 10));
-      str += static_cast<wchar_t>(0xDC00 + ((codeInt - 0x10000) & 0x3FF));
-    } else {
-      throw std::out_of_range(
-        "Code is out of valid Unicode range (0x0 to 0x10FFFF)."
-      );
+  std::shared_ptr<String> chr(const std::shared_ptr<Number>& code) {
+    const int64_t codePoint = code->getInt();
+    if (codePoint < 0) {
+      throw std::out_of_range("chr() arg not in range(0x110000)");
     }
 
-    return std::make_shared<std::wstring>(str);
+    return String::spawn(StringUtf8::encode(
+      static_cast<uint32_t>(std::min<int64_t>(codePoint, UINT32_MAX))));
   }
 
-  std::shared_ptr<std::wstring> chr(const std::shared_ptr<Bool>& code) {
+  std::shared_ptr<String> chr(const std::shared_ptr<Bool>& code) {
     return chr(Number::spawn(code->toBool()? 1:0));
   }
 
-  std::shared_ptr<std::wstring> chr(const bool& code) {
+  std::shared_ptr<String> chr(const bool& code) {
     return chr(Number::spawn(code? 1:0));
   }
 
-  std::shared_ptr<std::wstring> chr(const int& code) {
+  std::shared_ptr<String> chr(const int& code) {
     return chr(Number::spawn(code));
   }
 
@@ -147,23 +163,8 @@ namespace BF {
       throw std::runtime_error("Attempted to perform a division by 0");
     }
 
-    if (dividend->isDouble() || divisor->isDouble()) {
-      std::shared_ptr<Number> quotient =
-        Number::spawn(static_cast<double>(
-          ((*dividend) / (*divisor))->getInt()));
-
-      std::shared_ptr<Number> remainder =
-        Number::spawn(((*dividend) % (*divisor))->getDouble());
-
-      return Tuple::spawn({quotient, remainder});
-    }
-
-    std::shared_ptr<Number> quotient =
-      Number::spawn(((*dividend) / (*divisor))->getInt());
-    std::shared_ptr<Number> remainder =
-      Number::spawn(((*dividend) % (*divisor))->getInt());
-
-    return Tuple::spawn({quotient, remainder});
+    return Tuple::spawn({dividend->floorDivide(*divisor),
+                         (*dividend) % (*divisor)});
   }
 
   std::shared_ptr<Tuple> divmod(const std::shared_ptr<Number>& dividend,
@@ -247,8 +248,8 @@ namespace BF {
     std::shared_ptr<Number> start = Number::spawn(0)) {
     std::shared_ptr<List> result = List::spawn();
 
-    for (Number i = Number(0); i < *(items->len()); ++i) {
-      result->append(Tuple::spawn({start, (*items)[i]}));
+    for (size_t i = 0; i < items->length(); ++i) {
+      result->append(Tuple::spawn({start, items->charAt(i)}));
       start = start + Number::spawn(1);
     }
 
@@ -339,12 +340,23 @@ namespace BF {
   }
 
   std::shared_ptr<Number> float_(const std::shared_ptr<String>& value) {
-    if ((**value) == "inf") {
-      return Number::spawn(std::numeric_limits<double>::infinity());
-    } else if ((**value) == "nan") {
-      return Number::spawn(std::numeric_limits<double>::quiet_NaN());
+    return Number::spawn(value->toFloat());
+  }
+
+  // Loop variables and container items only know their type at runtime
+  std::shared_ptr<Number> float_(const std::shared_ptr<Object>& value) {
+    if (auto* text = dynamic_cast<const String*>(value.get())) {
+      return Number::spawn(text->toFloat());
     }
-    return Number::spawn(std::stod(**value));
+    if (auto* number = dynamic_cast<const Number*>(value.get())) {
+      return Number::spawn(number->getDouble());
+    }
+    if (dynamic_cast<const Bool*>(value.get()) != nullptr) {
+      return Number::spawn(value->toBool() ? 1.0 : 0.0);
+    }
+    throw std::runtime_error(
+      "float() argument must be a string or a real number, not '" +
+      value->type() + "'");
   }
 
   const std::shared_ptr<Set> frozenset() {
@@ -354,8 +366,8 @@ namespace BF {
   const std::shared_ptr<Set> frozenset(const std::shared_ptr<String>& items) {
     std::shared_ptr<Set> set = Set::spawn();
 
-    for (Number i = Number(0); i < *(items->len()); ++i) {
-      set->add((*items)[i]);
+    for (size_t i = 0; i < items->length(); ++i) {
+      set->add(items->charAt(i));
     }
 
     return set;
@@ -384,6 +396,12 @@ namespace BF {
     return set;
   }
 
+  // Numbers and tuples of numbers hash to the values CPython gives them,
+  // strings to a hash of their own
+  std::shared_ptr<Number> hash(const std::shared_ptr<Object>& object) {
+    return Number::spawn(static_cast<int64_t>(object->hash()));
+  }
+
   const std::shared_ptr<Number> id(const std::shared_ptr<Object>& object) {
     return Number::spawn(static_cast<int64_t>(object->id_));
   }
@@ -410,23 +428,31 @@ namespace BF {
     return Number::spawn(0);
   }
 
-  std::shared_ptr<Number> int_(const std::shared_ptr<Number>& value,
-    const std::shared_ptr<Number>& base = Number::spawn(10)) {
-    if (base == Number::spawn(10)) {
-      return Number::spawn(value->getInt());
+  // int(x) truncates floats toward zero
+  std::shared_ptr<Number> int_(const std::shared_ptr<Number>& value) {
+    if (!value->isDouble()) return value;
+
+    double number = value->getDouble();
+    if (std::isinf(number)) {
+      throw std::overflow_error("cannot convert float infinity to integer");
+    }
+    if (std::isnan(number)) {
+      throw std::invalid_argument("cannot convert float NaN to integer");
     }
-    
-    int intValue = value->getInt();
-    int intBase = value->getInt();
-    int placeValue = 1;
-    int result = 0;
-    
-    while (intValue > 0) {
-        result += (intValue % intBase) * placeValue;
-        intValue /= intBase;
+    // 2^63 is the first float past the int64 range
+    if (std::fabs(number) >= 9223372036854775808.0) [[unlikely]] {
+      return Number::spawn(BigInt::fromDouble(number));
     }
-    
-    return Number::spawn(result);
+    return Number::spawn(static_cast<int64_t>(std::trunc(number)));
+  }
+
+  // A base is only allowed when converting text
+  std::shared_ptr<Number> int_(const std::shared_ptr<Number>& value,
+    const std::shared_ptr<Number>& base) {
+    (void)value;
+    (void)base;
+    throw std::runtime_error(
+      "int() can't convert non-string with explicit base");
   }
 
   std::shared_ptr<Number> int_(const std::shared_ptr<Number>& value,
@@ -439,8 +465,12 @@ namespace BF {
     return int_(value, Number::spawn(base));
   }
 
+  std::shared_ptr<Number> int_(const std::shared_ptr<Bool>& value) {
+    return Number::spawn(static_cast<int64_t>(value->toBool() ? 1 : 0));
+  }
+
   std::shared_ptr<Number> int_(const std::shared_ptr<Bool>& value,
-    const std::shared_ptr<Number>& base = Number::spawn(10)) {
+    const std::shared_ptr<Number>& base) {
     return int_(Number::spawn((value->toBool())? 1:0), base);
   }
 
@@ -455,8 +485,12 @@ namespace BF {
     return int_(Number::spawn((value->toBool())? 1:0), Number::spawn(base));
   }
 
+  std::shared_ptr<Number> int_(const bool& value) {
+    return Number::spawn(static_cast<int64_t>(value ? 1 : 0));
+  }
+
   std::shared_ptr<Number> int_(const bool& value,
-    const std::shared_ptr<Number>& base = Number::spawn(10)) {
+    const std::shared_ptr<Number>& base) {
     return int_(Number::spawn((value? 1:0)), base);
   }
 
@@ -471,8 +505,12 @@ namespace BF {
     return int_(Number::spawn(value? 1:0), Number::spawn(base));
   }
 
+  std::shared_ptr<Number> int_(const int& value) {
+    return Number::spawn(value);
+  }
+
   std::shared_ptr<Number> int_(const int& value,
-    const std::shared_ptr<Number>& base = Number::spawn(10)) {
+    const std::shared_ptr<Number>& base) {
     return int_(Number::spawn((value)), base);
   }
 
@@ -489,7 +527,7 @@ namespace BF {
 
   std::shared_ptr<Number> int_(const std::shared_ptr<String>& value,
     const std::shared_ptr<Number>& base = Number::spawn(10)) {
-    return Number::spawn(std::stoi(**value, nullptr, base->getInt()));
+    return value->toInt(static_cast<int>(base->getInt()));
   }
 
   std::shared_ptr<Number> int_(const std::shared_ptr<String>& value,
@@ -501,6 +539,30 @@ namespace BF {
     const int& base) {
     return int_(value, Number::spawn(base));
   }
+
+  std::shared_ptr<Number> int_(const std::shared_ptr<Object>& value) {
+    if (auto* text = dynamic_cast<const String*>(value.get())) {
+      return text->toInt();
+    }
+    if (dynamic_cast<const Number*>(value.get()) != nullptr) {
+      return int_(std::static_pointer_cast<Number>(value));
+    }
+    if (dynamic_cast<const Bool*>(value.get()) != nullptr) {
+      return Number::spawn(static_cast<int64_t>(value->toBool() ? 1 : 0));
+    }
+    throw std::runtime_error(
+      "int() argument must be a string, a bytes-like object or a real "
+      "number, not '" + value->type() + "'");
+  }
+
+  std::shared_ptr<Number> int_(const std::shared_ptr<Object>& value,
+    const std::shared_ptr<Number>& base) {
+    if (auto* text = dynamic_cast<const String*>(value.get())) {
+      return text->toInt(static_cast<int>(base->getInt()));
+    }
+    throw std::runtime_error(
+      "int() can't convert non-string with explicit base");
+  }
   
   template<TIterable TType>
   auto iter(const std::shared_ptr<TType>& structure) {
@@ -512,6 +574,27 @@ namespace BF {
     return structure->len();
   }
 
+  // Elements of containers, for example as sort keys, come as Objects
+  std::shared_ptr<Number> len(const std::shared_ptr<Object>& object) {
+    if (auto string = std::dynamic_pointer_cast<String>(object)) {
+      return string->len();
+    }
+    if (auto items = std::dynamic_pointer_cast<List>(object)) {
+      return items->len();
+    }
+    if (auto items = std::dynamic_pointer_cast<Tuple>(object)) {
+      return items->len();
+    }
+    if (auto items = std::dynamic_pointer_cast<Dictionary>(object)) {
+      return items->len();
+    }
+    if (auto items = std::dynamic_pointer_cast<Set>(object)) {
+      return items->len();
+    }
+    throw std::runtime_error("object of type '" + object->type() +
+                             "' has no len()");
+  }
+
   std::shared_ptr<List> list() {
     return List::spawn();
   }
@@ -519,8 +602,8 @@ namespace BF {
   const std::shared_ptr<List> list(const std::shared_ptr<String>& items) {
     std::shared_ptr<List> result = List::spawn();
 
-    for (Number i = Number(0); i < *(items->len()); ++i) {
-      result->append((*items)[i]);
+    for (size_t i = 0; i < items->length(); ++i) {
+      result->append(items->charAt(i));
     }
 
     return result;
@@ -541,10 +624,33 @@ namespace BF {
     return result;
   }
 
+  // The first largest element, found in one pass over values
   template<TIterable TType>
-  auto max(const std::shared_ptr<TType>& values) {
-    std::shared_ptr<List> realValues = list(values);
-    return *(std::max_element(realValues->begin(), realValues->end()));
+  std::shared_ptr<Object> max(const std::shared_ptr<TType>& values) {
+    auto it = values->begin();
+    if (it == values->end()) {
+      throw std::invalid_argument("max() arg is an empty sequence");
+    }
+    std::shared_ptr<Object> best = *it;
+    for (++it; it != values->end(); ++it) {
+      std::shared_ptr<Object> item = *it;
+      if (*best < *item) best = item;
+    }
+    return best;
+  }
+
+  std::shared_ptr<Object> max(const std::shared_ptr<List>& values) {
+    if (auto best = values->numericExtreme<true>()) return best;
+    return max<List>(values);
+  }
+
+  // Strings compare their characters and dictionaries their keys
+  std::shared_ptr<Object> max(const std::shared_ptr<String>& values) {
+    return max(list(values));
+  }
+
+  std::shared_ptr<Object> max(const std::shared_ptr<Dictionary>& values) {
+    return max(values->keys());
   }
 
   template<typename ... TArgs>
@@ -555,10 +661,36 @@ namespace BF {
     return *(std::max_element(realValues->begin(), realValues->end()));
   }
 
+  std::shared_ptr<Number> max(const std::shared_ptr<Array>& values) {
+    return values->extreme<true>();
+  }
+
+  // The first smallest element, found in one pass over values
   template<TIterable TType>
-  auto min(const std::shared_ptr<TType>& values) {
-    std::shared_ptr<List> realValues = list(values);
-    return *(std::min_element(realValues->begin(), realValues->end()));
+  std::shared_ptr<Object> min(const std::shared_ptr<TType>& values) {
+    auto it = values->begin();
+    if (it == values->end()) {
+      throw std::invalid_argument("min() arg is an empty sequence");
+    }
+    std::shared_ptr<Object> best = *it;
+    for (++it; it != values->end(); ++it) {
+      std::shared_ptr<Object> item = *it;
+      if (*item < *best) best = item;
+    }
+    return best;
+  }
+
+  std::shared_ptr<Object> min(const std::shared_ptr<List>& values) {
+    if (auto best = values->numericExtreme<false>()) return best;
+    return min<List>(values);
+  }
+
+  std::shared_ptr<Object> min(const std::shared_ptr<String>& values) {
+    return min(list(values));
+  }
+
+  std::shared_ptr<Object> min(const std::shared_ptr<Dictionary>& values) {
+    return min(values->keys());
   }
 
   template<typename ... TArgs>
@@ -569,6 +701,10 @@ namespace BF {
     return *(std::min_element(realValues->begin(), realValues->end()));
   }
 
+  std::shared_ptr<Number> min(const std::shared_ptr<Array>& values) {
+    return values->extreme<false>();
+  }
+
   template <TAdvIterator TIterator>
   TIterator next(TIterator& iter) {
       TIterator current = iter;
@@ -576,607 +712,194 @@ namespace BF {
       return current;
   }
 
-  auto open(const std::shared_ptr<String>& path,
+  // The stream is shared like every other value, close() flushes it and the
+  // last handle to go closes it otherwise
+  std::shared_ptr<std::fstream> open(const std::shared_ptr<String>& path,
       const std::shared_ptr<String>& mode) {
-    std::ios_base::openmode resultingMode;
+    std::ios_base::openmode resultingMode = std::ios_base::openmode();
+    bool isReading = false;
     bool isCreating = false;
 
-    for (const char& character : *mode) {
+    for (char character : **mode) {
       if (character == 'r') {
         resultingMode |= std::ios_base::in;
-      } else if ((character == '+') | (character == 'w')) {
-        resultingMode |= std::ios_base::out;
+        isReading = true;
+      } else if (character == 'w') {
+        resultingMode |= std::ios_base::out | std::ios_base::trunc;
+      } else if (character == '+') {
+        resultingMode |= std::ios_base::in | std::ios_base::out;
       } else if (character == 'a') {
         resultingMode |= std::ios_base::out | std::ios_base::app;
       } else if (character == 'b') {
         resultingMode |= std::ios_base::binary;
       } else if (character == 'x') {
-        if (!std::filesystem::exists(**path)) {
-          throw std::invalid_argument(
-            std::string("File: ") + (**path) + " does not exists"
-          );
-        }
-        resultingMode |= std::ios_base::out;
+        resultingMode |= std::ios_base::out | std::ios_base::trunc;
         isCreating = true;
       }
     }
 
-    if (!std::filesystem::exists(**path) && !isCreating) {
+    const bool exists = std::filesystem::exists(**path);
+    if (isReading && !exists) {
       throw std::invalid_argument(
-        std::string("File: ") + (**path) + " does not exists"
+        std::string("No such file or directory: '") + (**path) + "'"
+      );
+    }
+    if (isCreating && exists) {
+      throw std::invalid_argument(
+        std::string("File exists: '") + (**path) + "'"
       );
     }
 
-    return std::fstream((**path).c_str(), resultingMode);
+    auto file = std::make_shared<std::fstream>((**path).c_str(),
+                                               resultingMode);
+    if (!file->is_open()) {
+      throw std::runtime_error(
+        std::string("Could not open file: '") + (**path) + "'"
+      );
+    }
+    return file;
   }
 
   std::shared_ptr<Number> ord(const std::shared_ptr<String>& character) {
-    return Number::spawn(static_cast<int>((**character)[0]));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Number>& exponent) {
-    return base->pow(exponent);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Number>& exponent) {
-    return Number::spawn(base->toBool()? 1:0)->pow(exponent);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Bool>& exponent) {
-    return base->pow(Number::spawn(exponent->toBool()? 1:0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Number>& exponent) {
-    return Number::spawn(base? 1:0)->pow(exponent);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const bool& exponent) {
-    return base->pow(Number::spawn(exponent? 1:0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const bool& exponent) {
-    return Number::spawn(base? 1:0)->pow(Number::spawn(exponent? 1:0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Number>& exponent) {
-    return Number::spawn(base)->pow(exponent);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const int& exponent) {
-    return base->pow(Number::spawn(exponent));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const int& exponent) {
-    return Number::spawn(base)->pow(Number::spawn(exponent));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const bool& exponent) {
-    return Number::spawn(base->toBool() ? 1 : 0)->pow(
-      Number::spawn(exponent ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Bool>& exponent) {
-      return Number::spawn(base ? 1 : 0)->pow(
-        Number::spawn(exponent->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const int& exponent) {
-    return Number::spawn(base->toBool() ? 1 : 0)->pow(Number::spawn(exponent));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Bool>& exponent) {
-    return Number::spawn(base)->pow(Number::spawn(exponent->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const int& exponent) {
-    return Number::spawn(base ? 1 : 0)->pow(Number::spawn(exponent));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const bool& exponent) {
-      return Number::spawn(base)->pow(Number::spawn(exponent ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return base->pow(exponent) % modulus;
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base->toBool()? 1:0), exponent, modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(base, Number::spawn(exponent->toBool() ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(base, exponent, Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0), exponent,
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(base, Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), exponent, modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const bool& exponent, const std::shared_ptr<Number>& modulus) {
-    return pow(base, Number::spawn(exponent ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Number>& exponent, const bool& modulus) {
-    return pow(base, exponent, Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const bool& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      Number::spawn(exponent ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Number>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), exponent,
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const bool& exponent, const bool& modulus) {
-    return pow(base, Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const bool& exponent,
-    const bool& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base), exponent, modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const int& exponent, const std::shared_ptr<Number>& modulus) {
-    return pow(base, Number::spawn(exponent), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Number>& exponent, const int& modulus) {
-    return pow(base, exponent, Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const int& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Number>& exponent, const int& modulus) {
-    return pow(Number::spawn(base), exponent, Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const int& exponent, const int& modulus) {
-    return pow(base, Number::spawn(exponent), Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const int& exponent,
-    const int& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Bool>& exponent, const bool& modulus) {
-    return pow(base, Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const std::shared_ptr<Bool>& exponent, const int& modulus) {
-    return pow(base, Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const bool& exponent, const std::shared_ptr<Bool>& modulus) {
-    return pow(base, Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
+    size_t length = character->length();
+    if (length != 1) {
+      throw std::runtime_error(
+        "ord() expected a character, but string of length " +
+        std::to_string(length) + " found"
+      );
+    }
 
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const bool& exponent, const int& modulus) {
-    return pow(base, Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus));
+    return Number::spawn(static_cast<int64_t>(
+      StringUtf8::decode(**character)));
   }
 
-  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const int& exponent, const std::shared_ptr<Bool>& modulus) {
-    return pow(base, Number::spawn(exponent),
-      Number::spawn(modulus->toBool() ? 1 : 0));
+  // base ** exponent for every mix of numbers, bools and ints
+  template <NumericOperand TBase, NumericOperand TExponent>
+  std::shared_ptr<Number> pow(const TBase& base, const TExponent& exponent) {
+    return Number::arithmetic<Number::Power>(numericOperand(base),
+                                             numericOperand(exponent));
   }
 
+  // b^e is never built: the base is reduced mod |m| and so is every
+  // product, a negative e raises the inverse of the base
   std::shared_ptr<Number> pow(const std::shared_ptr<Number>& base,
-    const int& exponent, const bool& modulus) {
-    return pow(base, Number::spawn(exponent), Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Number>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0), exponent,
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Number>& exponent, const int& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0), exponent,
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Bool>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const std::shared_ptr<Bool>& exponent, const int& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0), Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const bool& exponent, const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const bool& exponent, const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const bool& exponent, const bool& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent ? 1 : 0), Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const bool& exponent, const int& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent ? 1 : 0), Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const int& exponent, const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const int& exponent, const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent), Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const int& exponent, const bool& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent), Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const std::shared_ptr<Bool>& base,
-    const int& exponent, const int& modulus) {
-    return pow(Number::spawn(base->toBool() ? 1 : 0),
-      Number::spawn(exponent), Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
     const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      exponent, Number::spawn(modulus->toBool() ? 1 : 0));
-}
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Number>& exponent, const int& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), exponent, Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0), Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Bool>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const std::shared_ptr<Bool>& exponent, const int& modulus) {
-    return pow(Number::spawn(base ? 1 : 0),
-      Number::spawn(exponent->toBool() ? 1 : 0), Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base,
-    const bool& exponent, const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const bool& exponent,
-    const int& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const int& exponent,
     const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const int& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const int& exponent,
-    const bool& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const bool& base, const int& exponent,
-    const int& modulus) {
-    return pow(Number::spawn(base ? 1 : 0), Number::spawn(exponent),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Number>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base), exponent,
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Number>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base), exponent, Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent->toBool() ? 1 : 0),
-      modulus);
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Bool>& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Bool>& exponent, const bool& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base,
-    const std::shared_ptr<Bool>& exponent, const int& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent->toBool() ? 1 : 0),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const bool& exponent,
-    const std::shared_ptr<Number>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent ? 1 : 0), modulus);
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const bool& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const bool& exponent,
-    const bool& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const bool& exponent,
-    const int& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent ? 1 : 0),
-      Number::spawn(modulus));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const int& exponent,
-    const std::shared_ptr<Bool>& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent),
-      Number::spawn(modulus->toBool() ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> pow(const int& base, const int& exponent,
-    const bool& modulus) {
-    return pow(Number::spawn(base), Number::spawn(exponent),
-      Number::spawn(modulus ? 1 : 0));
-  }
-
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Number>& dividend,
-    const std::shared_ptr<Number>& divisor) {
-    return Number::spawn(static_cast<int>(
-      std::floor(dividend->getDouble() / divisor->getDouble())));
-  }
-
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Bool>& dividend,
-    const std::shared_ptr<Number>& divisor) {
-    return intDiv(Number::spawn(dividend->toBool()? 1:0), divisor);
-  }
-
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Number>& dividend,
-    const std::shared_ptr<Bool>& divisor) {
-    return intDiv(dividend, Number::spawn(divisor->toBool()? 1:0));
-  }
+    if (base->isDouble() || exponent->isDouble() || modulus->isDouble()) {
+      throw std::runtime_error(
+        "pow() 3rd argument not allowed unless all arguments are integers");
+    }
+    if (!modulus->toBool()) {
+      throw std::invalid_argument("pow() 3rd argument cannot be 0");
+    }
 
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Bool>& dividend,
-    const std::shared_ptr<Bool>& divisor) {
-    return intDiv(Number::spawn(dividend->toBool()? 1:0),
-      Number::spawn(divisor->toBool()? 1:0));
-  }
+    if (!exponent->isBig() && !modulus->isBig() && exponent->getInt() >= 0 &&
+        modulus->getInt() != INT64_MIN) [[likely]] {
+      int64_t signedModulus = modulus->getInt();
+      int64_t size = signedModulus < 0 ? -signedModulus : signedModulus;
+      int64_t residue = ((*base) % Number(size))->getInt();
+      int64_t result = static_cast<int64_t>(IntegerMath::powMod(
+        residue, exponent->getInt(), size));
+      if (signedModulus < 0 && result != 0) result -= size;
+      return Number::spawn(result);
+    }
 
-  std::shared_ptr<Number> intDiv(const bool& dividend,
-    const std::shared_ptr<Number>& divisor) {
-    return intDiv(Number::spawn(dividend? 1:0), divisor);
+    BigInt signedModulus = modulus->toBigInt();
+    BigInt size = signedModulus.abs();
+    BigInt residue = base->toBigInt() % size;
+    BigInt power = exponent->toBigInt();
+    if (power.isNegative()) {
+      residue = IntegerMath::inverse(residue, size);
+      power = -power;
+    }
+    BigInt result = IntegerMath::powMod(residue, power, size);
+    if (signedModulus.isNegative() && !result.isZero()) result = result - size;
+    return Number::spawn(std::move(result));
   }
 
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Number>& dividend,
-    const bool& divisor) {
-    return intDiv(dividend, Number::spawn(divisor? 1:0));
+  template <NumericOperand TBase, NumericOperand TExponent,
+            NumericOperand TModulus>
+  std::shared_ptr<Number> pow(const TBase& base, const TExponent& exponent,
+    const TModulus& modulus) {
+    return pow(std::make_shared<Number>(numericOperand(base).toNumber()),
+      std::make_shared<Number>(numericOperand(exponent).toNumber()),
+      std::make_shared<Number>(numericOperand(modulus).toNumber()));
   }
 
-  std::shared_ptr<Number> intDiv(const bool& dividend,
-    const bool& divisor) {
-    return intDiv(Number::spawn(dividend? 1:0),
-      Number::spawn(divisor? 1:0));
+  // dividend // divisor for every mix of numbers, bools and ints
+  template <NumericOperand TDividend, NumericOperand TDivisor>
+  std::shared_ptr<Number> intDiv(const TDividend& dividend,
+    const TDivisor& divisor) {
+    return Number::arithmetic<Number::FloorDivision>(numericOperand(dividend),
+                                                     numericOperand(divisor));
   }
 
-  std::shared_ptr<Number> intDiv(const int& dividend,
+  // x //= y and x **= y, which have no C++ compound operator. Like the
+  // operators, a number whose handle is its sole owner is updated in
+  // place, other targets are rebound to the result
+  std::shared_ptr<Number>& intDivAssign(std::shared_ptr<Number>& target,
     const std::shared_ptr<Number>& divisor) {
-    return intDiv(Number::spawn(dividend), divisor);
+    Number::unshare(target)->floorDivideAssign(*divisor);
+    return target;
   }
 
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Number>& dividend,
-    const int& divisor) {
-    return intDiv(dividend, Number::spawn(divisor));
-  }
-
-  std::shared_ptr<Number> intDiv(const int& dividend,
-    const int& divisor) {
-    return intDiv(Number::spawn(dividend),
-      Number::spawn(divisor));
-  }
-
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Bool>& dividend,
-    const bool& divisor) {
-    return intDiv(Number::spawn(dividend->toBool() ? 1 : 0),
-      Number::spawn(divisor ? 1 : 0));
+  template<typename TTarget, typename TValue>
+  TTarget& intDivAssign(TTarget& target, const TValue& divisor) {
+    target = intDiv(target, divisor);
+    return target;
   }
 
-  std::shared_ptr<Number> intDiv(const std::shared_ptr<Bool>& dividend,
-    const int& divisor) {
-    return intDiv(Number::spawn(dividend->toBool() ? 1 : 0),
-      Number::spawn(divisor));
+  std::shared_ptr<Number>& powAssign(std::shared_ptr<Number>& target,
+    const std::shared_ptr<Number>& exponent) {
+    Number::unshare(target)->powerAssign(exponent);
+    return target;
   }
 
-  std::shared_ptr<Number> intDiv(const bool& dividend,
-    const std::shared_ptr<Bool>& divisor) {
-    return intDiv(Number::spawn(dividend ? 1 : 0),
-      Number::spawn(divisor->toBool() ? 1 : 0));
+  template<typename TTarget, typename TValue>
+  TTarget& powAssign(TTarget& target, const TValue& exponent) {
+    target = pow(target, exponent);
+    return target;
   }
 
-  std::shared_ptr<Number> intDiv(const bool& dividend, const int& divisor) {
-    return intDiv(Number::spawn(dividend ? 1 : 0),
-      Number::spawn(divisor));
-  }
+  // print() ends lines with '\n' and lets stdout buffer them, they are
+  // written out before an uncaught exception aborts the program
+  inline const std::terminate_handler previousTerminate =
+    std::set_terminate([] {
+      std::cout.flush();
+      previousTerminate();
+    });
 
-  std::shared_ptr<Number> intDiv(const int& dividend,
-    const std::shared_ptr<Bool>& divisor) {
-    return intDiv(Number::spawn(dividend),
-      Number::spawn(divisor->toBool() ? 1 : 0));
+  std::shared_ptr<None> print() {
+    std::cout << '\n';
+    return None::spawn();
   }
 
-  std::shared_ptr<Number> intDiv(const int& dividend, const bool& divisor) {
-    return intDiv(Number::spawn(dividend), Number::spawn(divisor ? 1 : 0));
+  std::shared_ptr<None> print(const char object) {
+    std::cout << object << '\n';
+    return None::spawn();
   }
 
-  std::shared_ptr<None> print() {
-    std::cout << std::endl;
+  std::shared_ptr<None> print(const Number& number) {
+    if (number.isBig()) [[unlikely]] {
+      std::cout << number.toString() << '\n';
+      return None::spawn();
+    }
+    char line[NumberFormat::BUFFER_SIZE + 1];
+    char* end = number.write(line);
+    *end++ = '\n';
+    std::cout.write(line, end - line);
     return None::spawn();
   }
 
-  std::shared_ptr<None> print(const char object) {
-    std::cout << object << std::endl;
-    return None::spawn();
+  std::shared_ptr<None> print(const std::shared_ptr<Number>& number) {
+    return print(*number);
   }
 
   std::shared_ptr<None> print(const std::shared_ptr<String>& object) {
     // if the string stars and ends with a quote, remove them
     std::string str = **object;
     str = Function::removeQuotesIfNeeded(str); 
-    std::cout << str << std::endl;
+    std::cout << str << '\n';
     return None::spawn();
   }
 
@@ -1185,20 +908,23 @@ namespace BF {
     if (auto strPtr = std::dynamic_pointer_cast<String>(object)) {
       std::string str = **strPtr;
       str = Function::removeQuotesIfNeeded(str); 
-      std::cout << str << std::endl;
+      std::cout << str << '\n';
       return None::spawn();
     }
-    std::cout << object->toString().c_str() << std::endl;
+    if (auto* number = dynamic_cast<const Number*>(object.get())) {
+      return print(*number);
+    }
+    std::cout << object->toString() << '\n';
     return None::spawn();
   }
 
   std::shared_ptr<None> print(const bool& boolean) {
-    std::cout << (boolean? "True" : "False") << std::endl;
+    std::cout << (boolean? "True" : "False") << '\n';
     return None::spawn();
   }
 
   std::shared_ptr<None> print(const int& integer) {
-    std::cout << integer << std::endl;
+    std::cout << integer << '\n';
     return None::spawn();
   }
 
@@ -1209,7 +935,7 @@ namespace BF {
 
   template<typename Any>
   std::shared_ptr<None> print(const std::shared_ptr<Any>& anything) {
-    std::cout << (*anything) << std::endl;
+    std::cout << (*anything) << '\n';
     return None::spawn();
   }
 
@@ -1220,29 +946,30 @@ namespace BF {
     std::cout << (*(iterator->first))
       << " : " 
       << (*(iterator->second))
-      << std::endl;
+      << '\n';
     return None::spawn();
   }
 
   template<TAdvIterator TIterator>
   std::shared_ptr<None> print(const TIterator& iterator) {
     using ValueType = typename std::iterator_traits<TIterator>::value_type;
-    if constexpr (std::is_same_v<ValueType, std::shared_ptr<Object>>) {
+    // string iterators give Strings, other containers give Objects
+    if constexpr (std::is_convertible_v<ValueType, std::shared_ptr<Object>>) {
       const std::shared_ptr<Object>& objPtr = *iterator;
       if (!objPtr.get()) {
-        std::cout << "The container has already been freed" << std::endl;
+        std::cout << "The container has already been freed\n";
       } else {
         // if type is string, remove quotes
         if (auto strPtr = std::dynamic_pointer_cast<String>(objPtr)) {
           std::string str = **strPtr;
-          std::cout << Function::removeQuotesIfNeeded(str) << std::endl;
+          std::cout << Function::removeQuotesIfNeeded(str) << '\n';
         } else {
-          std::cout << objPtr->toString().c_str() << std::endl;
+          print(objPtr);
         }
       }
       
     } else {
-      std::cout << (*iterator) << std::endl;
+      std::cout << (*iterator) << '\n';
     }
 
     return None::spawn();
@@ -1280,6 +1007,43 @@ namespace BF {
     return result;
   }
 
+  // Out of core list, records live in memory mapped temporary files
+  std::shared_ptr<SpilledList> spilled_list() {
+    return SpilledList::spawn();
+  }
+
+  template<TIterable TType>
+  std::shared_ptr<SpilledList> spilled_list(
+    const std::shared_ptr<TType>& items) {
+    return SpilledList::spawn(items);
+  }
+
+  // List of same-arity tuples kept column by column
+  std::shared_ptr<ColumnList> column_list() {
+    return ColumnList::spawn();
+  }
+
+  template<TIterable TType>
+  std::shared_ptr<ColumnList> column_list(
+    const std::shared_ptr<TType>& items) {
+    return ColumnList::spawn(items);
+  }
+
+  // Extension taking the sort run size, merge fan in and mapped window size
+  // in bytes, small values put a small list through the paths big ones take
+  template<TIterable TType>
+  std::shared_ptr<SpilledList> spilled_list(
+    const std::shared_ptr<TType>& items,
+    const std::shared_ptr<Number>& runBytes,
+    const std::shared_ptr<Number>& fanIn,
+    const std::shared_ptr<Number>& windowBytes) {
+    auto size = [](const std::shared_ptr<Number>& value) {
+      return static_cast<size_t>(std::max<int64_t>(value->getInt(), 0));
+    };
+    return SpilledList::spawn(
+      items, SpillLimits{size(runBytes), size(fanIn), size(windowBytes)});
+  }
+
   std::shared_ptr<Set> reversed(
     const std::shared_ptr<Set>& structure) {
     return structure;
@@ -1301,45 +1065,96 @@ namespace BF {
   }
 
   std::shared_ptr<List> reversed(const std::shared_ptr<List>& structure) {
-    std::shared_ptr<List> result = std::make_shared<List>();
-    std::shared_ptr<Number> zero = Number::spawn(0);
-
-    for (auto& item : (*structure)) {
-      result->insert(zero, item);
-    }
-
+    const List& source = *structure;
+    std::shared_ptr<List> result = List::spawn();
+    result->getElements().assign(source.rbegin(), source.rend());
     return result;
   }
 
   std::shared_ptr<String> reversed(const std::shared_ptr<String>& structure) {
-    std::shared_ptr<String> result = std::make_shared<String>();
-    
-    for (std::shared_ptr<Number> i = (structure->len() - Number::spawn(1));
-      *i >= *Number::spawn(0); --(*i)) {
-      result = result + (*structure)[*i];
+    std::string text = **structure;
+    if (structure->isAscii()) {
+      return String::spawn(std::string(text.rbegin(), text.rend()));
     }
 
-    return result;
+    // reverse the code points, keeping the bytes of each in order
+    std::string result(text.size(), '\0');
+    size_t end = text.size();
+    for (size_t offset = 0; offset < text.size();) {
+      size_t next = StringUtf8::next(text, offset);
+      end -= next - offset;
+      text.copy(result.data() + end, next - offset, offset);
+      offset = next;
+    }
+    return String::spawn(std::move(result));
   }
 
+  // round(x) is an int, ties go to the even neighbour
+  std::shared_ptr<Number> round(const std::shared_ptr<Number>& num) {
+    if (!num->isDouble()) return num;
+
+    double value = num->getDouble();
+    if (std::isinf(value)) {
+      throw std::overflow_error("cannot convert float infinity to integer");
+    }
+    if (std::isnan(value)) {
+      throw std::invalid_argument("cannot convert float NaN to integer");
+    }
+    return Number::spawn(static_cast<int64_t>(std::nearbyint(value)));
+  }
+
+  // round(x, ndigits) keeps the type of x. Floats are rounded on their exact
+  // decimal expansion, the way Python does it
   std::shared_ptr<Number> round(const std::shared_ptr<Number>& num,
-    const std::shared_ptr<Number>& decimals = Number::spawn(0)) {
-    if (decimals == Number::spawn(0)) {
-      return Number::spawn(static_cast<int64_t>(std::round(
-        static_cast<long double>(num->getDouble()))
-      ));
-    } else if (decimals <= Number::spawn(0)) {
-      std::shared_ptr<Number> nearest = Number::spawn(10)->pow(-decimals);
+    const std::shared_ptr<Number>& decimals) {
+    int64_t digits = decimals->getInt();
+
+    if (!num->isDouble()) {
+      if (digits >= 0) return num;
+      if (num->isBig()) [[unlikely]] {
+        // value = quotient * unit + remainder with 0 <= remainder < unit
+        BigInt unit = BigInt::power(BigInt(10), static_cast<uint64_t>(-digits));
+        BigInt quotient;
+        BigInt remainder;
+        BigInt::divMod(num->toBigInt(), unit, quotient, remainder);
+        auto half = (remainder << 1) <=> unit;
+        if (half > 0 || (half == 0 && !(quotient % BigInt(2)).isZero())) {
+          quotient = quotient + BigInt(1);
+        }
+        return Number::spawn(quotient * unit);
+      }
 
-      return Number::spawn(
-        static_cast<double>(std::round(
-          num->getDouble() / nearest->getDouble()) * nearest->getDouble()));
+      int64_t value = num->getInt();
+      if (digits < -18) return Number::spawn(static_cast<int64_t>(0));
+
+      int64_t unit = 1;
+      for (int64_t i = 0; i < -digits; ++i) unit *= 10;
+      int64_t quotient = value / unit;
+      int64_t twiceRemainder = 2 * std::abs(value % unit);
+      if (twiceRemainder > unit ||
+          (twiceRemainder == unit && quotient % 2 != 0)) {
+        quotient += value < 0 ? -1 : 1;
+      }
+      return *Number::spawn(quotient) * Number(unit);
+    }
+
+    double value = num->getDouble();
+    // past 323 digits every double is already exact
+    if (!std::isfinite(value) || value == 0.0 || digits > 323) {
+      return Number::spawn(value);
     }
-    
-    const double scale = std::pow(10.0, decimals->getInt());
-    const long double value = num->getDouble();
-    return Number::spawn(static_cast<double>(std::round(
-      value * scale)) / scale);
+    if (digits < 0) {
+      double unit = std::pow(10.0, static_cast<double>(-digits));
+      return Number::spawn(std::nearbyint(value / unit) * unit);
+    }
+
+    std::array<char, 700> text;
+    char* end = std::to_chars(text.data(), text.data() + text.size(), value,
+                              std::chars_format::fixed,
+                              static_cast<int>(digits)).ptr;
+    double rounded = 0.0;
+    std::from_chars(text.data(), end, rounded);
+    return Number::spawn(rounded);
   }
 
   std::shared_ptr<Number> round(const std::shared_ptr<Bool>& num,
@@ -1414,8 +1229,8 @@ namespace BF {
   const std::shared_ptr<Set> set(const std::shared_ptr<String>& items) {
     std::shared_ptr<Set> result = Set::spawn();
 
-    for (Number i = Number(0); i < *(items->len()); ++i) {
-      result->add((*items)[i]);
+    for (size_t i = 0; i < items->length(); ++i) {
+      result->add(items->charAt(i));
     }
 
     return result;
@@ -1459,17 +1274,29 @@ namespace BF {
     return (!reverse? structure->keys() : reversed(structure->keys()));
   }
 
+  std::shared_ptr<SpilledList> sorted(
+    const std::shared_ptr<SpilledList>& structure,
+    const std::shared_ptr<Bool>& reverse = Bool::spawn(false)) {
+    auto result = SpilledList::spawn(structure, structure->limits());
+    result->sort(reverse);
+    return result;
+  }
+
   template<TIterable TType>
   std::shared_ptr<List> sorted(const std::shared_ptr<TType>& structure,
     const std::shared_ptr<Bool>& reverse = Bool::spawn(false)) {
     std::shared_ptr<List> result = list(structure);
-    if (!result->hasSingleType()) {
-      throw std::invalid_argument(
-        "Sorted not supported on structures with multiple types");
-    }
+    result->sort(reverse);
+    return result;
+  }
 
-    std::sort(result->begin(), result->end());
-    return (!reverse->toBool()? result : reversed(result));
+  template<TIterable TType, typename TKey>
+    requires std::invocable<TKey&, const std::shared_ptr<Object>&>
+  std::shared_ptr<List> sorted(const std::shared_ptr<TType>& structure,
+    TKey key, const std::shared_ptr<Bool>& reverse = Bool::spawn(false)) {
+    std::shared_ptr<List> result = list(structure);
+    result->sort(key, reverse);
+    return result;
   }
 
   std::shared_ptr<String> str() {
@@ -1477,6 +1304,9 @@ namespace BF {
   }
 
   std::shared_ptr<String> str(const std::shared_ptr<Object>& object) {
+    if (dynamic_cast<const String*>(object.get()) != nullptr) {
+      return std::static_pointer_cast<String>(object);
+    }
     return String::spawn(object->toString());
   }
 
@@ -1485,7 +1315,7 @@ namespace BF {
   }
 
   std::shared_ptr<String> str(const int& object) {
-    return String::spawn(std::to_string(object));
+    return String::spawn(NumberFormat::integerText(object));
   }
 
   std::shared_ptr<Number> sum(
@@ -1553,6 +1383,19 @@ namespace BF {
     return sum(numbers, Number::spawn(extra));
   }
 
+  // Lists of plain ints or floats and arrays are summed unboxed, floats
+  // pairwise
+  std::shared_ptr<Number> sum(const std::shared_ptr<List>& numbers,
+    const std::shared_ptr<Number>& extra = Number::spawn(0)) {
+    if (auto total = numbers->numericSum()) return extra + total;
+    return sum<List>(numbers, extra);
+  }
+
+  std::shared_ptr<Number> sum(const std::shared_ptr<Array>& numbers,
+    const std::shared_ptr<Number>& extra = Number::spawn(0)) {
+    return extra + numbers->sum();
+  }
+
   std::shared_ptr<Tuple> tuple() {
     return Tuple::spawn();
   }
@@ -1560,8 +1403,8 @@ namespace BF {
   const std::shared_ptr<Tuple> tuple(const std::shared_ptr<String>& items) {
     std::vector<std::shared_ptr<Object>> result;
 
-    for (Number i = Number(0); i < *(items->len()); ++i) {
-      result.push_back((*items)[i]);
+    for (size_t i = 0; i < items->length(); ++i) {
+      result.push_back(items->charAt(i));
     }
 
     return std::make_shared<Tuple>(result);
@@ -1569,12 +1412,114 @@ namespace BF {
 
   std::shared_ptr<Bool> in(const std::shared_ptr<String>& obj,
     const std::shared_ptr<String>& structure) {
-    for (Number i = Number(0); i < *(structure->len()); ++i) {
-      if ((*structure)[i] == obj) {
-        return Bool::spawn(true);
-      }
+    return Bool::spawn(structure->contains(*obj));
+  }
+
+  template<typename TType>
+  std::shared_ptr<Bool> in(const std::shared_ptr<TType>& obj,
+    const std::shared_ptr<String>& structure) {
+    auto* sub = dynamic_cast<const String*>(obj.get());
+    if (sub == nullptr) {
+      throw std::runtime_error("'in <string>' requires string as left operand, "
+        "not " + obj->type());
+    }
+    return Bool::spawn(structure->contains(*sub));
+  }
+
+  template<typename TType>
+  std::shared_ptr<Bool> in(const std::shared_ptr<TType>& obj,
+    const std::shared_ptr<List>& structure) {
+    return Bool::spawn(structure->contains(obj));
+  }
+
+  template<typename TType>
+  std::shared_ptr<Bool> in(const std::shared_ptr<TType>& obj,
+    const std::shared_ptr<Array>& structure) {
+    return Bool::spawn(structure->contains(obj));
+  }
+
+  template<typename TType>
+  std::shared_ptr<Bool> in(const std::shared_ptr<TType>& obj,
+    const std::shared_ptr<Set>& structure) {
+    return Bool::spawn(structure->exists(obj));
+  }
+
+  template<typename TType>
+  std::shared_ptr<Bool> in(const std::shared_ptr<TType>& obj,
+    const std::shared_ptr<Dictionary>& structure) {
+    return Bool::spawn(structure->contains(obj));
+  }
+
+  // 'x in range(...)' is compiled to this, membership is decided with
+  // arithmetic instead of materializing the range. The bounds are checked
+  // first, so an int too big for int64 is just out of range.
+  std::shared_ptr<Bool> inRange(const std::shared_ptr<Object>& obj,
+    const std::shared_ptr<Number>& start,
+    const std::shared_ptr<Number>& stop,
+    const std::shared_ptr<Number>& step = Number::spawn(1)) {
+    std::shared_ptr<Number> number = std::dynamic_pointer_cast<Number>(obj);
+    if (dynamic_cast<const Bool*>(obj.get()) != nullptr) {
+      number = Number::spawn(obj->toBool() ? 1 : 0);
+    }
+    if (number.get() == nullptr) return Bool::spawn(false);
+
+    if (number->isDouble()) {
+      double value = number->getDouble();
+      if (std::trunc(value) != value) return Bool::spawn(false);
+    }
+
+    if (!step->toBool()) {
+      throw std::runtime_error("range() arg 3 must not be zero");
+    }
+
+    bool ascending = step->compare(Number(0)) > 0;
+    bool inBounds = ascending
+      ? start->compare(*number) <= 0 && number->compare(*stop) < 0
+      : stop->compare(*number) < 0 && number->compare(*start) <= 0;
+    if (!inBounds) return Bool::spawn(false);
+
+    if (start->isBig() || stop->isBig() || step->isBig()) [[unlikely]] {
+      return Bool::spawn(!((number - start) % step)->toBool());
+    }
+
+    // the distance from start fits in 64 bits unsigned even when the
+    // range spans the whole int64 range
+    uint64_t target = static_cast<uint64_t>(number->getInt());
+    uint64_t startNum = static_cast<uint64_t>(start->getInt());
+    uint64_t stepNum = static_cast<uint64_t>(step->getInt());
+    uint64_t distance = ascending ? target - startNum : startNum - target;
+    return Bool::spawn(distance % (ascending ? stepNum : 0 - stepNum) == 0);
+  }
+
+  std::shared_ptr<Bool> inRange(const std::shared_ptr<Object>& obj,
+    const std::shared_ptr<Number>& stop) {
+    return inRange(obj, Number::spawn(0), stop);
+  }
+
+  // 'container[index] = value' is compiled to this, containers that store
+  // their elements unboxed convert the value in setItem()
+  template<typename TContainer, typename TIndex, typename TValue>
+  void setItem(const TContainer& container, const TIndex& index,
+    const TValue& value) {
+    if constexpr (requires { container->setItem(index, value); }) {
+      container->setItem(index, value);
+    } else {
+      (*container)[index] = value;
+    }
+  }
+
+  // 'x = x + value' is compiled to this, so a string accumulated in a loop
+  // is appended to in place instead of copied on every iteration, and so is
+  // a number no other name holds
+  template<typename TType, typename TValue>
+  void addAssign(std::shared_ptr<TType>& target, const TValue& value) {
+    if constexpr (std::is_same_v<TType, String> ||
+                  (std::is_same_v<TType, Number> &&
+                   requires { target += value; })) {
+      target += value;
+    } else {
+      target = target + value;
     }
-    return Bool::spawn(false);
   }
 
   template<TIterable TType>
@@ -1587,6 +1532,67 @@ namespace BF {
     return Bool::spawn(it != structure->end());
   }
 
+  // Records of a 'for a, b, ... in structure' loop
+  template<TIterable TType>
+  RecordCursor<TType> records(const std::shared_ptr<TType>& structure,
+                              size_t arity) {
+    return RecordCursor<TType>(structure, arity);
+  }
+
+  // [r[field] for r in structure] when arity is 0, otherwise the field-th
+  // name of [x for ..., x, ... in structure] unpacking arity names
+  template<TIterable TType>
+  std::shared_ptr<List> column(const std::shared_ptr<TType>& structure,
+                               size_t field, size_t arity = 0) {
+    auto result = List::spawn();
+    auto& elements = result->getElements();
+    if (arity == 0) {
+      const auto index = Number::spawn(static_cast<int64_t>(field));
+      for (const auto& record : *structure) {
+        auto* tuple = dynamic_cast<const Tuple*>(record.get());
+        if (tuple != nullptr && field < tuple->getElements().size()) {
+          elements.push_back(tuple->getElements()[field]);
+        } else {
+          elements.push_back((*record)[index]);
+        }
+      }
+      return result;
+    }
+
+    for (auto cursor = records(structure, arity); cursor.next();) {
+      elements.push_back(cursor.field(field));
+    }
+    return result;
+  }
+
+  std::shared_ptr<List> column(const std::shared_ptr<ColumnList>& structure,
+                               size_t field, size_t arity = 0) {
+    return structure->columnValues(field, arity);
+  }
+
+  // sum() of a column, see column()
+  template<TIterable TType>
+  std::shared_ptr<Number> columnSum(const std::shared_ptr<TType>& structure,
+                                    size_t field, size_t arity = 0) {
+    return sum(column(structure, field, arity));
+  }
+
+  // int, bool and float columns are summed where they are stored
+  std::shared_ptr<Number> columnSum(
+    const std::shared_ptr<ColumnList>& structure,
+    size_t field, size_t arity = 0) {
+    if (auto total = structure->columnSum(field, arity)) return total;
+    return sum(structure->columnValues(field, arity));
+  }
+
+  // string literals and sys.intern results are a single object in Python,
+  // here they share the intern table entry
+  std::shared_ptr<Bool> is(const std::shared_ptr<String>& first,
+    const std::shared_ptr<String>& second) {
+    return Bool::spawn(
+      first.get() == second.get() || first->sameInterned(*second));
+  }
+
   std::shared_ptr<Bool> is(const std::shared_ptr<Object>& first,
     const std::shared_ptr<Object>& second) {
     if (first->isNone()) return Bool::spawn(second->isNone());
@@ -1635,6 +1641,184 @@ namespace BF {
     const int&) {
     return Bool::spawn(false);
   }
+
+  // The array module, array.array(typecode, items) compiles to
+  // BF::array::array(typecode, items). The other functions are vectorized
+  // operations added to the module by this compiler, in the style of numpy:
+  // they take two arrays of the same length, or an array and a number that
+  // is applied to every element.
+  namespace array {
+    char typecodeOf(const std::shared_ptr<String>& typecode) {
+      if (typecode->length() != 1) {
+        throw std::runtime_error(
+          "array() argument 1 must be a unicode character, not str");
+      }
+      return (**typecode)[0];
+    }
+
+    std::shared_ptr<Array> array(const std::shared_ptr<String>& typecode) {
+      return Array::spawn(typecodeOf(typecode));
+    }
+
+    template<typename TItems>
+    std::shared_ptr<Array> array(const std::shared_ptr<String>& typecode,
+      const std::shared_ptr<TItems>& items) {
+      return Array::spawn(typecodeOf(typecode), items);
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> add(const TLeft& lhs, const TRight& rhs) {
+      return Array::arithmetic(Array::operand(lhs), Array::operand(rhs),
+                               NumericKernels::Add());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> subtract(const TLeft& lhs, const TRight& rhs) {
+      return Array::arithmetic(Array::operand(lhs), Array::operand(rhs),
+                               NumericKernels::Subtract());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> multiply(const TLeft& lhs, const TRight& rhs) {
+      return Array::arithmetic(Array::operand(lhs), Array::operand(rhs),
+                               NumericKernels::Multiply());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> divide(const TLeft& lhs, const TRight& rhs) {
+      return Array::divide(Array::operand(lhs), Array::operand(rhs));
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> less(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::less<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> less_equal(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::less_equal<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> greater(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::greater<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> greater_equal(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::greater_equal<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> equal(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::equal_to<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Array> not_equal(const TLeft& lhs, const TRight& rhs) {
+      return Array::mask(Array::operand(lhs), Array::operand(rhs),
+                         std::not_equal_to<>());
+    }
+
+    template<typename TLeft, typename TRight>
+    std::shared_ptr<Number> dot(const TLeft& lhs, const TRight& rhs) {
+      return Array::dot(Array::operand(lhs), Array::operand(rhs));
+    }
+
+    std::shared_ptr<Array> cumsum(const std::shared_ptr<Array>& values) {
+      return values->cumsum();
+    }
+
+    std::shared_ptr<Array> compress(const std::shared_ptr<Array>& mask,
+      const std::shared_ptr<Array>& values) {
+      return Array::compress(*mask, *values);
+    }
+  }
+
+  // The functions of the math module, math.gcd(a, b) compiles to
+  // BF::math::gcd(a, b)
+  namespace math {
+    std::shared_ptr<Number> integer(const std::shared_ptr<Number>& value) {
+      if (value->isDouble()) {
+        throw std::runtime_error(
+          "'float' object cannot be interpreted as an integer");
+      }
+      return value;
+    }
+
+    std::shared_ptr<Number> integer(const std::shared_ptr<Bool>& value) {
+      return Number::spawn(value->toBool() ? 1 : 0);
+    }
+
+    uint64_t magnitude(int64_t value) {
+      uint64_t bits = static_cast<uint64_t>(value);
+      return value < 0 ? 0 - bits : bits;
+    }
+
+    std::shared_ptr<Number> gcdOf(const Number& lhs, const Number& rhs) {
+      if (lhs.isBig() || rhs.isBig()) [[unlikely]] {
+        return Number::spawn(
+          IntegerMath::gcd(lhs.toBigInt(), rhs.toBigInt()));
+      }
+      uint64_t gcd = IntegerMath::gcd(magnitude(lhs.getInt()),
+                                      magnitude(rhs.getInt()));
+      if (gcd > static_cast<uint64_t>(INT64_MAX)) [[unlikely]] {
+        return Number::spawn(BigInt::fromUnsigned(gcd));
+      }
+      return Number::spawn(static_cast<int64_t>(gcd));
+    }
+
+    std::shared_ptr<Number> lcmOf(const Number& lhs, const Number& rhs) {
+      if (!lhs.toBool() || !rhs.toBool()) return Number::spawn(0);
+      std::shared_ptr<Number> gcd = gcdOf(lhs, rhs);
+      std::shared_ptr<Number> quotient =
+        abs(std::make_shared<Number>(lhs))->floorDivide(*gcd);
+      return *quotient * *abs(std::make_shared<Number>(rhs));
+    }
+
+    template<typename ... TArgs>
+    std::shared_ptr<Number> gcd(const TArgs& ... args) {
+      std::shared_ptr<Number> result = Number::spawn(0);
+      ((result = gcdOf(*result, *integer(args))), ...);
+      return result;
+    }
+
+    template<typename ... TArgs>
+    std::shared_ptr<Number> lcm(const TArgs& ... args) {
+      std::shared_ptr<Number> result = Number::spawn(1);
+      ((result = lcmOf(*result, *integer(args))), ...);
+      return result;
+    }
+
+    template<typename TType>
+    std::shared_ptr<Number> isqrt(const TType& value) {
+      std::shared_ptr<Number> number = integer(value);
+      if (number->isBig()) [[unlikely]] {
+        BigInt big = number->toBigInt();
+        if (big.isNegative()) {
+          throw std::invalid_argument("isqrt() argument must be nonnegative");
+        }
+        return Number::spawn(IntegerMath::isqrt(big));
+      }
+      if (number->getInt() < 0) {
+        throw std::invalid_argument("isqrt() argument must be nonnegative");
+      }
+      return Number::spawn(static_cast<int64_t>(
+        IntegerMath::isqrt(static_cast<uint64_t>(number->getInt()))));
+    }
+  }
+
+  // The functions of the sys module
+  namespace sys {
+    std::shared_ptr<String> intern(const std::shared_ptr<String>& string) {
+      return string->intern();
+    }
+  }
 };
 
 #endif  // BUILTIN_FUNCTIONS_HPP
\ No newline at end of file
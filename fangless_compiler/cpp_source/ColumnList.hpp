@@ -0,0 +1,512 @@
+#ifndef COLUMN_LIST_HPP
+#define COLUMN_LIST_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bool.hpp"
+#include "List.hpp"
+#include "Number.hpp"
+#include "NumericKernels.hpp"
+#include "Object.hpp"
+#include "RecordCursor.hpp"
+#include "Slice.hpp"
+#include "String.hpp"
+#include "Tuple.hpp"
+
+// One field of every record of a ColumnList, stored contiguously. The kind
+// is taken from the first value: ints and bools are kept as int64s, floats
+// as doubles and strings back to back in a single buffer. A value of any
+// other kind turns the column into boxed objects for good.
+class Column {
+ public:
+  enum class Kind { EMPTY, INT, BOOL, FLOAT, STR, OBJECT };
+
+ private:
+  Kind kind_ = Kind::EMPTY;
+  std::vector<int64_t> ints_;
+  std::vector<double> floats_;
+  // string i is text_[starts_[i], starts_[i] + lengths_[i]), a replaced
+  // string is appended and its old bytes are left unused
+  std::string text_;
+  std::vector<size_t> starts_;
+  std::vector<size_t> lengths_;
+  std::vector<std::shared_ptr<Object>> objects_;
+
+  static Kind kindOf(const Object& value) {
+    const std::string valueType = value.type();
+    if (valueType == "Bool") return Kind::BOOL;
+    if (valueType == "str") return Kind::STR;
+    if (const auto* number = dynamic_cast<const Number*>(&value)) {
+      if (number->isBig()) return Kind::OBJECT;
+      return number->isDouble() ? Kind::FLOAT : Kind::INT;
+    }
+    return Kind::OBJECT;
+  }
+
+  void box() {
+    std::vector<std::shared_ptr<Object>> boxed;
+    boxed.reserve(size());
+    for (size_t row = 0; row < size(); ++row) boxed.push_back(at(row));
+
+    clear();
+    objects_ = std::move(boxed);
+    kind_ = Kind::OBJECT;
+  }
+
+  void store(const std::shared_ptr<Object>& value, size_t row) {
+    const bool append = row == size();
+    switch (kind_) {
+      case Kind::INT:
+      case Kind::BOOL: {
+        const int64_t number = kind_ == Kind::BOOL
+          ? (value->toBool() ? 1 : 0)
+          : static_cast<const Number&>(*value).getInt();
+        if (append) ints_.push_back(number); else ints_[row] = number;
+        break;
+      }
+      case Kind::FLOAT: {
+        const double number = static_cast<const Number&>(*value).getDouble();
+        if (append) floats_.push_back(number); else floats_[row] = number;
+        break;
+      }
+      case Kind::STR: {
+        const std::string bytes = *static_cast<const String&>(*value);
+        if (append) {
+          starts_.push_back(text_.size());
+          lengths_.push_back(bytes.size());
+        } else {
+          starts_[row] = text_.size();
+          lengths_[row] = bytes.size();
+        }
+        text_.append(bytes);
+        break;
+      }
+      default:
+        if (append) objects_.push_back(value); else objects_[row] = value;
+    }
+  }
+
+ public:
+  Kind kind() const { return kind_; }
+
+  size_t size() const {
+    switch (kind_) {
+      case Kind::INT:
+      case Kind::BOOL: return ints_.size();
+      case Kind::FLOAT: return floats_.size();
+      case Kind::STR: return starts_.size();
+      default: return objects_.size();
+    }
+  }
+
+  // Field of record row, the value a Tuple of the record would hold
+  std::shared_ptr<Object> at(size_t row) const {
+    switch (kind_) {
+      case Kind::INT: return Number::spawn(ints_[row]);
+      case Kind::BOOL: return Bool::spawn(ints_[row] != 0);
+      case Kind::FLOAT: return Number::spawn(floats_[row]);
+      case Kind::STR: return String::spawn(std::string(text(row)));
+      default: return objects_[row];
+    }
+  }
+
+  std::string_view text(size_t row) const {
+    return std::string_view(text_).substr(starts_[row], lengths_[row]);
+  }
+
+  const std::vector<int64_t>& ints() const { return ints_; }
+
+  const std::vector<double>& floats() const { return floats_; }
+
+  // Sets field row, row == size() adds it
+  void set(size_t row, const std::shared_ptr<Object>& value) {
+    const Kind kind = kindOf(*value);
+    if (kind_ == Kind::EMPTY) {
+      kind_ = kind;
+    } else if (kind != kind_ && kind_ != Kind::OBJECT) {
+      box();
+    }
+    store(value, row);
+  }
+
+  void pop() {
+    switch (kind_) {
+      case Kind::INT:
+      case Kind::BOOL: ints_.pop_back(); break;
+      case Kind::FLOAT: floats_.pop_back(); break;
+      case Kind::STR:
+        starts_.pop_back();
+        lengths_.pop_back();
+        break;
+      default: objects_.pop_back();
+    }
+  }
+
+  void clear() {
+    ints_.clear();
+    floats_.clear();
+    text_.clear();
+    starts_.clear();
+    lengths_.clear();
+    objects_.clear();
+    kind_ = Kind::EMPTY;
+  }
+};
+
+// List of tuples that all have the same number of fields, stored as a
+// struct of arrays: field i of every record lives in column i. Loops that
+// unpack the records and scans of one field read the columns in place, a
+// Tuple is only built when a record is taken as a whole.
+class ColumnList : public Object {
+  size_t arity_ = 0;
+  size_t size_ = 0;
+  std::vector<Column> columns_;
+
+  size_t normalize(int64_t index) const {
+    if (index < 0) index += static_cast<int64_t>(size_);
+    if (index < 0 || static_cast<size_t>(index) >= size_) {
+      throw std::out_of_range("list index out of range");
+    }
+    return static_cast<size_t>(index);
+  }
+
+  // The fields of a record, which must be a tuple of arity_ fields. The
+  // first record sets the arity
+  const std::vector<std::shared_ptr<Object>>& fieldsOf(
+      const std::shared_ptr<Object>& record) {
+    const auto* tuple = dynamic_cast<const Tuple*>(record.get());
+    if (tuple == nullptr) {
+      throw std::runtime_error("column_list() holds tuples, not " +
+                               record->type());
+    }
+
+    const auto& fields = tuple->getElements();
+    if (size_ == 0) {
+      if (fields.empty()) {
+        throw std::runtime_error("column_list() can not hold empty tuples");
+      }
+      arity_ = fields.size();
+      columns_.assign(arity_, Column());
+    }
+    if (fields.size() != arity_) {
+      throw std::runtime_error(
+        "column_list() holds tuples of " + std::to_string(arity_) +
+        " fields, not " + std::to_string(fields.size()));
+    }
+    return fields;
+  }
+
+  // Checks that unpacking a record into arity names or reading its field
+  // index is valid, arity 0 stands for indexing
+  void checkField(size_t field, size_t arity) const {
+    if (size_ == 0) return;
+    if (arity != 0) {
+      RecordFields::checkArity(arity, arity_);
+    } else if (field >= arity_) {
+      throw std::out_of_range("tuple index out of range");
+    }
+  }
+
+ public:
+  class Iterator {
+    const ColumnList* list_ = nullptr;
+    size_t position_ = 0;
+    std::shared_ptr<Object> current_;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::shared_ptr<Object>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    Iterator() = default;
+    Iterator(const ColumnList* list, size_t position)
+      : list_(list), position_(position) {}
+
+    reference operator*() {
+      if (current_.get() == nullptr) current_ = list_->record(position_);
+      return current_;
+    }
+
+    pointer operator->() { return &operator*(); }
+
+    Iterator& operator++() {
+      ++position_;
+      current_.reset();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return position_ == other.position_;
+    }
+  };
+
+  ColumnList() = default;
+
+  template <typename TIterator>
+  ColumnList(TIterator begin, TIterator end) {
+    for (; begin != end; ++begin) append(*begin);
+  }
+
+  static std::shared_ptr<ColumnList> spawn() {
+    return std::make_shared<ColumnList>();
+  }
+
+  template <typename TType>
+  static std::shared_ptr<ColumnList> spawn(
+      const std::shared_ptr<TType>& items) {
+    return std::make_shared<ColumnList>(items->begin(), items->end());
+  }
+
+  size_t arity() const { return arity_; }
+
+  size_t size() const { return size_; }
+
+  const Column& column(size_t field) const { return columns_[field]; }
+
+  // Field index of record row, read from its column
+  std::shared_ptr<Object> field(size_t row, size_t index) const {
+    return columns_[index].at(row);
+  }
+
+  // Builds the Tuple of record row
+  std::shared_ptr<Tuple> record(size_t row) const {
+    std::vector<std::shared_ptr<Object>> fields;
+    fields.reserve(arity_);
+    for (const auto& column : columns_) fields.push_back(column.at(row));
+    return std::make_shared<Tuple>(fields);
+  }
+
+  std::string type() const override { return "list"; }
+
+  std::string toString() const override {
+    std::string result = "[";
+    for (size_t row = 0; row < size_; ++row) {
+      if (row > 0) result += ", ";
+      result += record(row)->toString();
+    }
+    return result + "]";
+  }
+
+  bool equals(const Object& other) const override {
+    if (auto* columns = dynamic_cast<const ColumnList*>(&other)) {
+      if (columns->size_ != size_) return false;
+      for (size_t row = 0; row < size_; ++row) {
+        if (!record(row)->equals(*columns->record(row))) return false;
+      }
+      return true;
+    }
+
+    if (auto* list = dynamic_cast<const List*>(&other)) {
+      const auto& elements = list->getElements();
+      if (elements.size() != size_) return false;
+      for (size_t row = 0; row < size_; ++row) {
+        if (!record(row)->equals(*elements[row])) return false;
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+  friend bool operator==(const std::shared_ptr<ColumnList>& lhs,
+                         const std::shared_ptr<ColumnList>& rhs) {
+    return lhs->equals(*rhs);
+  }
+
+  friend bool operator==(const std::shared_ptr<ColumnList>& lhs,
+                         const std::shared_ptr<List>& rhs) {
+    return lhs->equals(*rhs);
+  }
+
+  size_t hash() const override {
+    throw std::runtime_error("unhashable type: 'list'");
+  }
+
+  bool toBool() const override { return size_ > 0; }
+
+  bool isInstance(const std::string& type) const override {
+    return type == "list" || type == "object";
+  }
+
+  std::shared_ptr<Object> getAttr(const std::string& name) const override {
+    throw std::runtime_error("'list' object has no attribute '" + name + "'");
+  }
+
+  void setAttr(const std::string&,
+               std::shared_ptr<Object>) override {
+    throw std::runtime_error("'list' object has no attributes");
+  }
+
+  void append(const std::shared_ptr<Object>& record) {
+    const auto& fields = fieldsOf(record);
+    for (size_t field = 0; field < arity_; ++field) {
+      columns_[field].set(size_, fields[field]);
+    }
+    ++size_;
+  }
+
+  template <typename TType>
+  void extend(const std::shared_ptr<TType>& items) {
+    for (const auto& item : *items) append(item);
+  }
+
+  void setItem(const std::shared_ptr<Object>& index,
+               const std::shared_ptr<Object>& record) {
+    const size_t row = normalize(Number::indexOf(
+      *index, "list indices must be integers or slices, not "));
+    const auto& fields = fieldsOf(record);
+    for (size_t field = 0; field < arity_; ++field) {
+      columns_[field].set(row, fields[field]);
+    }
+  }
+
+  std::shared_ptr<Object> pop() {
+    if (size_ == 0) throw std::out_of_range("pop from empty list");
+    auto last = record(size_ - 1);
+    for (auto& column : columns_) column.pop();
+    --size_;
+    return last;
+  }
+
+  void clear() {
+    columns_.clear();
+    arity_ = 0;
+    size_ = 0;
+  }
+
+  std::shared_ptr<Number> len() const {
+    return Number::spawn(static_cast<int64_t>(size_));
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, size_); }
+
+  std::shared_ptr<Object> operator[](const Number& index) const {
+    return record(normalize(index.getInt()));
+  }
+
+  std::shared_ptr<Object> operator[](
+      const std::shared_ptr<Number>& index) const {
+    return record(normalize(index->getInt()));
+  }
+
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return record(normalize(Number::indexOf(
+      *index, "list indices must be integers or slices, not ")));
+  }
+
+  std::shared_ptr<ColumnList> operator[](const Slice& slice) const {
+    int64_t size = static_cast<int64_t>(size_);
+    int64_t step = slice.step == 0 ?
+      throw std::invalid_argument("Step cannot be zero") : slice.step;
+    int64_t start = slice.start == INT_MAX ?
+      (step > 0 ? 0 : size - 1) : slice.start;
+    int64_t end = slice.end == INT_MAX ? (step > 0 ? size : -1) : slice.end;
+
+    if (slice.start != INT_MAX && start < 0) start += size;
+    if (slice.end != INT_MAX && end < 0) end += size;
+
+    auto result = ColumnList::spawn();
+    if (step > 0) {
+      start = std::clamp<int64_t>(start, 0, size);
+      end = std::clamp<int64_t>(end, 0, size);
+      for (int64_t i = start; i < end; i += step) result->append(record(i));
+    } else {
+      start = std::clamp<int64_t>(start, -1, size - 1);
+      end = std::clamp<int64_t>(end, -1, size - 1);
+      for (int64_t i = start; i > end; i += step) result->append(record(i));
+    }
+
+    return result;
+  }
+
+  std::shared_ptr<ColumnList> slice(const Slice& slice) const {
+    return this->operator[](slice);
+  }
+
+  std::shared_ptr<ColumnList> slice(std::shared_ptr<Slice> slice) const {
+    return this->operator[](*slice);
+  }
+
+  // [r[field] for r in rows] or, unpacking arity names, the field-th one.
+  // The values are read straight from the column
+  std::shared_ptr<List> columnValues(size_t field, size_t arity) const {
+    checkField(field, arity);
+    auto result = std::make_shared<List>();
+    if (size_ == 0) return result;
+
+    auto& elements = result->getElements();
+    elements.reserve(size_);
+    const Column& values = columns_[field];
+    for (size_t row = 0; row < size_; ++row) {
+      elements.push_back(values.at(row));
+    }
+    return result;
+  }
+
+  // sum() of a column of ints, bools or floats, run over the contiguous
+  // values. nullptr for columns of any other kind
+  std::shared_ptr<Number> columnSum(size_t field, size_t arity) const {
+    checkField(field, arity);
+    if (size_ == 0) return Number::spawn(int64_t{0});
+
+    const Column& values = columns_[field];
+    switch (values.kind()) {
+      case Column::Kind::INT:
+      case Column::Kind::BOOL:
+        return Number::fromInt128(
+          NumericKernels::intSum(values.ints().data(), size_));
+      case Column::Kind::FLOAT:
+        return Number::spawn(
+          NumericKernels::floatSum(values.floats().data(), size_));
+      default:
+        return nullptr;
+    }
+  }
+};
+
+// The fields of a 'for a, b, ... in columns' loop are read from the
+// columns, the records are never built as tuples. As for a list, the size is
+// read on every step
+template <>
+class RecordCursor<ColumnList> {
+  std::shared_ptr<const ColumnList> list_;
+  size_t row_ = 0;
+  bool started_ = false;
+
+ public:
+  RecordCursor(std::shared_ptr<const ColumnList> list, size_t arity)
+      : list_(std::move(list)) {
+    if (list_->size() > 0) RecordFields::checkArity(arity, list_->arity());
+  }
+
+  bool next() {
+    if (started_) ++row_;
+    started_ = true;
+    return row_ < list_->size();
+  }
+
+  std::shared_ptr<Object> field(size_t index) const {
+    return list_->field(row_, index);
+  }
+};
+
+#endif  // COLUMN_LIST_HPP
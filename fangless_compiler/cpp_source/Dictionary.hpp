@@ -162,9 +162,8 @@ class Dictionary : public Object {
   }
 
   void set(std::shared_ptr<Object> key, std::shared_ptr<Object> value) {
-    if (!key->hash()) {
-      throw std::runtime_error("unhashable type: '" + key->type() + "'");
-    }
+    // hash() throws for the unhashable types, 0 is a valid hash
+    key->hash();
     elements_[key] = value;
   }
 
@@ -319,6 +318,11 @@ class Dictionary : public Object {
     return it->second;
   }
 
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& key) const override {
+    return (*this)[key];
+  }
+
   std::shared_ptr<Dictionary> operator|(const Dictionary& other) const {
     auto result = std::make_shared<Dictionary>(*this);
     for (const auto& [key, value] : other.elements_) {
@@ -334,6 +338,14 @@ class Dictionary : public Object {
     return *this;
   }
 
+  // Dictionaries are mutable, x |= y updates the dictionary every name
+  // bound to it sees
+  friend std::shared_ptr<Dictionary>& operator|=(
+    std::shared_ptr<Dictionary>& lhs, const std::shared_ptr<Dictionary>& rhs) {
+    *lhs |= *rhs;
+    return lhs;
+  }
+
   Dictionary(const Dictionary& other) : elements_(other.elements_) {}
 
   Dictionary& operator=(const Dictionary& other) {
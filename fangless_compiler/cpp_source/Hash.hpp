@@ -0,0 +1,116 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "BigInt.hpp"
+
+// The hashes Python gives its immutable builtins. A number hashes to its
+// value mod the prime 2^61 - 1, so 1, 1.0 and True hash alike just as they
+// compare equal. A tuple mixes its element hashes in order with the xxHash
+// rounds CPython uses, so (a, b) and (b, a) differ and (x, x) is not 0.
+// These hashes back hash() and the membership index of List. Dictionary
+// and Set are ordered trees that never hash their keys, they find 1, 1.0
+// and True as one key through the ordering of Object.
+class Hash {
+ public:
+  static constexpr int MODULUS_BITS = 61;
+  static constexpr uint64_t MODULUS = (uint64_t{1} << MODULUS_BITS) - 1;
+  static constexpr int64_t INFINITY_HASH = 314159;
+
+  // No hash is -1, so immutable objects cache theirs with it as the
+  // "not computed yet" mark
+  static constexpr size_t UNSET = static_cast<size_t>(-1);
+
+  static size_t text(std::string_view value) {
+    size_t hash = std::hash<std::string_view>{}(value);
+    return hash == UNSET ? UNSET - 1 : hash;
+  }
+
+  static int64_t integer(int64_t value) {
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                   : static_cast<uint64_t>(value);
+    return signedHash(magnitude % MODULUS, value < 0);
+  }
+
+  // Each 32 bit limb shifts the residue left, which mod 2^61 - 1 is a
+  // rotation of its 61 bits
+  static int64_t big(const BigInt& value) {
+    const BigInt::Magnitude& limbs = value.magnitude();
+    uint64_t residue = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+      residue = rotate(residue, BigInt::LIMB_BITS) + limbs[i];
+      if (residue >= MODULUS) residue -= MODULUS;
+    }
+    return signedHash(residue, value.isNegative());
+  }
+
+  // The exact value m * 2^e of a finite float, reduced 28 bits of the
+  // mantissa at a time
+  static int64_t floating(double value) {
+    if (std::isnan(value)) return 0;
+    if (std::isinf(value)) return value > 0 ? INFINITY_HASH : -INFINITY_HASH;
+
+    int exponent = 0;
+    double mantissa = std::frexp(std::fabs(value), &exponent);
+    uint64_t residue = 0;
+    while (mantissa != 0.0) {
+      residue = rotate(residue, 28);
+      mantissa *= 268435456.0;
+      exponent -= 28;
+      const double digits = std::floor(mantissa);
+      mantissa -= digits;
+      residue += static_cast<uint64_t>(digits);
+      if (residue >= MODULUS) residue -= MODULUS;
+    }
+
+    // 2^e mod 2^61 - 1 repeats with period 61
+    exponent %= MODULUS_BITS;
+    if (exponent < 0) exponent += MODULUS_BITS;
+    return signedHash(rotate(residue, exponent), value < 0);
+  }
+
+  // Accumulates the hashes of a tuple's elements, in order
+  class Combiner {
+   public:
+    void add(size_t hash) {
+      accumulator_ += static_cast<uint64_t>(hash) * PRIME_2;
+      accumulator_ = std::rotl(accumulator_, 31);
+      accumulator_ *= PRIME_1;
+    }
+
+    size_t finish(size_t length) const {
+      uint64_t result = accumulator_ + (length ^ (PRIME_5 ^ 3527539ULL));
+      if (result == static_cast<uint64_t>(-1)) return 1546275796;
+      return static_cast<size_t>(result);
+    }
+
+   private:
+    static constexpr uint64_t PRIME_1 = 11400714785074694791ULL;
+    static constexpr uint64_t PRIME_2 = 14029467366897019727ULL;
+    static constexpr uint64_t PRIME_5 = 2870177450012600261ULL;
+
+    uint64_t accumulator_ = PRIME_5;
+  };
+
+ private:
+  // value * 2^shift mod 2^61 - 1, for value < 2^61 - 1 and shift < 61
+  static uint64_t rotate(uint64_t value, int shift) {
+    if (shift == 0) return value;
+    return ((value << shift) & MODULUS) | (value >> (MODULUS_BITS - shift));
+  }
+
+  // -1 is the error return of CPython's hash functions, so no hash is -1
+  static int64_t signedHash(uint64_t residue, bool negative) {
+    int64_t hash = static_cast<int64_t>(residue);
+    if (negative) hash = -hash;
+    return hash == -1 ? -2 : hash;
+  }
+};
+
+#endif  // HASH_HPP
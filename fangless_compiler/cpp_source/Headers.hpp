@@ -5,13 +5,24 @@
 #include <cmath>
 #include <cstdlib>
 
+#include "Array.hpp"
+#include "BigInt.hpp"
 #include "Bool.hpp"
 #include "Dictionary.hpp"
 #include "List.hpp"
 #include "None.hpp"
 #include "Number.hpp"
+#include "NumberFormat.hpp"
+#include "NumberParse.hpp"
+#include "RecordCursor.hpp"
 #include "Set.hpp"
+#include "SpilledList.hpp"
 #include "String.hpp"
+#include "StringAscii.hpp"
+#include "StringFormat.hpp"
+#include "StringUtf8.hpp"
+#include "StringSearch.hpp"
 #include "Tuple.hpp"
+#include "ColumnList.hpp"
 #include "BuiltinFunctions.hpp"
 #include "Function.hpp"
\ No newline at end of file
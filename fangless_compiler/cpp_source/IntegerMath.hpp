@@ -0,0 +1,305 @@
+#ifndef INTEGER_MATH_HPP
+#define INTEGER_MATH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "BigInt.hpp"
+
+// Exact integer kernels behind pow(b, e, m), math.gcd, math.lcm and
+// math.isqrt. Each works on 64 bit magnitudes first and has a BigInt
+// version for the operands that do not fit.
+class IntegerMath {
+ public:
+  // Stein's binary gcd, shifts and subtractions instead of divisions
+  static uint64_t gcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+    do {
+      b >>= std::countr_zero(b);
+      if (a > b) std::swap(a, b);
+      b -= a;
+    } while (b != 0);
+    return a << shift;
+  }
+
+  // Remainders shrink big operands until both fit in 64 bits, the binary
+  // gcd finishes from there
+  static BigInt gcd(BigInt a, BigInt b) {
+    a = a.abs();
+    b = b.abs();
+    int64_t smallA = 0;
+    int64_t smallB = 0;
+    while (!(a.toInt64(smallA) && b.toInt64(smallB))) {
+      if (b.isZero()) return a;
+      a = a % b;
+      std::swap(a, b);
+    }
+    return BigInt(static_cast<int64_t>(
+      gcd(static_cast<uint64_t>(smallA), static_cast<uint64_t>(smallB))));
+  }
+
+  // floor(sqrt(n)), the double estimate is only off by one near 2^64 and
+  // is corrected with divisions that cannot overflow
+  static uint64_t isqrt(uint64_t n) {
+    uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (root > 0 && root > n / root) --root;
+    while (root + 1 <= n / (root + 1)) ++root;
+    return root;
+  }
+
+  // Newton's iteration from a power of two above the root, it decreases
+  // until it reaches floor(sqrt(n))
+  static BigInt isqrt(const BigInt& n) {
+    if (n.isZero()) return n;
+    BigInt root = BigInt(1) << ((n.bitLength() + 1) / 2);
+    while (true) {
+      BigInt next = (root + n / root) >> 1;
+      if (!(next < root)) return root;
+      root = std::move(next);
+    }
+  }
+
+  // base^exponent mod modulus with base < modulus. Odd moduli use
+  // Montgomery multiplication, even ones 128 bit remainders.
+  static uint64_t powMod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    if (modulus == 1) return 0;
+    if (modulus % 2 == 0) {
+      uint64_t result = 1;
+      for (int bit = std::bit_width(exponent) - 1; bit >= 0; --bit) {
+        result = mulMod(result, result, modulus);
+        if ((exponent >> bit) & 1) result = mulMod(result, base, modulus);
+      }
+      return result;
+    }
+
+    Montgomery field(modulus);
+    uint64_t result = field.enter(1);
+    uint64_t factor = field.enter(base);
+    for (int bit = std::bit_width(exponent) - 1; bit >= 0; --bit) {
+      result = field.multiply(result, result);
+      if ((exponent >> bit) & 1) result = field.multiply(result, factor);
+    }
+    return field.leave(result);
+  }
+
+  // base^exponent mod modulus with 0 <= base < modulus. Odd moduli use
+  // Montgomery multiplication limb by limb in reused buffers, even ones
+  // Barrett's reduction with a precomputed reciprocal
+  static BigInt powMod(const BigInt& base, const BigInt& exponent,
+                       const BigInt& modulus) {
+    if (modulus == BigInt(1)) return BigInt();
+    if (!modulus.testBit(0)) {
+      Barrett field(modulus);
+      BigInt result(1);
+      for (size_t bit = exponent.bitLength(); bit-- > 0;) {
+        result = field.reduce(result * result);
+        if (exponent.testBit(bit)) result = field.reduce(result * base);
+      }
+      return result;
+    }
+
+    WideMontgomery field(modulus);
+    BigInt::Magnitude result = field.enter(BigInt(1));
+    BigInt::Magnitude factor = field.enter(base);
+    BigInt::Magnitude product(result.size());
+    for (size_t bit = exponent.bitLength(); bit-- > 0;) {
+      field.multiply(result.data(), result.data(), product.data());
+      std::swap(result, product);
+      if (exponent.testBit(bit)) {
+        field.multiply(result.data(), factor.data(), product.data());
+        std::swap(result, product);
+      }
+    }
+    return field.leave(result);
+  }
+
+  // x with a * x = 1 mod modulus, by the extended Euclidean algorithm
+  static BigInt inverse(const BigInt& value, const BigInt& modulus) {
+    BigInt previousRemainder = modulus;
+    BigInt remainder = value % modulus;
+    BigInt previousCoefficient;
+    BigInt coefficient(1);
+    while (!remainder.isZero()) {
+      BigInt quotient = previousRemainder / remainder;
+      previousRemainder = previousRemainder - quotient * remainder;
+      std::swap(previousRemainder, remainder);
+      previousCoefficient = previousCoefficient - quotient * coefficient;
+      std::swap(previousCoefficient, coefficient);
+    }
+    if (!(previousRemainder == BigInt(1))) {
+      throw std::invalid_argument(
+        "base is not invertible for the given modulus");
+    }
+    return previousCoefficient % modulus;
+  }
+
+ private:
+  static uint64_t mulMod(uint64_t a, uint64_t b, uint64_t modulus) {
+    return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b %
+                                 modulus);
+  }
+
+  // Numbers mod an odd m kept as x * 2^64 mod m, where a product is
+  // reduced with two multiplications and a shift
+  class Montgomery {
+   public:
+    explicit Montgomery(uint64_t modulus) : modulus_(modulus) {
+      // Newton's iteration doubles the correct low bits of m^-1 each step
+      inverse_ = modulus;
+      for (int i = 0; i < 5; ++i) inverse_ *= 2 - modulus * inverse_;
+      uint64_t r = (0 - modulus) % modulus;
+      rSquared_ = mulMod(r, r, modulus);
+    }
+
+    uint64_t enter(uint64_t value) const {
+      return reduce(static_cast<unsigned __int128>(value) * rSquared_);
+    }
+
+    uint64_t leave(uint64_t value) const { return reduce(value); }
+
+    uint64_t multiply(uint64_t a, uint64_t b) const {
+      return reduce(static_cast<unsigned __int128>(a) * b);
+    }
+
+   private:
+    uint64_t modulus_;
+    uint64_t inverse_;
+    uint64_t rSquared_;
+
+    // t / 2^64 mod m: q * m has the same low half as t, so only the high
+    // halves are subtracted
+    uint64_t reduce(unsigned __int128 t) const {
+      uint64_t q = static_cast<uint64_t>(t) * inverse_;
+      uint64_t high = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(q) * modulus_) >> 64);
+      uint64_t tHigh = static_cast<uint64_t>(t >> 64);
+      return tHigh >= high ? tHigh - high : tHigh - high + modulus_;
+    }
+  };
+
+  // Montgomery form for odd moduli of n limbs, x * 2^(32n) mod m. Each
+  // product is reduced while it is accumulated, one limb per row (CIOS)
+  class WideMontgomery {
+   public:
+    using Limb = BigInt::Limb;
+    using Wide = BigInt::Wide;
+
+    explicit WideMontgomery(const BigInt& modulus)
+        : modulus_(modulus.magnitude()),
+          size_(modulus_.size()),
+          row_(size_ + 2) {
+      Limb inverse = modulus_[0];
+      for (int i = 0; i < 4; ++i) inverse *= 2 - modulus_[0] * inverse;
+      negatedInverse_ = 0 - inverse;
+      BigInt r = BigInt(1) << (2 * BigInt::LIMB_BITS * size_);
+      rSquared_ = padded(r % modulus);
+    }
+
+    BigInt::Magnitude enter(const BigInt& value) const {
+      BigInt::Magnitude result(size_);
+      multiply(padded(value).data(), rSquared_.data(), result.data());
+      return result;
+    }
+
+    BigInt leave(const BigInt::Magnitude& value) const {
+      BigInt::Magnitude one(size_);
+      one[0] = 1;
+      BigInt::Magnitude result(size_);
+      multiply(value.data(), one.data(), result.data());
+      return BigInt::fromMagnitude(std::move(result));
+    }
+
+    // out = a * b / 2^(32n) mod m, out may not alias a or b
+    void multiply(const Limb* a, const Limb* b, Limb* out) const {
+      Limb* t = row_.data();
+      std::fill(row_.begin(), row_.end(), 0);
+      for (size_t i = 0; i < size_; ++i) {
+        Wide carry = 0;
+        for (size_t j = 0; j < size_; ++j) {
+          carry += static_cast<Wide>(a[j]) * b[i] + t[j];
+          t[j] = static_cast<Limb>(carry);
+          carry >>= BigInt::LIMB_BITS;
+        }
+        carry += t[size_];
+        t[size_] = static_cast<Limb>(carry);
+        t[size_ + 1] = static_cast<Limb>(carry >> BigInt::LIMB_BITS);
+
+        // adding q * m clears the lowest limb, which is shifted out
+        Limb q = t[0] * negatedInverse_;
+        carry = (static_cast<Wide>(q) * modulus_[0] + t[0]) >>
+                BigInt::LIMB_BITS;
+        for (size_t j = 1; j < size_; ++j) {
+          carry += static_cast<Wide>(q) * modulus_[j] + t[j];
+          t[j - 1] = static_cast<Limb>(carry);
+          carry >>= BigInt::LIMB_BITS;
+        }
+        carry += t[size_];
+        t[size_ - 1] = static_cast<Limb>(carry);
+        t[size_] = t[size_ + 1] + static_cast<Limb>(carry >> BigInt::LIMB_BITS);
+      }
+
+      // t < 2m, one subtraction brings it below m
+      if (t[size_] == 0 && belowModulus(t)) {
+        std::copy(t, t + size_, out);
+        return;
+      }
+      Wide borrow = 0;
+      for (size_t j = 0; j < size_; ++j) {
+        Wide difference = static_cast<Wide>(t[j]) - modulus_[j] - borrow;
+        out[j] = static_cast<Limb>(difference);
+        borrow = (difference >> BigInt::LIMB_BITS) & 1;
+      }
+    }
+
+   private:
+    BigInt::Magnitude modulus_;
+    size_t size_;
+    Limb negatedInverse_;
+    BigInt::Magnitude rSquared_;
+    mutable BigInt::Magnitude row_;
+
+    bool belowModulus(const Limb* value) const {
+      for (size_t j = size_; j-- > 0;) {
+        if (value[j] != modulus_[j]) return value[j] < modulus_[j];
+      }
+      return false;
+    }
+
+    BigInt::Magnitude padded(const BigInt& value) const {
+      BigInt::Magnitude limbs = value.magnitude();
+      limbs.resize(size_);
+      return limbs;
+    }
+  };
+
+  // Reduces x < m^2 with mu = floor(4^k / m), where m has k bits: the
+  // quotient estimate (x * mu) >> 2k is at most two below the real one
+  class Barrett {
+   public:
+    explicit Barrett(const BigInt& modulus)
+        : modulus_(modulus),
+          shift_(2 * modulus.bitLength()),
+          reciprocal_((BigInt(1) << shift_) / modulus) {}
+
+    BigInt reduce(const BigInt& value) const {
+      BigInt quotient = (value * reciprocal_) >> shift_;
+      BigInt rest = value - quotient * modulus_;
+      while (!(rest < modulus_)) rest = rest - modulus_;
+      return rest;
+    }
+
+   private:
+    BigInt modulus_;
+    uint64_t shift_;
+    BigInt reciprocal_;
+  };
+};
+
+#endif  // INTEGER_MATH_HPP
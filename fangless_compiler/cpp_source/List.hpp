@@ -3,22 +3,434 @@
 
 #include <algorithm>
 #include <climits>
+#include <concepts>
+#include <iterator>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "Iterable.hpp"
 #include "Number.hpp"
+#include "NumericKernels.hpp"
 #include "Object.hpp"
 #include "Slice.hpp"
+#include "SortKernels.hpp"
 #include "Tuple.hpp"
 
 using std::views::iota;
 
+// Reads the text of a String into text, false for other objects. String.hpp
+// defines it, strings need the complete List.
+inline bool textOf(const Object& object, std::string_view& text);
+
 class List : public Object {
   std::vector<std::shared_ptr<Object>> elements_;
 
+  // Hidden hash index (element hash -> ascending positions) used by the
+  // membership queries. It is built lazily once a large list has been
+  // scanned repeatedly, kept up to date by append/pop and dropped by any
+  // other mutation.
+  static constexpr size_t INDEX_MIN_SIZE = 16;
+  static constexpr size_t INDEX_SCAN_THRESHOLD = 4;
+
+  mutable std::unordered_map<size_t, std::vector<size_t>> index_;
+  mutable bool indexed_ = false;
+  mutable size_t scans_ = 0;
+
+  // Only types whose hash agrees exactly with equals() can be indexed.
+  // Floats are left out since they compare with a tolerance, and with them
+  // any tuple holding one.
+  static bool isIndexable(const Object& object) {
+    const std::string objectType = object.type();
+    if (objectType == "tuple") {
+      const auto& tuple = static_cast<const Tuple&>(object);
+      return std::all_of(tuple.begin(), tuple.end(), [](const auto& element) {
+        return isIndexable(*element);
+      });
+    }
+    return objectType == "str" || objectType == "int" ||
+           objectType == "Bool" || objectType == "NoneType";
+  }
+
+  void invalidateCaches() {
+    index_.clear();
+    indexed_ = false;
+    scans_ = 0;
+  }
+
+  bool buildIndex() const {
+    for (const auto& element : elements_) {
+      if (!isIndexable(*element)) return false;
+    }
+
+    index_.clear();
+    index_.reserve(elements_.size());
+    for (size_t i = 0; i < elements_.size(); ++i) {
+      index_[elements_[i]->hash()].push_back(i);
+    }
+    indexed_ = true;
+    return true;
+  }
+
+  // Returns the positions whose hash matches object (nullptr if none).
+  // useIndex is left false when the lookup has to fall back to a scan
+  const std::vector<size_t>* candidates(const Object& object,
+                                        bool& useIndex) const {
+    useIndex = false;
+    if (!isIndexable(object)) return nullptr;
+
+    if (!indexed_) {
+      if (elements_.size() < INDEX_MIN_SIZE ||
+          ++scans_ < INDEX_SCAN_THRESHOLD || !buildIndex()) {
+        return nullptr;
+      }
+    }
+
+    useIndex = true;
+    auto it = index_.find(object.hash());
+    return it == index_.end() ? nullptr : &it->second;
+  }
+
+  // Lists of plain ints or plain floats are read NUMERIC_BLOCK elements at a
+  // time into an unboxed buffer for the NumericKernels loops, so the kernels
+  // run without a copy of the whole list
+  static constexpr size_t NUMERIC_BLOCK = 256;
+
+  template <typename T>
+  static const T* unboxed(const Object& object) {
+    if (typeid(object) != typeid(Number)) return nullptr;
+    return static_cast<const Number&>(object).unboxed<T>();
+  }
+
+  // Calls visit(values, count, offset) on consecutive blocks of the elements
+  // read as T until it returns false. Returns false if an element that is
+  // not a plain T came first, the caller then takes the generic path
+  template <typename T, typename TVisit>
+  bool visitNumbers(TVisit&& visit) const {
+    T values[NUMERIC_BLOCK];
+    for (size_t offset = 0; offset < elements_.size();
+         offset += NUMERIC_BLOCK) {
+      const size_t count = std::min(NUMERIC_BLOCK, elements_.size() - offset);
+      for (size_t i = 0; i < count; ++i) {
+        const T* value = unboxed<T>(*elements_[offset + i]);
+        if (value == nullptr) return false;
+        values[i] = *value;
+      }
+      if (!visit(values, count, offset)) break;
+    }
+    return true;
+  }
+
+  // Runs search(values, count, offset, value) on the blocks of a list of
+  // plain ints or floats for object, a plain int or float. Ints are matched
+  // exactly, once a float is involved both sides are compared as floats
+  // (ints converted block by block) within Number's tolerance.
+  template <typename TSearch>
+  bool searchNumbers(const Object& object, TSearch&& search) const {
+    if (elements_.empty()) return false;
+    const Object& first = *elements_.front();
+
+    if (const int64_t* value = unboxed<int64_t>(object)) {
+      if (unboxed<int64_t>(first) != nullptr) {
+        return visitNumbers<int64_t>(
+            [&](const int64_t* values, size_t count, size_t offset) {
+              return search(values, count, offset, *value);
+            });
+      }
+    }
+
+    double value = 0.0;
+    if (const int64_t* integer = unboxed<int64_t>(object)) {
+      value = static_cast<double>(*integer);
+    } else if (const double* floating = unboxed<double>(object)) {
+      value = *floating;
+    } else {
+      return false;
+    }
+
+    if (unboxed<double>(first) != nullptr) {
+      return visitNumbers<double>(
+          [&](const double* values, size_t count, size_t offset) {
+            return search(values, count, offset, value);
+          });
+    }
+    if (unboxed<int64_t>(first) != nullptr) {
+      double converted[NUMERIC_BLOCK];
+      return visitNumbers<int64_t>(
+          [&](const int64_t* values, size_t count, size_t offset) {
+            NumericKernels::convert(converted, values, count);
+            return search(converted, count, offset, value);
+          });
+    }
+    return false;
+  }
+
+  template <typename T>
+  static size_t findValue(const T* values, size_t count, T value) {
+    if constexpr (std::is_same_v<T, double>) {
+      return NumericKernels::findNear(values, count, value, DELTA);
+    } else {
+      return NumericKernels::find(values, count, value);
+    }
+  }
+
+  template <typename T>
+  static size_t countValue(const T* values, size_t count, T value) {
+    if constexpr (std::is_same_v<T, double>) {
+      return NumericKernels::countNear(values, count, value, DELTA);
+    } else {
+      return NumericKernels::count(values, count, value);
+    }
+  }
+
+  // First position of object in a numeric list (elements_.size() if it is
+  // missing), nothing if the list or object are not plain numbers
+  std::optional<size_t> numericFind(const Object& object) const {
+    size_t position = elements_.size();
+    const bool searched = searchNumbers(
+        object, [&](const auto* values, size_t count, size_t offset,
+                    auto value) {
+          const size_t found = findValue(values, count, value);
+          if (found == count) return true;
+          position = offset + found;
+          return false;
+        });
+    if (!searched) return std::nullopt;
+    return position;
+  }
+
+  std::optional<size_t> numericCount(const Object& object) const {
+    size_t total = 0;
+    const bool searched = searchNumbers(
+        object, [&](const auto* values, size_t count, size_t, auto value) {
+          total += countValue(values, count, value);
+          return true;
+        });
+    if (!searched) return std::nullopt;
+    return total;
+  }
+
+  template <bool MAXIMUM, typename T>
+  std::shared_ptr<Object> extremeOf() const {
+    // Python replaces the current best only with a strictly better element,
+    // so the first of equal elements wins and a NaN is never replaced
+    const auto better = [](T value, T best) {
+      return MAXIMUM ? best < value : value < best;
+    };
+    T best{};
+    size_t position = elements_.size();
+
+    const bool plain = visitNumbers<T>(
+        [&](const T* values, size_t count, size_t offset) {
+          if (NumericKernels::hasNan(values, count)) {
+            for (size_t i = 0; i < count; ++i) {
+              if (position == elements_.size() || better(values[i], best)) {
+                best = values[i];
+                position = offset + i;
+              }
+            }
+            return true;
+          }
+
+          const size_t found = NumericKernels::extreme<MAXIMUM>(values, count);
+          if (position == elements_.size() || better(values[found], best)) {
+            best = values[found];
+            position = offset + found;
+          }
+          return true;
+        });
+    return plain ? elements_[position] : nullptr;
+  }
+
+  // Sorts the elements on keys, keys[i] being the key of element i (the
+  // elements themselves without a key function). extract(key, recordKey)
+  // reads every key, or returns false for a key of another kind, which
+  // leaves the list as it was. A descending sort orders the reversed list
+  // and reverses the result, as CPython does, so equal elements keep their
+  // order.
+  template <typename TKey, typename TExtract, typename TSort>
+  bool sortByKeys(const std::vector<std::shared_ptr<Object>>& keys,
+                  bool descending, TExtract extract, TSort sortRecords) {
+    const size_t length = elements_.size();
+    std::vector<SortKernels::Record<TKey>> records(length);
+    for (size_t rank = 0; rank < length; ++rank) {
+      const size_t position = descending ? length - 1 - rank : rank;
+      if (!extract(*keys[position], records[rank].key)) return false;
+      records[rank].rank = rank;
+    }
+    sortRecords(records);
+
+    std::vector<std::shared_ptr<Object>> sorted(length);
+    for (size_t i = 0; i < length; ++i) {
+      const size_t rank = records[descending ? length - 1 - i : i].rank;
+      sorted[i] = std::move(elements_[descending ? length - 1 - rank : rank]);
+    }
+    invalidateCaches();
+    elements_.swap(sorted);
+    return true;
+  }
+
+  // Plain ints, plain floats or strings as keys are sorted by the
+  // SortKernels, returns false for any other keys
+  bool sortUnboxed(const std::vector<std::shared_ptr<Object>>& keys,
+                   bool descending) {
+    const Object& first = *keys.front();
+
+    if (unboxed<int64_t>(first) != nullptr) {
+      return sortByKeys<uint64_t>(
+          keys, descending,
+          [](const Object& key, uint64_t& recordKey) {
+            const int64_t* value = unboxed<int64_t>(key);
+            if (value == nullptr) return false;
+            recordKey = SortKernels::intKey(*value);
+            return true;
+          },
+          SortKernels::radixSort);
+    }
+
+    if (unboxed<double>(first) != nullptr) {
+      return sortByKeys<double>(
+          keys, descending,
+          [](const Object& key, double& recordKey) {
+            const double* value = unboxed<double>(key);
+            if (value == nullptr) return false;
+            recordKey = *value;
+            return true;
+          },
+          SortKernels::pdqsort);
+    }
+
+    std::string_view text;
+    if (textOf(first, text)) {
+      return sortByKeys<std::string_view>(keys, descending, textOf,
+                                          SortKernels::multikeySort);
+    }
+    return false;
+  }
+
+  // Other keys are timsorted with their own comparison, which needs them
+  // all of one type. Ints, floats and bools mix, bools count as 0 and 1.
+  void sortObjects(const std::vector<std::shared_ptr<Object>>& keys,
+                   bool descending) {
+    const bool numeric = isSortNumber(*keys.front());
+    bool hasBool = false;
+    for (const auto& key : keys) {
+      checkSortable(*keys.front(), *key);
+      hasBool = hasBool || (numeric && typeid(*key) != typeid(Number));
+    }
+
+    std::vector<std::shared_ptr<Object>> numbers;
+    if (hasBool) {
+      numbers.reserve(keys.size());
+      for (const auto& key : keys) {
+        numbers.push_back(typeid(*key) == typeid(Number)
+                              ? key
+                              : Number::spawn(key->toBool() ? 1 : 0));
+      }
+    }
+
+    sortByKeys<const Object*>(
+        hasBool ? numbers : keys, descending,
+        [](const Object& key, const Object*& recordKey) {
+          recordKey = &key;
+          return true;
+        },
+        [](auto& records) {
+          SortKernels::timsort(records, [](const auto& lhs, const auto& rhs) {
+            return lhs.key->compare(*rhs.key) < 0;
+          });
+        });
+  }
+
+  void sortOn(const std::vector<std::shared_ptr<Object>>& keys,
+              bool descending) {
+    if (elements_.size() < 2) return;
+    if (!sortUnboxed(keys, descending)) sortObjects(keys, descending);
+  }
+
+  int64_t findFirst(const Object& object) const {
+    bool useIndex = false;
+    const std::vector<size_t>* bucket = candidates(object, useIndex);
+
+    if (useIndex) {
+      if (bucket == nullptr) return -1;
+      for (size_t position : *bucket) {
+        if (elements_[position]->equals(object)) {
+          return static_cast<int64_t>(position);
+        }
+      }
+      return -1;
+    }
+
+    if (auto position = numericFind(object)) {
+      if (*position == elements_.size()) return -1;
+      return static_cast<int64_t>(*position);
+    }
+
+    for (size_t i = 0; i < elements_.size(); ++i) {
+      if (elements_[i]->equals(object)) return static_cast<int64_t>(i);
+    }
+    return -1;
+  }
+
+  int64_t countOf(const Object& object) const {
+    bool useIndex = false;
+    const std::vector<size_t>* bucket = candidates(object, useIndex);
+    int64_t count = 0;
+
+    if (useIndex) {
+      if (bucket == nullptr) return 0;
+      for (size_t position : *bucket) {
+        if (elements_[position]->equals(object)) ++count;
+      }
+      return count;
+    }
+
+    if (auto total = numericCount(object)) {
+      return static_cast<int64_t>(*total);
+    }
+
+    for (const auto& element : elements_) {
+      if (element->equals(object)) ++count;
+    }
+    return count;
+  }
+
+  std::shared_ptr<Object> popAt(int indexNum) {
+    auto item = elements_[indexNum];
+
+    if (indexed_ && static_cast<size_t>(indexNum) == elements_.size() - 1) {
+      auto bucket = index_.find(item->hash());
+      bucket->second.pop_back();
+      if (bucket->second.empty()) index_.erase(bucket);
+    } else {
+      invalidateCaches();
+    }
+
+    elements_.erase(elements_.begin() + indexNum);
+    return item;
+  }
+
  public:
+  static bool isSortNumber(const Object& key) {
+    return typeid(key) == typeid(Number) || key.type() == "Bool";
+  }
+
+  // Keys that sort() can order after first: ints, floats and bools with
+  // each other, anything else only with its own type. SpilledList sorts
+  // by the same rule.
+  static void checkSortable(const Object& first, const Object& key) {
+    if (isSortNumber(first) ? !isSortNumber(key)
+                            : key.type() != first.type()) {
+      throw std::runtime_error("'<' not supported between instances of '" +
+                               key.type() + "' and '" + first.type() + "'");
+    }
+  }
+
   List() = default;
 
   List(const List& other) : elements_(other.elements_) {}
@@ -33,6 +445,7 @@ class List : public Object {
   }
 
   inline std::vector<std::shared_ptr<Object>>& getElements() {
+    invalidateCaches();
     return elements_;
   }
 
@@ -51,19 +464,6 @@ class List : public Object {
     return result + "]";
   }
 
-  bool hasSingleType() const {
-    if (elements_.size() == 0) return true;
-
-    std::string type = elements_[0]->type();
-    for (auto i : iota(1, static_cast<int>(elements_.size()))) {
-      if (elements_[i]->type() != type) {
-        return false;
-      }
-    }
-
-    return true;
-  }
-
   std::shared_ptr<Tuple> asTuple() const override {
     return std::make_shared<Tuple>(elements_);
   }
@@ -158,9 +558,23 @@ class List : public Object {
   }
 
   // List specific methods
-  void append(std::shared_ptr<Object> item) { elements_.push_back(item); }
+  void append(std::shared_ptr<Object> item) {
+    if (indexed_) {
+      if (isIndexable(*item)) {
+        index_[item->hash()].push_back(elements_.size());
+      } else {
+        index_.clear();
+        indexed_ = false;
+        scans_ = 0;
+      }
+    }
+    elements_.push_back(item);
+  }
 
-  void clear() { elements_.clear(); }
+  void clear() {
+    invalidateCaches();
+    elements_.clear();
+  }
 
   // void extend(const String& other) {
   //   for (char c : other) {
@@ -174,23 +588,28 @@ class List : public Object {
 
   template<TIterable TType>
   void extend(const TType& other) {
+    invalidateCaches();
     elements_.insert(elements_.end(), other.begin(),
                      other.end());
   }
 
   template<TIterable TType>
   void extend(std::shared_ptr<TType> other) {
+    invalidateCaches();
     elements_.insert(elements_.end(), other->begin(),
                      other->end());
   }
 
   std::shared_ptr<Number> index(std::shared_ptr<Object> object) const {
-    for (auto i : iota(0, static_cast<int>(elements_.size()))) {
-      if (*elements_[i] == *object) {
-        return std::make_shared<Number>(i);
-      }
+    const int64_t position = findFirst(*object);
+    if (position == -1) {
+      throw std::runtime_error(object->toString() + " not in list");
     }
-    throw std::runtime_error(object->toString() + " not in list");
+    return std::make_shared<Number>(position);
+  }
+
+  bool contains(const std::shared_ptr<Object>& object) const {
+    return findFirst(*object) != -1;
   }
 
   std::shared_ptr<List> copy() {
@@ -203,10 +622,12 @@ class List : public Object {
   }
 
   void insert(std::shared_ptr<Number> index, std::shared_ptr<Object> object) {
+    invalidateCaches();
     elements_.insert(elements_.begin() + index->getInt(), object);
   }
 
   void insert(const Number& index, std::shared_ptr<Object> object) {
+    invalidateCaches();
     elements_.insert(elements_.begin() + index.getInt(), object);
   }
 
@@ -220,9 +641,7 @@ class List : public Object {
       throw std::out_of_range("list index out of range");
     }
 
-    auto item = elements_[indexNum];
-    elements_.erase(elements_.begin() + indexNum);
-    return item;
+    return popAt(indexNum);
   }
 
   std::shared_ptr<Object> pop(const Number& index = Number(-1)) {
@@ -235,56 +654,83 @@ class List : public Object {
       throw std::out_of_range("list index out of range");
     }
 
-    auto item = elements_[indexNum];
-    elements_.erase(elements_.begin() + indexNum);
-    return item;
+    return popAt(indexNum);
   }
 
   void remove(std::shared_ptr<Object> object) {
-    auto it = std::find_if(elements_.begin(), elements_.end(),
-                           [&object](const std::shared_ptr<Object>& element) {
-                             return element->equals(*object);
-                           });
+    const int64_t position = findFirst(*object);
 
-    if (it != elements_.end()) {
-      elements_.erase(it);
-    } else {
+    if (position == -1) {
       throw std::runtime_error(object->toString() + " not in list");
     }
+
+    invalidateCaches();
+    elements_.erase(elements_.begin() + position);
   }
 
-  void reverse() { std::reverse(elements_.begin(), elements_.end()); }
+  void reverse() {
+    invalidateCaches();
+    std::reverse(elements_.begin(), elements_.end());
+  }
 
   void sort(const std::shared_ptr<Bool>& descending = Bool::spawn(false)) {
-    static constexpr auto sortAsc = [](std::shared_ptr<Object> i,
-                                       std::shared_ptr<Object> j) {
-        return *i < *j;
-    };
-    static constexpr auto sortDesc = [](std::shared_ptr<Object> i,
-                                        std::shared_ptr<Object> j) {
-        return *i > *j;
-    };
+    sortOn(elements_, descending->toBool());
+  }
+
+  // key is called once per element, the elements are ordered by the keys
+  template <typename TKey>
+    requires std::invocable<TKey&, const std::shared_ptr<Object>&>
+  void sort(TKey key,
+            const std::shared_ptr<Bool>& descending = Bool::spawn(false)) {
+    std::vector<std::shared_ptr<Object>> keys;
+    keys.reserve(elements_.size());
+    for (const auto& element : elements_) keys.push_back(key(element));
+    sortOn(keys, descending->toBool());
+  }
+
+  // sum() of a list of plain ints (exact) or plain floats (pairwise),
+  // nullptr if the list holds anything else
+  std::shared_ptr<Number> numericSum() const {
+    if (elements_.empty()) return nullptr;
+
+    if (unboxed<int64_t>(*elements_.front()) != nullptr) {
+      __int128 total = 0;
+      const bool plain = visitNumbers<int64_t>(
+          [&](const int64_t* values, size_t count, size_t) {
+            total += NumericKernels::intSum(values, count);
+            return true;
+          });
+      return plain ? Number::fromInt128(total) : nullptr;
+    }
 
-    if (!hasSingleType()) {
-        throw std::runtime_error(
-            "Sort not supported on lists with more than one type");
+    if (unboxed<double>(*elements_.front()) != nullptr) {
+      NumericKernels::PairwiseTotal total;
+      const bool plain = visitNumbers<double>(
+          [&](const double* values, size_t count, size_t) {
+            total.add(NumericKernels::floatSum(values, count));
+            return true;
+          });
+      return plain ? Number::spawn(total.result()) : nullptr;
     }
+    return nullptr;
+  }
 
-    if (descending->toBool()) {
-      std::sort(elements_.begin(), elements_.end(), sortDesc);
-    } else {
-      std::sort(elements_.begin(), elements_.end(), sortAsc);
-    }    
+  // min() and max() of a list of plain ints or plain floats, nullptr if the
+  // list is empty or holds anything else
+  template <bool MAXIMUM>
+  std::shared_ptr<Object> numericExtreme() const {
+    if (elements_.empty()) return nullptr;
+    if (unboxed<int64_t>(*elements_.front()) != nullptr) {
+      return extremeOf<MAXIMUM, int64_t>();
+    }
+    if (unboxed<double>(*elements_.front()) != nullptr) {
+      return extremeOf<MAXIMUM, double>();
+    }
+    return nullptr;
   }
 
   std::shared_ptr<Number> count(const std::shared_ptr<Object>& obj) const {
-    int64_t count = 0;
-    for (const auto& element : elements_) {
-      if (element->equals(*obj)) {
-        ++count;
-      }
-    }
-    return Number::spawn(count);
+    return Number::spawn(countOf(*obj));
   }
 
   std::shared_ptr<Number> len() const {
@@ -301,13 +747,20 @@ class List : public Object {
     throw std::runtime_error("'list' object has no attributes");
   }
 
-  // Iterator support
-  auto begin() { return elements_.begin(); }
+  // Iterator support, mutable iterators may rewrite elements so they drop
+  // the membership index
+  auto begin() {
+    invalidateCaches();
+    return elements_.begin();
+  }
   auto end() { return elements_.end(); }
   auto begin() const { return elements_.begin(); }
   auto end() const { return elements_.end(); }
 
-  auto rbegin() { return elements_.rbegin(); }
+  auto rbegin() {
+    invalidateCaches();
+    return elements_.rbegin();
+  }
   auto rend() { return elements_.rend(); }
   auto rbegin() const { return elements_.rbegin(); }
   auto rend() const { return elements_.rend(); }
@@ -353,6 +806,7 @@ class List : public Object {
   }
 
   auto& operator[](const std::shared_ptr<Number>& pos) {
+    invalidateCaches();
     int index = pos->getInt();
     int actual_index = index;
     if (index < 0) actual_index += elements_.size();
@@ -363,6 +817,12 @@ class List : public Object {
     return elements_[actual_index];
   }
 
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return (*this)[Number(Number::indexOf(
+      *index, "list indices must be integers or slices, not "))];
+  }
+
   std::shared_ptr<List> operator[](const Slice& slice) const {
     int start = slice.start == INT_MAX ? 0 : slice.start;
     int end = slice.end == INT_MAX ? elements_.size() : slice.end;
@@ -435,44 +895,45 @@ class List : public Object {
     return result;
   }
 
-  std::shared_ptr<List> operator+=(const List& other) {
+  List& operator+=(const List& other) {
+    invalidateCaches();
+    if (&other == this) {
+      elements_.reserve(2 * elements_.size());
+      std::copy_n(elements_.begin(), elements_.size(),
+                  std::back_inserter(elements_));
+      return *this;
+    }
     elements_.insert(elements_.end(), other.elements_.begin(),
                      other.elements_.end());
-    return std::shared_ptr<List>(this, [](List*){});
+    return *this;
   }
 
-  std::shared_ptr<List> operator*=(const Number& number) {
+  List& operator*=(const Number& number) {
+    invalidateCaches();
     int n = number.getInt();
     if (n <= 0) {
       elements_.clear();
     } else {
-      auto original = elements_;
+      size_t size = elements_.size();
+      elements_.reserve(size * n);
       for (int i = 1; i < n; ++i) {
-        elements_.insert(elements_.end(), original.begin(), original.end());
+        std::copy_n(elements_.begin(), size, std::back_inserter(elements_));
       }
     }
-    return std::shared_ptr<List>(this, [](List*){});
+    return *this;
   }
 
-  std::shared_ptr<List> operator*=(const bool& number) {
+  List& operator*=(const bool& number) {
     return operator*=(Number(number? 1:0));
   }
 
-  std::shared_ptr<List> operator*=(std::shared_ptr<Number> number) {
-    int n = number->getInt();
-    if (n <= 0) {
-      elements_.clear();
-    } else {
-      auto original = elements_;
-      for (int i = 1; i < n; ++i) {
-        elements_.insert(elements_.end(), original.begin(), original.end());
-      }
-    }
-    return std::shared_ptr<List>(this, [](List*){});
+  List& operator*=(const std::shared_ptr<Number>& number) {
+    return operator*=(*number);
   }
 
   List& operator=(const List& other) {
     if (this != &other) {
+      invalidateCaches();
       elements_ = other.elements_;
     }
     return *this;
@@ -508,14 +969,18 @@ class List : public Object {
     return b->operator*(Number(a? 1:0));
   }
 
-  friend std::shared_ptr<List> operator+=(const std::shared_ptr<List>& lhs,
+  // Lists are mutable, x += y and x *= y change the list every name bound
+  // to it sees, as list.__iadd__ and list.__imul__ do
+  friend std::shared_ptr<List>& operator+=(std::shared_ptr<List>& lhs,
     const std::shared_ptr<List>& rhs) {
-    return lhs->operator+=( *rhs );
+    lhs->operator+=( *rhs );
+    return lhs;
   }
 
-  friend std::shared_ptr<List> operator*=(const std::shared_ptr<List>& lhs,
+  friend std::shared_ptr<List>& operator*=(std::shared_ptr<List>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator*=( *rhs );
+    lhs->operator*=( *rhs );
+    return lhs;
   }
 
 };
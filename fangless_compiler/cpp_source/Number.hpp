@@ -2,12 +2,18 @@
 #define NUMBER_HPP
 
 #include <cmath>
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <limits>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <variant>
 
+#include "BigInt.hpp"
+#include "Hash.hpp"
+#include "NumberFormat.hpp"
 #include "Object.hpp"
 
 constexpr double DELTA = 1e-9;
@@ -20,11 +26,27 @@ class Number : public Object {
  private:
   std::variant<int64_t, double> value_;
 
+  // Only set for ints outside the int64 range, value_ holds 0 then. Every
+  // int operation runs on value_ and checks for overflow, only its slow
+  // path looks at this.
+  std::shared_ptr<const BigInt> big_;
+
  public:
   template <Numerable TType>
   explicit Number(const TType& value) : value_(value) {}
 
-  explicit Number(const Number& other) : value_(other.value_) {}
+  // Keeps the int64 form whenever the value fits in it
+  explicit Number(BigInt value) : value_(int64_t{0}) {
+    int64_t small = 0;
+    if (value.toInt64(small)) {
+      value_ = small;
+      return;
+    }
+    big_ = std::make_shared<const BigInt>(std::move(value));
+  }
+
+  explicit Number(const Number& other)
+      : value_(other.value_), big_(other.big_) {}
 
   explicit Number(const Object& other)
       : value_(static_cast<int64_t>(other.toBool() ? 1 : 0)) {}
@@ -32,6 +54,7 @@ class Number : public Object {
   explicit Number(std::shared_ptr<Object> obj) {
     if (auto* numObj = dynamic_cast<Number*>(obj.get())) {
       value_ = numObj->value_;
+      big_ = numObj->big_;
       return;
     }
 
@@ -40,8 +63,19 @@ class Number : public Object {
 
   std::strong_ordering compare(const Object& other) const override {
       if (auto* numObj = dynamic_cast<const Number*>(&other)) {
+        if (big_ || numObj->big_) [[unlikely]] {
+          return compareBig(*numObj);
+        }
         return std::visit(
           [](auto&& a, auto&& b) -> std::strong_ordering {
+            using A = std::decay_t<decltype(a)>;
+            using B = std::decay_t<decltype(b)>;
+            // doubles lose the low bits of ints beyond 2^53
+            if constexpr (std::is_same_v<A, int64_t> &&
+                          std::is_same_v<B, int64_t>) {
+              return a <=> b;
+            }
+
             double da = static_cast<double>(a);
             double db = static_cast<double>(b);
 
@@ -63,6 +97,9 @@ class Number : public Object {
           },
         value_, numObj->value_);
       } 
+      if (other.type() == "Bool") {
+        return compare(Number(other.toBool() ? 1 : 0));
+      }
       return type() < other.type() ? std::strong_ordering::less : std::strong_ordering::greater;
   }
 
@@ -83,7 +120,7 @@ class Number : public Object {
   }
   friend std::strong_ordering operator<=>(const std::shared_ptr<Object>& lhs,
                                           const Number& rhs) {
-    return rhs.compare(*lhs);
+    return 0 <=> rhs.compare(*lhs);
   }
   friend std::strong_ordering operator<=>(const Number& lhs,
     const bool& rhs) {
@@ -121,31 +158,45 @@ class Number : public Object {
     return std::make_shared<Number>(value);
   }
 
+  // The int literals of the program are built once and shared by every
+  // evaluation. Numbers other handles hold are never changed in place (see
+  // unshare()), so the sharing is invisible.
+  template <int64_t VALUE>
+  static const std::shared_ptr<Number>& literal() {
+    static const std::shared_ptr<Number> value =
+      std::make_shared<Number>(VALUE);
+    return value;
+  }
+
+  // A Python int from an exact 128 bit result, such as a sum of int64s
+  static std::shared_ptr<Number> fromInt128(__int128 value) {
+    if (value >= INT64_MIN && value <= INT64_MAX) {
+      return spawn(static_cast<int64_t>(value));
+    }
+    BigInt high(static_cast<int64_t>(value >> 64));
+    return spawn((high << 64) +
+                 BigInt::fromUnsigned(static_cast<uint64_t>(value)));
+  }
+
   std::string type() const override {
     return std::holds_alternative<int64_t>(value_) ? "int" : "float";
   }
 
   std::string toString() const override {
-    return std::visit(
-        [](auto&& arg) -> std::string {
-          using T = std::decay_t<decltype(arg)>;
+    if (big_) [[unlikely]] return big_->toString();
+    if (const auto* integer = std::get_if<int64_t>(&value_)) {
+      return NumberFormat::integerText(*integer);
+    }
+    return NumberFormat::floatText(std::get<double>(value_));
+  }
 
-          if constexpr (std::is_same_v<T, double>) {
-            if (std::isinf(arg)) return arg > 0 ? "inf" : "-inf";
-
-            if (std::isnan(arg)) return "nan";
-            // else remove trailing zeros
-            std::ostringstream oss;
-            oss << std::fixed << arg;
-            std::string str = oss.str();
-            str.erase(str.find_last_not_of('0') + 1, std::string::npos);
-            if (str.back() == '.') str.pop_back();
-            return str;
-          } else {
-            return std::to_string(arg);
-          }
-        },
-        value_);
+  // Writes the repr into a buffer of NumberFormat::BUFFER_SIZE bytes, big
+  // ints do not fit there and are left to toString()
+  char* write(char* out) const {
+    if (const auto* integer = std::get_if<int64_t>(&value_)) {
+      return NumberFormat::writeInteger(out, *integer);
+    }
+    return NumberFormat::writeFloat(out, std::get<double>(value_));
   }
 
   inline bool isDouble() const {
@@ -166,8 +217,26 @@ class Number : public Object {
     return !isDouble();
   }
 
+  bool isBig() const { return big_ != nullptr; }
+
+  // The value if this is a plain int (T = int64_t) or float (T = double),
+  // nullptr otherwise. Lets the list kernels read elements without a visit
+  template <typename T>
+  const T* unboxed() const {
+    if (big_) [[unlikely]] return nullptr;
+    return std::get_if<T>(&value_);
+  }
+
+  // The exact value of an int
+  BigInt toBigInt() const {
+    return big_ ? *big_ : BigInt(std::get<int64_t>(value_));
+  }
+
   bool equals(const Object& other) const override {
     if (auto* numObj = dynamic_cast<const Number*>(&other)) {
+      if (big_ || numObj->big_) [[unlikely]] {
+        return compareBig(*numObj) == std::strong_ordering::equal;
+      }
       return std::visit(
           [](auto&& a, auto&& b) -> bool {
             using A = std::decay_t<decltype(a)>;
@@ -183,6 +252,10 @@ class Number : public Object {
           },
           value_, numObj->value_);
     }
+    // True == 1 and False == 0, as in Python
+    if (other.type() == "Bool") {
+      return equals(Number(other.toBool() ? 1 : 0));
+    }
 
     return false;
   }
@@ -227,15 +300,17 @@ class Number : public Object {
     return lhs->equals(Number(rhs));
   }
 
+  // Python's numeric hash, equal ints, floats and bools hash alike
   size_t hash() const override {
-    return std::visit(
-      [](auto&& arg) -> size_t {
-        return std::hash<std::decay_t<decltype(arg)>>{}(arg);
-      },
-      value_);
+    if (big_) [[unlikely]] return static_cast<size_t>(Hash::big(*big_));
+    if (const auto* integer = std::get_if<int64_t>(&value_)) {
+      return static_cast<size_t>(Hash::integer(*integer));
+    }
+    return static_cast<size_t>(Hash::floating(std::get<double>(value_)));
   }
 
   bool toBool() const override {
+    if (big_) [[unlikely]] return true;
     return std::visit(
       [](auto&& arg) -> bool {
         using T = std::decay_t<decltype(arg)>;
@@ -273,6 +348,9 @@ class Number : public Object {
   // numeric specific methods
 
   int64_t getInt() const {
+    if (big_) [[unlikely]] {
+      throw std::overflow_error("Python int too large to convert to C int64");
+    }
     return std::visit(
       [](auto&& arg) -> int64_t {
         using T = std::decay_t<decltype(arg)>;
@@ -284,14 +362,27 @@ class Number : public Object {
       value_);
   }
 
+  // An int or a bool used as a position, for getItem() of the sequences.
+  // error starts the message raised for any other type
+  static int64_t indexOf(const Object& index, const std::string& error) {
+    if (index.type() == "Bool") return index.toBool() ? 1 : 0;
+    const auto* number = dynamic_cast<const Number*>(&index);
+    if (number == nullptr || number->isDouble()) {
+      throw std::runtime_error(error + index.type());
+    }
+    return number->getInt();
+  }
+
   // explicit operator int64_t() const { return getInt(); }
 
   double getDouble() const {
+    if (big_) [[unlikely]] return big_->toDouble();
     return std::visit(
       [](auto&& arg) -> double { return static_cast<double>(arg); }, value_);
   }
 
   std::shared_ptr<Number> conjugate() {
+    if (big_) [[unlikely]] return std::make_shared<Number>(*this);
     return std::visit(
       [](auto&& arg) -> std::shared_ptr<Number> {
         using T = std::decay_t<decltype(arg)>;
@@ -328,6 +419,7 @@ class Number : public Object {
   }
 
   std::shared_ptr<Number> real() {
+    if (big_) [[unlikely]] return std::make_shared<Number>(*this);
     return std::visit(
       [](auto&& arg) -> std::shared_ptr<Number> {
         using T = std::decay_t<decltype(arg)>;
@@ -340,6 +432,7 @@ class Number : public Object {
   }
 
   std::shared_ptr<Number> numerator() {
+    if (big_) [[unlikely]] return std::make_shared<Number>(*this);
     return std::visit(
       [](auto&& arg) -> std::shared_ptr<Number> {
         using T = std::decay_t<decltype(arg)>;
@@ -391,6 +484,7 @@ class Number : public Object {
     if (this->isDouble()) {
       throw(std::invalid_argument("Can not use a double for ~ operation"));
     }
+    if (big_) [[unlikely]] return std::make_shared<Number>(~*big_);
     return Number::spawn(~(this->getInt()));
   }
 
@@ -400,45 +494,7 @@ class Number : public Object {
   }
 
   std::shared_ptr<Number> operator+(const Number& other) const {
-    return std::visit(
-      [](auto&& a, auto&& b) -> std::shared_ptr<Number> {
-        using A = std::decay_t<decltype(a)>;
-        using B = std::decay_t<decltype(b)>;
-        if constexpr (std::is_same_v<A, double> ||
-                      std::is_same_v<B, double>) {
-          return std::make_shared<Number>(static_cast<double>(a) +
-                                          static_cast<double>(b));
-        } else {
-          return std::make_shared<Number>(a + b);
-        }
-      },
-      value_, other.value_);
-  }
-  std::shared_ptr<Number> operator+(const bool& other) const {
-    return operator+(Number(other? 1:0));
-  }
-  std::shared_ptr<Number> operator+(const int& other) const {
-    return operator+(Number(other));
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->operator+(Number(rhs? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator+(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator+(Number(lhs ? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->operator+(Number(rhs));
-  }
-
-  friend std::shared_ptr<Number> operator+(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator+(Number(lhs));
+    return arithmetic<Addition>(operand(), other.operand());
   }
 
   std::shared_ptr<Number> operator-() const {
@@ -447,304 +503,281 @@ class Number : public Object {
       return Number::spawn(value);
     }
 
-    const int value = -(this->getInt());
+    int64_t value = 0;
+    if (big_ || __builtin_sub_overflow(int64_t{0}, this->getInt(), &value))
+        [[unlikely]] {
+      return std::make_shared<Number>(-toBigInt());
+    }
     return Number::spawn(value);
   }
 
   std::shared_ptr<Number> operator-(const Number& other) const {
-    return std::visit(
-      [](auto&& a, auto&& b) -> std::shared_ptr<Number> {
-        using A = std::decay_t<decltype(a)>;
-        using B = std::decay_t<decltype(b)>;
-        if constexpr (std::is_same_v<A, double> ||
-                      std::is_same_v<B, double>) {
-          return std::make_shared<Number>(static_cast<double>(a) -
-                                          static_cast<double>(b));
-        } else {
-          return std::make_shared<Number>(a - b);
-        }
-      },
-      value_, other.value_);
-  }
-
-  std::shared_ptr<Number> operator-(const bool& other) const {
-    return operator-(Number(other? 1:0));
-  }
-  std::shared_ptr<Number> operator-(const int& other) const {
-    return operator-(Number(other));
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->operator-(Number(rhs? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator-(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator-(Number(lhs ? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->operator-(Number(rhs));
-  }
-
-  friend std::shared_ptr<Number> operator-(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator-(Number(lhs));
+    return arithmetic<Subtraction>(operand(), other.operand());
   }
 
   std::shared_ptr<Number> operator*(const Number& other) const {
-    return std::visit(
-      [](auto&& a, auto&& b) -> std::shared_ptr<Number> {
-        using A = std::decay_t<decltype(a)>;
-        using B = std::decay_t<decltype(b)>;
-        if constexpr (std::is_same_v<A, double> ||
-                      std::is_same_v<B, double>) {
-          return std::make_shared<Number>(static_cast<double>(a) *
-                                          static_cast<double>(b));
-        } else {
-          return std::make_shared<Number>(a * b);
-        }
-      },
-      value_, other.value_);
+    return arithmetic<Multiplication>(operand(), other.operand());
   }
 
-  std::shared_ptr<Number> operator*(const bool& other) const {
-    return operator*(Number(other? 1:0));
-  }
-  std::shared_ptr<Number> operator*(const int& other) const {
-    return operator*(Number(other));
-  }
-
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->operator*(Number(rhs? 1 : 0));
+  // The remainder takes the sign of the divisor
+  std::shared_ptr<Number> operator%(const Number& other) const {
+    return arithmetic<Modulo>(operand(), other.operand());
   }
 
-  friend std::shared_ptr<Number> operator*(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator*(Number(lhs ? 1 : 0));
+  std::shared_ptr<Number> operator/(const Number& other) const {
+    return arithmetic<Division>(operand(), other.operand());
   }
 
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->operator*(Number(rhs));
+  // a // b, rounded towards negative infinity for ints and floats
+  std::shared_ptr<Number> floorDivide(const Number& other) const {
+    return arithmetic<FloorDivision>(operand(), other.operand());
   }
 
-  friend std::shared_ptr<Number> operator*(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator*(Number(lhs));
+  std::shared_ptr<Number> pow(const std::shared_ptr<Number>& other) const {
+    return arithmetic<Power>(operand(), other->operand());
   }
 
-  std::shared_ptr<Number> operator%(const Number& other) const {
-    return std::visit(
-      [](auto&& a, auto&& b) -> std::shared_ptr<Number> {
-        using A = std::decay_t<decltype(a)>;
-        using B = std::decay_t<decltype(b)>;
-
-        if constexpr (std::is_same_v<A, double> ||
-                      std::is_same_v<B, double>) {
-          int quotient = static_cast<int>(a / b);
-          double remainder = a - (static_cast<double>(quotient) * b);
-          return std::make_shared<Number>(remainder);
-
-        } else {
-          if (b == 0) {
-            throw std::runtime_error("Division by zero");
-          }
-          return std::make_shared<Number>(a % b);
-        }
-      },
-      value_, other.value_);
-  }
+  // An arithmetic operand as the kernels see it: an int64, a float or a
+  // big int. Bools and int literals become INT operands without a Number
+  // being built for them.
+  struct Operand {
+    enum Kind : uint8_t { INT, FLOAT, BIG };
 
-  std::shared_ptr<Number> operator%(const bool& other) const {
-    return operator%(Number(other? 1:0));
-  }
-  std::shared_ptr<Number> operator%(const int& other) const {
-    return operator%(Number(other));
-  }
+    Kind kind;
+    int64_t integer;
+    double floating;
+    const Number* number;
 
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->operator%(Number(rhs? 1 : 0));
-  }
+    static Operand of(int64_t value) { return {INT, value, 0.0, nullptr}; }
 
-  friend std::shared_ptr<Number> operator%(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator%(Number(lhs ? 1 : 0));
-  }
+    double toDouble() const {
+      return kind == FLOAT ? floating : static_cast<double>(integer);
+    }
 
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->operator%(Number(rhs));
-  }
+    Number toNumber() const {
+      if (number) return Number(*number);
+      if (kind == FLOAT) return Number(floating);
+      return Number(integer);
+    }
+  };
 
-  friend std::shared_ptr<Number> operator%(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator%(Number(lhs));
-  }
+  Operand operand() const {
+    if (big_) [[unlikely]] return {Operand::BIG, 0, 0.0, this};
+    if (const auto* integer = std::get_if<int64_t>(&value_)) [[likely]] {
+      return {Operand::INT, *integer, 0.0, this};
+    }
+    return {Operand::FLOAT, 0, std::get<double>(value_), this};
+  }
+
+  // Binary arithmetic for every mix of operand kinds. Two int64s, by far
+  // the most common pair, are matched first and never visit the variant.
+  // The other pairs are looked up in a table of kernels: float arithmetic
+  // once either side is a float, the BigInt operations once either side is
+  // a big int.
+  template <typename TOperation>
+  static std::shared_ptr<Number> arithmetic(const Operand& lhs,
+                                            const Operand& rhs) {
+    if (lhs.kind == Operand::INT && rhs.kind == Operand::INT) [[likely]] {
+      return TOperation::ints(lhs.integer, rhs.integer);
+    }
 
-  std::shared_ptr<Number> operator/(const Number& other) const {
-    return std::visit(
-      [](auto&& a, auto&& b) -> std::shared_ptr<Number> {
-        using B = std::decay_t<decltype(b)>;
+    using Kernel = std::shared_ptr<Number> (*)(const Operand&, const Operand&);
+    static constexpr Kernel KERNELS[3][3] = {
+      {intKernel<TOperation>, floatKernel<TOperation>, bigKernel<TOperation>},
+      {floatKernel<TOperation>, floatKernel<TOperation>,
+       bigKernel<TOperation>},
+      {bigKernel<TOperation>, bigKernel<TOperation>, bigKernel<TOperation>}};
+    return KERNELS[lhs.kind][rhs.kind](lhs, rhs);
+  }
+
+  // The kernels of each operator: ints() for two int64s, which moves to
+  // BigInt when the result overflows, floats() for two doubles and big()
+  // for the pairs with a big int
+  struct Addition {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      int64_t sum = 0;
+      if (__builtin_add_overflow(a, b, &sum)) [[unlikely]] {
+        return std::make_shared<Number>(BigInt(a) + BigInt(b));
+      }
+      return std::make_shared<Number>(sum);
+    }
+    static double floats(double a, double b) { return a + b; }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, std::plus<>{}, std::plus<>{});
+    }
+  };
 
-        if constexpr (std::is_same_v<B, double>) {
-          if (std::abs(b) < DELTA) {
-            throw std::runtime_error("Division by zero");
-          }
-        } else {
-          if (b == 0) {
-            throw std::runtime_error("Division by zero");
-          }
-        }
+  struct Subtraction {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      int64_t difference = 0;
+      if (__builtin_sub_overflow(a, b, &difference)) [[unlikely]] {
+        return std::make_shared<Number>(BigInt(a) - BigInt(b));
+      }
+      return std::make_shared<Number>(difference);
+    }
+    static double floats(double a, double b) { return a - b; }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, std::minus<>{}, std::minus<>{});
+    }
+  };
 
+  struct Multiplication {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      int64_t product = 0;
+      if (__builtin_mul_overflow(a, b, &product)) [[unlikely]] {
+        return std::make_shared<Number>(BigInt(a) * BigInt(b));
+      }
+      return std::make_shared<Number>(product);
+    }
+    static double floats(double a, double b) { return a * b; }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, std::multiplies<>{}, std::multiplies<>{});
+    }
+  };
+
+  struct Division {
+    // ints up to 2^53 are exact doubles, so one division rounds correctly;
+    // larger ones are divided exactly as BigInts first
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      if (b == 0) throw std::runtime_error("Division by zero");
+      constexpr int64_t EXACT = int64_t{1} << 53;
+      if (a >= -EXACT && a <= EXACT && b >= -EXACT && b <= EXACT) [[likely]] {
         return std::make_shared<Number>(static_cast<double>(a) /
                                         static_cast<double>(b));
-      },
-      value_, other.value_);
-  }
-
-  std::shared_ptr<Number> operator/(const bool& other) const {
-    return operator/(Number(other? 1:0));
-  }
-  std::shared_ptr<Number> operator/(const int& other) const {
-    return operator/(Number(other));
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->operator/(Number(rhs? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator/(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator/(Number(lhs ? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->operator/(Number(rhs));
-  }
-
-  friend std::shared_ptr<Number> operator/(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->operator/(Number(lhs));
-  }
-
-  std::shared_ptr<Number> pow(std::shared_ptr<Number> other) const {
-    if (isDouble() || other->isDouble() || other < *Number::spawn(0)) {
+      }
       return std::make_shared<Number>(
-        std::pow(getDouble(), other->getDouble()));
+        BigInt::trueDivide(BigInt(a), BigInt(b)));
     }
-
-    const double doubleValue = std::pow(getInt(), other->getInt());
-
-    if (std::isnan(doubleValue) || std::isinf(doubleValue)) {
-      return std::make_shared<Number>(doubleValue);
+    static double floats(double a, double b) {
+      if (b == 0.0) throw std::runtime_error("Division by zero");
+      return a / b;
     }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, BigInt::trueDivide, floats);
+    }
+  };
+
+  struct Modulo {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      if (b == 0) throw std::runtime_error("Division by zero");
+      // INT64_MIN % -1 traps
+      if (b == -1) return std::make_shared<Number>(int64_t{0});
+      int64_t remainder = a % b;
+      if (remainder != 0 && (remainder < 0) != (b < 0)) remainder += b;
+      return std::make_shared<Number>(remainder);
+    }
+    static double floats(double a, double b) { return floatModulo(a, b); }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, std::modulus<>{}, floatModulo);
+    }
+  };
 
-    return std::make_shared<Number>(static_cast<int64_t>(doubleValue));
-  }
-
-  std::shared_ptr<Number> pow(const bool& other) const {
-    return pow(Number::spawn(other? 1:0));
-  }
-  std::shared_ptr<Number> pow(const int& other) const {
-    return pow(Number::spawn(other));
-  }
-
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Number>& lhs,
-    const bool& rhs) {
-    return lhs->pow(Number::spawn(rhs? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> pow(const bool& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->pow(Number::spawn(lhs ? 1 : 0));
-  }
-
-  friend std::shared_ptr<Number> pow(const std::shared_ptr<Number>& lhs,
-    const int& rhs) {
-    return lhs->pow(Number::spawn(rhs));
-  }
-
-  friend std::shared_ptr<Number> pow(const int& lhs,
-    const std::shared_ptr<Number>& rhs) {
-    return rhs->pow(Number::spawn(lhs));
-  }
+  struct FloorDivision {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      if (b == 0) throw std::runtime_error("Division by zero");
+      if (b == -1 && a == INT64_MIN) [[unlikely]] {
+        return std::make_shared<Number>(-BigInt(a));
+      }
+      int64_t quotient = a / b;
+      if (a % b != 0 && (a < 0) != (b < 0)) --quotient;
+      return std::make_shared<Number>(quotient);
+    }
+    static double floats(double a, double b) {
+      return floatFloorDivide(a, b);
+    }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      return a.bigOperation(b, std::divides<>{}, floatFloorDivide);
+    }
+  };
+
+  // Ints raised to a non negative int stay exact, squaring in int64 until
+  // a step overflows and over again with BigInt then
+  struct Power {
+    static std::shared_ptr<Number> ints(int64_t a, int64_t b) {
+      if (b < 0) {
+        return std::make_shared<Number>(
+          std::pow(static_cast<double>(a), static_cast<double>(b)));
+      }
+      int64_t base = a;
+      int64_t result = 1;
+      bool overflow = false;
+      for (uint64_t rest = static_cast<uint64_t>(b); rest != 0 && !overflow;
+           rest >>= 1) {
+        if (rest & 1) overflow = __builtin_mul_overflow(result, base, &result);
+        if (rest > 1 && !overflow) {
+          overflow = __builtin_mul_overflow(base, base, &base);
+        }
+      }
+      if (!overflow) return std::make_shared<Number>(result);
+      return std::make_shared<Number>(
+        BigInt::power(BigInt(a), static_cast<uint64_t>(b)));
+    }
+    static double floats(double a, double b) { return std::pow(a, b); }
+    static std::shared_ptr<Number> big(const Number& a, const Number& b) {
+      if (a.isDouble() || b.isDouble() || b.isNegative()) {
+        return std::make_shared<Number>(
+          std::pow(a.getDouble(), b.getDouble()));
+      }
+      if (b.big_) {
+        // only 0, 1 and -1 have a power this large that fits in memory
+        if (!a.big_ && (a.getInt() == 0 || a.getInt() == 1)) {
+          return std::make_shared<Number>(a);
+        }
+        if (!a.big_ && a.getInt() == -1) {
+          return Number::spawn((*b.big_ % BigInt(2)).isZero()
+                                 ? int64_t{1} : int64_t{-1});
+        }
+        throw std::overflow_error("exponent too large");
+      }
+      return std::make_shared<Number>(BigInt::power(
+        a.toBigInt(), static_cast<uint64_t>(b.getInt())));
+    }
+  };
 
   // pre-increment
   std::shared_ptr<Number> operator++() {
-    std::visit(
-      [](auto&& arg) {
-        using T = std::decay_t<decltype(arg)>;
-        if constexpr (std::is_same_v<T, double>) {
-          arg += 1.0;
-        } else {
-          arg += 1;
-        }
-      },
-      value_);
-
+    step(1);
     return std::make_shared<Number>(*this);
   }
 
   // post-increment
   std::shared_ptr<Number> operator++(int) {
     std::shared_ptr<Number> old_value = std::make_shared<Number>(*this);
-    std::visit(
-      [](auto&& arg) {
-        using T = std::decay_t<decltype(arg)>;
-        if constexpr (std::is_same_v<T, double>) {
-          arg += 1.0;
-        } else {
-          arg += 1;
-        }
-      },
-      value_);
-
+    step(1);
     return std::make_shared<Number>(old_value);
   }
 
   std::shared_ptr<Number> operator--() {
-    std::visit([](auto&& arg) {
-      using T = std::decay_t<decltype(arg)>;
-      if constexpr (std::is_same_v<T, double>) {
-        arg -= 1.0;
-      } else {
-        arg -= 1;
-      }
-    }, value_);
-  
+    step(-1);
     return std::make_shared<Number>(*this);
   }
 
   std::shared_ptr<Number> operator--(int) {
     std::shared_ptr<Number> old_value = std::make_shared<Number>(*this);
-    std::visit([](auto&& arg) {
-      using T = std::decay_t<decltype(arg)>;
-      if constexpr (std::is_same_v<T, double>) {
-        arg -= 1.0;
-      } else {
-        arg -= 1;
-      }
-    }, value_);
-        
+    step(-1);
     return std::make_shared<Number>(old_value);
   }
 
   std::shared_ptr<Number> operator<<(const Number& rhs) const {
+    const int64_t count = rhs.shiftCount();
+    int64_t value = 0;
     if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      return Number::spawn(*lhs_int << std::get<int64_t>(rhs.value_));
+      value = *lhs_int;
+    } else if (auto lhs_double = std::get_if<double>(&value_)) {
+      value = static_cast<int64_t>(*lhs_double);
+    } else {
+      throw std::invalid_argument("Unsupported type for shift operation");
     }
-    if (auto lhs_double = std::get_if<double>(&value_)) {
-      return Number::spawn(
-        static_cast<int64_t>(*lhs_double) << std::get<int64_t>(rhs.value_));
+
+    if (!big_) {
+      // the shift is exact when shifting back gives the value again
+      if (value == 0) return Number::spawn(int64_t{0});
+      if (count < 63 && ((value << count) >> count) == value) {
+        return Number::spawn(value << count);
+      }
+      return std::make_shared<Number>(BigInt(value) << count);
     }
-    throw std::invalid_argument("Unsupported type for shift operation");
+    return std::make_shared<Number>(*big_ << count);
   }
 
   friend std::shared_ptr<Number> operator<<(const std::shared_ptr<Number>& lhs,
@@ -762,42 +795,53 @@ class Number : public Object {
     return Number(lhs? 1:0) << *rhs;
   }
 
-  std::shared_ptr<Number> operator<<=(const Number& other) {
-    std::shared_ptr<Number> result = *this << other;
-    value_ = result->value_;
-    return std::shared_ptr<Number>(this, [](Number*){}); // Shared pointer does not delete `this`
+  Number& operator<<=(const Number& other) {
+    assign(*(*this << other));
+    return *this;
   }
 
-  std::shared_ptr<Number> operator<<=(const bool& other) {
+  Number& operator<<=(const bool& other) {
       return operator<<=(Number(other ? 1 : 0));
   }
 
-  std::shared_ptr<Number> operator<<=(const int& other) {
+  Number& operator<<=(const int& other) {
       return operator<<=(Number(other));
   }
 
-  friend std::shared_ptr<Number> operator<<=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator<<=(std::shared_ptr<Number>& lhs,
       const std::shared_ptr<Number>& rhs) {
-      return lhs->operator<<=(*rhs);
+    unshare(lhs)->operator<<=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator<<=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator<<=(std::shared_ptr<Number>& lhs,
       const bool& rhs) {
-      return lhs->operator<<=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator<<=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator<<=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator<<=(std::shared_ptr<Number>& lhs,
       const int& rhs) {
-      return lhs->operator<<=(Number(rhs));
+    unshare(lhs)->operator<<=(Number(rhs));
+    return lhs;
   }
 
+  // Rounds towards negative infinity, shifting everything out leaves 0 or
+  // -1
   std::shared_ptr<Number> operator>>(const Number& rhs) const {
+    if (rhs.big_ && !rhs.big_->isNegative()) [[unlikely]] {
+      return Number::spawn(int64_t{toBool() && isNegative() ? -1 : 0});
+    }
+    const int64_t count = rhs.shiftCount();
+    if (big_) [[unlikely]] {
+      return std::make_shared<Number>(*big_ >> count);
+    }
     if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      return Number::spawn(*lhs_int >> std::get<int64_t>(rhs.value_));
+      return Number::spawn(*lhs_int >> std::min<int64_t>(count, 63));
     }
     if (auto lhs_double = std::get_if<double>(&value_)) {
-      return Number::spawn(
-        static_cast<int64_t>(*lhs_double) >> std::get<int64_t>(rhs.value_));
+      return Number::spawn(static_cast<int64_t>(*lhs_double) >>
+                           std::min<int64_t>(count, 63));
     }
     throw std::invalid_argument("Unsupported type for shift operation");
   }
@@ -817,201 +861,215 @@ class Number : public Object {
     return Number(lhs? 1:0) >> *rhs;
   }
 
-  std::shared_ptr<Number> operator>>=(const Number& other) {
-    std::shared_ptr<Number> result = *this >> other;
-    value_ = result->value_;
-    return std::shared_ptr<Number>(this, [](Number*){}); // Shared pointer does not delete `this`
+  Number& operator>>=(const Number& other) {
+    assign(*(*this >> other));
+    return *this;
   }
 
-  std::shared_ptr<Number> operator>>=(const bool& other) {
+  Number& operator>>=(const bool& other) {
     return operator>>=(Number(other ? 1 : 0));
   }
 
-  std::shared_ptr<Number> operator>>=(const int& other) {
+  Number& operator>>=(const int& other) {
     return operator>>=(Number(other));
   }
 
-  friend std::shared_ptr<Number> operator>>=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator>>=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator>>=(*rhs);
+    unshare(lhs)->operator>>=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator>>=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator>>=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator>>=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator>>=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator>>=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator>>=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator>>=(Number(rhs));
+    unshare(lhs)->operator>>=(Number(rhs));
+    return lhs;
   }
 
-  std::shared_ptr<Number> operator+=(const Number& rhs) {
-    if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_int += *rhs_int;
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_int += static_cast<int64_t>(*rhs_double);
-      }
-    } else if (auto lhs_double = std::get_if<double>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_double += static_cast<double>(*rhs_int);
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_double += *rhs_double;
-      }
+  // Python ints are immutable, so x op= y updates the number in place only
+  // when the handle is its sole owner. A number other names or containers
+  // hold is copied first and the name rebound to the copy.
+  static Number* unshare(std::shared_ptr<Number>& handle) {
+    if (handle.use_count() != 1) handle = std::make_shared<Number>(*handle);
+    return handle.get();
+  }
+
+  Number& operator+=(const Number& rhs) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&rhs.value_);
+    int64_t result = 0;
+    if (lhs_int && rhs_int && !big_ && !rhs.big_ &&
+        !__builtin_add_overflow(*lhs_int, *rhs_int, &result)) [[likely]] {
+      *lhs_int = result;
     } else {
-      throw std::invalid_argument("Unsupported type for += operation");
+      assign(*(*this + rhs));
     }
-    return std::shared_ptr<Number>(this, [](Number*){});
+    return *this;
   }
 
-  std::shared_ptr<Number> operator-=(const Number& rhs) {
-    if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_int -= *rhs_int;
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_int -= static_cast<int64_t>(*rhs_double);
-      }
-    } else if (auto lhs_double = std::get_if<double>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_double -= static_cast<double>(*rhs_int);
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_double -= *rhs_double;
-      }
+  Number& operator-=(const Number& rhs) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&rhs.value_);
+    int64_t result = 0;
+    if (lhs_int && rhs_int && !big_ && !rhs.big_ &&
+        !__builtin_sub_overflow(*lhs_int, *rhs_int, &result)) [[likely]] {
+      *lhs_int = result;
     } else {
-      throw std::invalid_argument("Unsupported type for -= operation");
+      assign(*(*this - rhs));
     }
-    return std::shared_ptr<Number>(this, [](Number*){});
+    return *this;
   }
 
-  std::shared_ptr<Number> operator%=(const Number& rhs) {
-    if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_int %= *rhs_int;
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_int %= static_cast<int64_t>(*rhs_double);
-      }
+  Number& operator%=(const Number& rhs) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&rhs.value_);
+    if (lhs_int && rhs_int && !big_ && !rhs.big_ && *rhs_int > 0) [[likely]] {
+      int64_t remainder = *lhs_int % *rhs_int;
+      *lhs_int = remainder < 0 ? remainder + *rhs_int : remainder;
     } else {
-      throw std::invalid_argument("Unsupported type for %= operation");
+      assign(*(*this % rhs));
     }
-    return std::shared_ptr<Number>(this, [](Number*){});
+    return *this;
   }
 
-  std::shared_ptr<Number> operator/=(const Number& rhs) {
-    if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_int /= *rhs_int;
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_int /= static_cast<int64_t>(*rhs_double);
-      }
-    } else if (auto lhs_double = std::get_if<double>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_double /= static_cast<double>(*rhs_int);
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_double /= *rhs_double;
-      }
+  Number& operator/=(const Number& rhs) {
+    assign(*(*this / rhs));
+    return *this;
+  }
+
+  Number& operator*=(const Number& rhs) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&rhs.value_);
+    int64_t result = 0;
+    if (lhs_int && rhs_int && !big_ && !rhs.big_ &&
+        !__builtin_mul_overflow(*lhs_int, *rhs_int, &result)) [[likely]] {
+      *lhs_int = result;
     } else {
-      throw std::invalid_argument("Unsupported type for /= operation");
+      assign(*(*this * rhs));
     }
-    return std::shared_ptr<Number>(this, [](Number*){});
+    return *this;
   }
 
-  std::shared_ptr<Number> operator*=(const Number& rhs) {
-    if (auto lhs_int = std::get_if<int64_t>(&value_)) {
-      if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-        *lhs_int *= *rhs_int;
-      } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-        *lhs_int *= static_cast<int64_t>(*rhs_double);
-      }
-    } else if (auto lhs_double = std::get_if<double>(&value_)) {
-        if (auto rhs_int = std::get_if<int64_t>(&rhs.value_)) {
-          *lhs_double *= static_cast<double>(*rhs_int);
-        } else if (auto rhs_double = std::get_if<double>(&rhs.value_)) {
-          *lhs_double *= *rhs_double;
-        }
+  // x //= y, a positive int divisor is the common case done in place
+  Number& floorDivideAssign(const Number& rhs) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&rhs.value_);
+    if (lhs_int && rhs_int && !big_ && !rhs.big_ && *rhs_int > 0) [[likely]] {
+      int64_t quotient = *lhs_int / *rhs_int;
+      if (*lhs_int % *rhs_int < 0) --quotient;
+      *lhs_int = quotient;
     } else {
-      throw std::invalid_argument("Unsupported type for *= operation");
+      assign(*floorDivide(rhs));
     }
-    return std::shared_ptr<Number>(this, [](Number*){});
+    return *this;
   }
 
+  Number& powerAssign(const std::shared_ptr<Number>& rhs) {
+    assign(*pow(rhs));
+    return *this;
+  }
 
-  friend std::shared_ptr<Number> operator+=(const std::shared_ptr<Number>& lhs,
+
+  friend std::shared_ptr<Number>& operator+=(std::shared_ptr<Number>& lhs,
                                            const std::shared_ptr<Number>& rhs) {
-    return lhs->operator+=( *rhs );
+    unshare(lhs)->operator+=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator-=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator-=(std::shared_ptr<Number>& lhs,
                                            const std::shared_ptr<Number>& rhs) {
-    return lhs->operator-=( *rhs );
+    unshare(lhs)->operator-=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator%=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator%=(std::shared_ptr<Number>& lhs,
                                            const std::shared_ptr<Number>& rhs) {
-    return lhs->operator%=( *rhs );
+    unshare(lhs)->operator%=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator/=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator/=(std::shared_ptr<Number>& lhs,
                                            const std::shared_ptr<Number>& rhs) {
-    return lhs->operator/=( *rhs );
+    unshare(lhs)->operator/=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator+=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator+=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator+=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator+=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator+=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator+=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator+=(Number(rhs));
+    unshare(lhs)->operator+=(Number(rhs));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator-=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator-=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator-=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator-=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator-=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator-=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator-=(Number(rhs));
+    unshare(lhs)->operator-=(Number(rhs));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator%=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator%=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator%=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator%=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator%=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator%=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator%=(Number(rhs));
+    unshare(lhs)->operator%=(Number(rhs));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator/=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator/=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator/=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator/=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator/=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator/=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator/=(Number(rhs));
+    unshare(lhs)->operator/=(Number(rhs));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator*=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator*=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator*=(Number(rhs ? 1 : 0));
+    unshare(lhs)->operator*=(Number(rhs ? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator*=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator*=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator*=(Number(rhs));
+    unshare(lhs)->operator*=(Number(rhs));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator*=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator*=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator*=( *rhs );
+    unshare(lhs)->operator*=(*rhs);
+    return lhs;
   }
 
   std::shared_ptr<Number> operator|(const Number& other) const {
+    if ((big_ || other.big_) && !isDouble() && !other.isDouble()) [[unlikely]] {
+      return std::make_shared<Number>(toBigInt() | other.toBigInt());
+    }
     return std::visit([other](auto&& arg) -> std::shared_ptr<Number> {
       using T = std::decay_t<decltype(arg)>;
       if constexpr (std::is_same_v<T, double>) {
@@ -1061,35 +1119,46 @@ class Number : public Object {
     return *a | *b;
   }
 
-  std::shared_ptr<Number> operator|=(const Number& other) {
-    std::shared_ptr<Number> result = *this | other;
-    value_ = result->value_;
-    return std::shared_ptr<Number>(this, [](Number*){});
+  Number& operator|=(const Number& other) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&other.value_);
+    if (lhs_int && rhs_int && !big_ && !other.big_) [[likely]] {
+      *lhs_int |= *rhs_int;
+    } else {
+      assign(*(*this | other));
+    }
+    return *this;
   }
 
-  std::shared_ptr<Number> operator|=(const bool& other) {
+  Number& operator|=(const bool& other) {
     return operator|=(Number(other? 1:0));
   }
-  std::shared_ptr<Number> operator|=(const int& other) {
+  Number& operator|=(const int& other) {
     return operator|=(Number(other));
   }
 
-  friend std::shared_ptr<Number> operator|=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator|=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator|=(*rhs);
+    unshare(lhs)->operator|=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator|=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator|=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator|=(Number(rhs? 1 : 0));
+    unshare(lhs)->operator|=(Number(rhs? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator|=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator|=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator|=(Number(rhs));
+    unshare(lhs)->operator|=(Number(rhs));
+    return lhs;
   }
 
   std::shared_ptr<Number> operator&(const Number& other) const {
+    if ((big_ || other.big_) && !isDouble() && !other.isDouble()) [[unlikely]] {
+      return std::make_shared<Number>(toBigInt() & other.toBigInt());
+    }
     return std::visit([other](auto&& arg) -> std::shared_ptr<Number> {
       using T = std::decay_t<decltype(arg)>;
       if constexpr (std::is_same_v<T, double>) {
@@ -1139,35 +1208,46 @@ class Number : public Object {
     return *a & *b;
   }
 
-  std::shared_ptr<Number> operator&=(const Number& other) {
-    std::shared_ptr<Number> result = *this & other;
-    value_ = result->value_;
-    return std::shared_ptr<Number>(this, [](Number*){});
+  Number& operator&=(const Number& other) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&other.value_);
+    if (lhs_int && rhs_int && !big_ && !other.big_) [[likely]] {
+      *lhs_int &= *rhs_int;
+    } else {
+      assign(*(*this & other));
+    }
+    return *this;
   }
 
-  std::shared_ptr<Number> operator&=(const bool& other) {
+  Number& operator&=(const bool& other) {
     return operator&=(Number(other? 1:0));
   }
-  std::shared_ptr<Number> operator&=(const int& other) {
+  Number& operator&=(const int& other) {
     return operator&=(Number(other));
   }
 
-  friend std::shared_ptr<Number> operator&=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator&=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator&=(*rhs);
+    unshare(lhs)->operator&=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator&=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator&=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator&=(Number(rhs? 1 : 0));
+    unshare(lhs)->operator&=(Number(rhs? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator&=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator&=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator&=(Number(rhs));
+    unshare(lhs)->operator&=(Number(rhs));
+    return lhs;
   }
 
   std::shared_ptr<Number> operator^(const Number& other) const {
+    if ((big_ || other.big_) && !isDouble() && !other.isDouble()) [[unlikely]] {
+      return std::make_shared<Number>(toBigInt() ^ other.toBigInt());
+    }
     return std::visit([other](auto&& arg) -> std::shared_ptr<Number> {
       using T = std::decay_t<decltype(arg)>;
       if constexpr (std::is_same_v<T, double>) {
@@ -1217,32 +1297,40 @@ class Number : public Object {
     return *a ^ *b;
   }
 
-  std::shared_ptr<Number> operator^=(const Number& other) {
-    std::shared_ptr<Number> result = *this ^ other;
-    value_ = result->value_;
-    return std::shared_ptr<Number>(this, [](Number*){});
+  Number& operator^=(const Number& other) {
+    auto lhs_int = std::get_if<int64_t>(&value_);
+    auto rhs_int = std::get_if<int64_t>(&other.value_);
+    if (lhs_int && rhs_int && !big_ && !other.big_) [[likely]] {
+      *lhs_int ^= *rhs_int;
+    } else {
+      assign(*(*this ^ other));
+    }
+    return *this;
   }
 
-  std::shared_ptr<Number> operator^=(const bool& other) {
+  Number& operator^=(const bool& other) {
     return operator^=(Number(other? 1:0));
   }
-  std::shared_ptr<Number> operator^=(const int& other) {
+  Number& operator^=(const int& other) {
     return operator^=(Number(other));
   }
 
-  friend std::shared_ptr<Number> operator^=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator^=(std::shared_ptr<Number>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator^=(*rhs);
+    unshare(lhs)->operator^=(*rhs);
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator^=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator^=(std::shared_ptr<Number>& lhs,
     const bool& rhs) {
-    return lhs->operator^=(Number(rhs? 1 : 0));
+    unshare(lhs)->operator^=(Number(rhs? 1 : 0));
+    return lhs;
   }
 
-  friend std::shared_ptr<Number> operator^=(const std::shared_ptr<Number>& lhs,
+  friend std::shared_ptr<Number>& operator^=(std::shared_ptr<Number>& lhs,
     const int& rhs) {
-    return lhs->operator^=(Number(rhs));
+    unshare(lhs)->operator^=(Number(rhs));
+    return lhs;
   }
 
   friend std::shared_ptr<Number> operator~(const std::shared_ptr<Number>& num) {
@@ -1253,39 +1341,194 @@ class Number : public Object {
     return num->operator+();
   }
 
-  friend std::shared_ptr<Number> operator+(const std::shared_ptr<Number>& a,
-                                           const std::shared_ptr<Number>& b) {
-    return *a + *b;
-  }
-
   friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& num) {
     return num->operator-();
   }
 
-  friend std::shared_ptr<Number> operator-(const std::shared_ptr<Number>& a,
-                                           const std::shared_ptr<Number>& b) {
-    return *a - *b;
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const std::shared_ptr<Number>& obj) {
+    return os << *obj;
   }
 
-  friend std::shared_ptr<Number> operator*(const std::shared_ptr<Number>& a,
-                                           const std::shared_ptr<Number>& b) {
-    return *a * *b;
+ private:
+  void assign(const Number& result) {
+    value_ = result.value_;
+    big_ = result.big_;
   }
 
-  friend std::shared_ptr<Number> operator/(const std::shared_ptr<Number>& a,
-                                           const std::shared_ptr<Number>& b) {
-    return *a / *b;
+  template <typename TOperation>
+  static std::shared_ptr<Number> intKernel(const Operand& lhs,
+                                           const Operand& rhs) {
+    return TOperation::ints(lhs.integer, rhs.integer);
   }
 
-  friend std::shared_ptr<Number> operator%(const std::shared_ptr<Number>& a,
-                                           const std::shared_ptr<Number>& b) {
-    return *a % *b;
+  template <typename TOperation>
+  static std::shared_ptr<Number> floatKernel(const Operand& lhs,
+                                             const Operand& rhs) {
+    return std::make_shared<Number>(
+      TOperation::floats(lhs.toDouble(), rhs.toDouble()));
   }
 
-  friend std::ostream& operator<<(std::ostream& os,
-                                  const std::shared_ptr<Number>& obj) {
-    return os << *obj;
+  template <typename TOperation>
+  static std::shared_ptr<Number> bigKernel(const Operand& lhs,
+                                           const Operand& rhs) {
+    return TOperation::big(lhs.toNumber(), rhs.toNumber());
+  }
+
+  bool isNegative() const {
+    return big_ ? big_->isNegative() : getDouble() < 0;
+  }
+
+  // ++ and -- stay in place unless they leave the int64 range
+  void step(int64_t amount) {
+    if (auto* integer = std::get_if<int64_t>(&value_)) {
+      int64_t result = 0;
+      if (!big_ && !__builtin_add_overflow(*integer, amount, &result))
+          [[likely]] {
+        *integer = result;
+        return;
+      }
+      *this += Number(amount);
+      return;
+    }
+    std::get<double>(value_) += static_cast<double>(amount);
+  }
+
+  // Binary operators with a big int operand: a float operand turns the
+  // other one into a float, otherwise both are taken as BigInts
+  template <typename TIntOperation, typename TFloatOperation>
+  std::shared_ptr<Number> bigOperation(const Number& other,
+                                       TIntOperation intOperation,
+                                       TFloatOperation floatOperation) const {
+    if (isDouble() || other.isDouble()) {
+      return std::make_shared<Number>(
+        floatOperation(getDouble(), other.getDouble()));
+    }
+    return std::make_shared<Number>(
+      intOperation(toBigInt(), other.toBigInt()));
+  }
+
+  // Big ints against floats compare through the float value, saturating
+  // when the int is beyond the float range
+  std::strong_ordering compareBig(const Number& other) const {
+    if (!isDouble() && !other.isDouble()) {
+      return toBigInt() <=> other.toBigInt();
+    }
+    const Number& integer = isDouble() ? other : *this;
+    const double floating = isDouble() ? getDouble() : other.getDouble();
+    double value = 0.0;
+    if (std::isnan(floating)) {
+      value = -std::numeric_limits<double>::infinity();
+    } else {
+      try {
+        value = integer.getDouble();
+      } catch (const std::overflow_error&) {
+        value = integer.isNegative() ? -std::numeric_limits<double>::infinity()
+                                     : std::numeric_limits<double>::infinity();
+      }
+    }
+    std::partial_ordering order = isDouble() ? floating <=> value
+                                             : value <=> floating;
+    if (order == std::partial_ordering::less) return std::strong_ordering::less;
+    if (order == std::partial_ordering::greater) {
+      return std::strong_ordering::greater;
+    }
+    return std::strong_ordering::equal;
+  }
+
+  // The right operand of << and >>
+  int64_t shiftCount() const {
+    if (big_) [[unlikely]] {
+      if (big_->isNegative()) {
+        throw std::invalid_argument("negative shift count");
+      }
+      throw std::overflow_error("too many digits in integer");
+    }
+    const int64_t count = std::get<int64_t>(value_);
+    if (count < 0) throw std::invalid_argument("negative shift count");
+    return count;
+  }
+
+  // Python's float %, the result has the sign of the divisor
+  static double floatModulo(double dividend, double divisor) {
+    if (divisor == 0.0) throw std::runtime_error("Division by zero");
+    double remainder = std::fmod(dividend, divisor);
+    if (remainder == 0.0) return std::copysign(0.0, divisor);
+    if ((remainder < 0) != (divisor < 0)) remainder += divisor;
+    return remainder;
+  }
+
+  // Python's float //, taken from the remainder so that a == (a // b) * b +
+  // a % b holds as well as it can
+  static double floatFloorDivide(double dividend, double divisor) {
+    if (divisor == 0.0) throw std::runtime_error("Division by zero");
+    double remainder = std::fmod(dividend, divisor);
+    double quotient = (dividend - remainder) / divisor;
+    if (remainder != 0.0 && (remainder < 0) != (divisor < 0)) quotient -= 1.0;
+    if (quotient == 0.0) return std::copysign(0.0, dividend / divisor);
+    double floored = std::floor(quotient);
+    if (quotient - floored > 0.5) floored += 1.0;
+    return floored;
   }
 };
 
-#endif  // NUMBER_HPP
\ No newline at end of file
+class Bool;
+
+// What the generated code mixes in + - * / % // and **: numbers, bools,
+// handles to either and the bool and int values of the runtime. Bool.hpp
+// adds the numericOperand() of bools.
+template <typename T>
+concept NumericOperand =
+  std::same_as<T, Number> || std::same_as<T, std::shared_ptr<Number>> ||
+  std::same_as<T, Bool> || std::same_as<T, std::shared_ptr<Bool>> ||
+  std::same_as<T, bool> || std::same_as<T, int>;
+
+inline Number::Operand numericOperand(const Number& value) {
+  return value.operand();
+}
+
+inline Number::Operand numericOperand(const std::shared_ptr<Number>& value) {
+  return value->operand();
+}
+
+inline Number::Operand numericOperand(bool value) {
+  return Number::Operand::of(value ? 1 : 0);
+}
+
+inline Number::Operand numericOperand(int value) {
+  return Number::Operand::of(value);
+}
+
+// One template per operator covers every pair of operand kinds, Number op
+// Number keeps calling the members
+template <NumericOperand TLeft, NumericOperand TRight>
+std::shared_ptr<Number> operator+(const TLeft& lhs, const TRight& rhs) {
+  return Number::arithmetic<Number::Addition>(numericOperand(lhs),
+                                              numericOperand(rhs));
+}
+
+template <NumericOperand TLeft, NumericOperand TRight>
+std::shared_ptr<Number> operator-(const TLeft& lhs, const TRight& rhs) {
+  return Number::arithmetic<Number::Subtraction>(numericOperand(lhs),
+                                                 numericOperand(rhs));
+}
+
+template <NumericOperand TLeft, NumericOperand TRight>
+std::shared_ptr<Number> operator*(const TLeft& lhs, const TRight& rhs) {
+  return Number::arithmetic<Number::Multiplication>(numericOperand(lhs),
+                                                    numericOperand(rhs));
+}
+
+template <NumericOperand TLeft, NumericOperand TRight>
+std::shared_ptr<Number> operator/(const TLeft& lhs, const TRight& rhs) {
+  return Number::arithmetic<Number::Division>(numericOperand(lhs),
+                                              numericOperand(rhs));
+}
+
+template <NumericOperand TLeft, NumericOperand TRight>
+std::shared_ptr<Number> operator%(const TLeft& lhs, const TRight& rhs) {
+  return Number::arithmetic<Number::Modulo>(numericOperand(lhs),
+                                            numericOperand(rhs));
+}
+
+#endif  // NUMBER_HPP
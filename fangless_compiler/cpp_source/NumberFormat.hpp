@@ -0,0 +1,154 @@
+#ifndef NUMBER_FORMAT_HPP
+#define NUMBER_FORMAT_HPP
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+// Text of ints and floats as Python's repr writes it. Both writers fill a
+// caller provided buffer of at least BUFFER_SIZE bytes and return the end of
+// the text, so printing and formatting numbers never allocates.
+class NumberFormat {
+ public:
+  // "-9223372036854775808" and "-2.2250738585072014e-308" both fit
+  static constexpr size_t BUFFER_SIZE = 32;
+
+  // Python switches to scientific notation outside [1e-4, 1e16)
+  static constexpr int MIN_FIXED_EXPONENT = -4;
+  static constexpr int MAX_FIXED_EXPONENT = 15;
+
+  // Writes two digits per division, from the last pair to the first
+  static char* writeInteger(char* out, int64_t value) {
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (value < 0) {
+      *out++ = '-';
+      magnitude = 0 - magnitude;
+    }
+
+    char* end = out + countDigits(magnitude);
+    char* cursor = end;
+    while (magnitude >= 100) {
+      const char* pair = DIGIT_PAIRS + (magnitude % 100) * 2;
+      magnitude /= 100;
+      *--cursor = pair[1];
+      *--cursor = pair[0];
+    }
+    if (magnitude >= 10) {
+      const char* pair = DIGIT_PAIRS + magnitude * 2;
+      *--cursor = pair[1];
+      *--cursor = pair[0];
+    } else {
+      *--cursor = static_cast<char>('0' + magnitude);
+    }
+    return end;
+  }
+
+  // Shortest digits that read back as the same double, laid out like
+  // repr(float): "0.1", "1e+16", "1.5e-05", "100.0", "-0.0", "inf"
+  static char* writeFloat(char* out, double value) {
+    if (std::isnan(value)) return copy(out, "nan");
+    if (std::signbit(value)) *out++ = '-';
+    if (std::isinf(value)) return copy(out, "inf");
+
+    // to_chars gives "d[.ddd]e±XX" with the shortest round-trip digits
+    char scientific[BUFFER_SIZE];
+    char* last = std::to_chars(scientific, scientific + BUFFER_SIZE,
+                               std::fabs(value),
+                               std::chars_format::scientific).ptr;
+
+    char digits[BUFFER_SIZE];
+    int digitCount = 0;
+    const char* cursor = scientific;
+    for (; *cursor != 'e'; ++cursor) {
+      if (*cursor != '.') digits[digitCount++] = *cursor;
+    }
+    ++cursor;
+    bool negativeExponent = *cursor++ == '-';
+    int exponent = 0;
+    std::from_chars(cursor, last, exponent);
+    if (negativeExponent) exponent = -exponent;
+
+    if (exponent < MIN_FIXED_EXPONENT || exponent > MAX_FIXED_EXPONENT) {
+      *out++ = digits[0];
+      if (digitCount > 1) {
+        *out++ = '.';
+        out = copy(out, digits + 1, digitCount - 1);
+      }
+      *out++ = 'e';
+      *out++ = negativeExponent ? '-' : '+';
+      if (exponent < 0) exponent = -exponent;
+      if (exponent < 10) *out++ = '0';
+      return writeInteger(out, exponent);
+    }
+
+    if (exponent < 0) {
+      *out++ = '0';
+      *out++ = '.';
+      std::memset(out, '0', -exponent - 1);
+      out += -exponent - 1;
+      return copy(out, digits, digitCount);
+    }
+
+    int integerDigits = exponent + 1;
+    if (digitCount <= integerDigits) {
+      out = copy(out, digits, digitCount);
+      std::memset(out, '0', integerDigits - digitCount);
+      out += integerDigits - digitCount;
+      return copy(out, ".0");
+    }
+    out = copy(out, digits, integerDigits);
+    *out++ = '.';
+    return copy(out, digits + integerDigits, digitCount - integerDigits);
+  }
+
+  static std::string integerText(int64_t value) {
+    char buffer[BUFFER_SIZE];
+    return std::string(buffer, writeInteger(buffer, value));
+  }
+
+  static std::string floatText(double value) {
+    char buffer[BUFFER_SIZE];
+    return std::string(buffer, writeFloat(buffer, value));
+  }
+
+ private:
+  static constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  static int countDigits(uint64_t value) {
+    int digits = 1;
+    while (value >= 10000) {
+      value /= 10000;
+      digits += 4;
+    }
+    if (value >= 1000) return digits + 3;
+    if (value >= 100) return digits + 2;
+    if (value >= 10) return digits + 1;
+    return digits;
+  }
+
+  static char* copy(char* out, const char* text, size_t size) {
+    std::memcpy(out, text, size);
+    return out + size;
+  }
+
+  template <size_t Size>
+  static char* copy(char* out, const char (&text)[Size]) {
+    return copy(out, text, Size - 1);
+  }
+};
+
+#endif  // NUMBER_FORMAT_HPP
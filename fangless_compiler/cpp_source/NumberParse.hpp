@@ -0,0 +1,219 @@
+#ifndef NUMBER_PARSE_HPP
+#define NUMBER_PARSE_HPP
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "BigInt.hpp"
+#include "Number.hpp"
+#include "StringAscii.hpp"
+
+// int() and float() of a string with Python's rules: surrounding whitespace,
+// a sign, single underscores between digits, the 0x/0o/0b prefixes and
+// bases 0 and 2-36 for ints, "inf", "infinity" and "nan" for floats. The
+// text is checked and stripped of underscores here, std::from_chars does
+// the conversion, BigInt takes over for ints beyond 64 bits.
+class NumberParse {
+ public:
+  static constexpr int MIN_BASE = 2;
+  static constexpr int MAX_BASE = 36;
+
+  static std::shared_ptr<Number> parseInt(std::string_view text,
+                                          int base = 10) {
+    if (base != 0 && (base < MIN_BASE || base > MAX_BASE)) {
+      throw std::invalid_argument(
+        "int() base must be >= 2 and <= 36, or 0");
+    }
+
+    std::string_view digits = strip(text);
+    bool negative = takeSign(digits);
+
+    int digitBase = base;
+    bool prefixed = false;
+    if (digits.size() >= 2 && digits[0] == '0') {
+      int prefixBase = baseOfPrefix(digits[1]);
+      if (prefixBase != 0 && (base == 0 || base == prefixBase)) {
+        digitBase = prefixBase;
+        prefixed = true;
+        digits.remove_prefix(2);
+        // the prefix may be followed by an underscore: 0x_ff
+        if (!digits.empty() && digits[0] == '_') digits.remove_prefix(1);
+      }
+    }
+    if (digitBase == 0) {
+      digitBase = 10;
+      // base 0 follows literal syntax, where 010 is not a valid int
+      if (!prefixed && digits.size() > 1 && digits[0] == '0' &&
+          digits.find_first_not_of("0_") != std::string_view::npos) {
+        throw invalidInt(text, base);
+      }
+    }
+
+    std::string_view compact;
+    if (!removeUnderscores(digits, compact, isAlnum)) {
+      throw invalidInt(text, base);
+    }
+
+    uint64_t magnitude = 0;
+    const char* last = compact.data() + compact.size();
+    auto [end, error] =
+      std::from_chars(compact.data(), last, magnitude, digitBase);
+    if (compact.empty() || end != last ||
+        error == std::errc::invalid_argument) {
+      throw invalidInt(text, base);
+    }
+
+    uint64_t limit = static_cast<uint64_t>(
+      std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+    if (error == std::errc::result_out_of_range || magnitude > limit)
+        [[unlikely]] {
+      return Number::spawn(BigInt::fromDigits(compact, digitBase, negative));
+    }
+    return Number::spawn(negative ? static_cast<int64_t>(0 - magnitude)
+                                  : static_cast<int64_t>(magnitude));
+  }
+
+  static double parseFloat(std::string_view text) {
+    std::string_view digits = strip(text);
+    bool negative = takeSign(digits);
+    double sign = negative ? -1.0 : 1.0;
+
+    if (equalsIgnoreCase(digits, "inf") ||
+        equalsIgnoreCase(digits, "infinity")) {
+      return sign * std::numeric_limits<double>::infinity();
+    }
+    if (equalsIgnoreCase(digits, "nan")) {
+      return sign * std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // from_chars also reads inf, nan and nan(...), only plain decimals
+    // reach it
+    std::string_view compact;
+    if (digits.empty() || !(isDigit(digits[0]) || digits[0] == '.') ||
+        !removeUnderscores(digits, compact, isDigit)) {
+      throw invalidFloat(text);
+    }
+
+    double value = 0.0;
+    const char* last = compact.data() + compact.size();
+    auto [end, error] = std::from_chars(compact.data(), last, value,
+                                        std::chars_format::general);
+    if (end != last || error == std::errc::invalid_argument) {
+      throw invalidFloat(text);
+    }
+    if (error == std::errc::result_out_of_range) {
+      // strtod saturates to inf or flushes to zero like Python does
+      value = std::strtod(std::string(compact).c_str(), nullptr);
+    }
+    return sign * value;
+  }
+
+ private:
+  static bool isDigit(char c) { return '0' <= c && c <= '9'; }
+
+  static bool isAlnum(char c) {
+    return isDigit(c) || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+  }
+
+  static std::string_view strip(std::string_view text) {
+    while (!text.empty() && StringAscii::isSpace(text.front())) {
+      text.remove_prefix(1);
+    }
+    while (!text.empty() && StringAscii::isSpace(text.back())) {
+      text.remove_suffix(1);
+    }
+    return text;
+  }
+
+  static bool takeSign(std::string_view& text) {
+    if (text.empty() || (text[0] != '+' && text[0] != '-')) return false;
+    bool negative = text[0] == '-';
+    text.remove_prefix(1);
+    return negative;
+  }
+
+  static int baseOfPrefix(char c) {
+    switch (c) {
+      case 'x': case 'X': return 16;
+      case 'o': case 'O': return 8;
+      case 'b': case 'B': return 2;
+      default: return 0;
+    }
+  }
+
+  static bool equalsIgnoreCase(std::string_view text, std::string_view word) {
+    if (text.size() != word.size()) return false;
+    for (size_t i = 0; i < text.size(); ++i) {
+      if (std::tolower(static_cast<unsigned char>(text[i])) != word[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // An underscore is only valid between two digits. Text without any is
+  // returned as is, otherwise it is copied without them to a reused buffer
+  static bool removeUnderscores(std::string_view text,
+                                std::string_view& compact,
+                                bool (*isDigitOf)(char)) {
+    if (text.find('_') == std::string_view::npos) {
+      compact = text;
+      return true;
+    }
+
+    thread_local std::string buffer;
+    buffer.clear();
+    for (size_t i = 0; i < text.size(); ++i) {
+      if (text[i] != '_') {
+        buffer += text[i];
+        continue;
+      }
+      if (i == 0 || i + 1 == text.size() || !isDigitOf(text[i - 1]) ||
+          !isDigitOf(text[i + 1])) {
+        return false;
+      }
+    }
+    compact = buffer;
+    return true;
+  }
+
+  // repr of the text for the error messages
+  static std::string quote(std::string_view text) {
+    char mark = text.find('\'') != std::string_view::npos &&
+                text.find('"') == std::string_view::npos ? '"' : '\'';
+    std::string quoted(1, mark);
+    for (char c : text) {
+      switch (c) {
+        case '\t': quoted += "\\t"; break;
+        case '\n': quoted += "\\n"; break;
+        case '\r': quoted += "\\r"; break;
+        case '\\': quoted += "\\\\"; break;
+        default:
+          if (c == mark) quoted += '\\';
+          quoted += c;
+      }
+    }
+    return quoted + mark;
+  }
+
+  static std::invalid_argument invalidInt(std::string_view text, int base) {
+    return std::invalid_argument("invalid literal for int() with base " +
+                                 std::to_string(base) + ": " + quote(text));
+  }
+
+  static std::invalid_argument invalidFloat(std::string_view text) {
+    return std::invalid_argument("could not convert string to float: " +
+                                 quote(text));
+  }
+};
+
+#endif  // NUMBER_PARSE_HPP
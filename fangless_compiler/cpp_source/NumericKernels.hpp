@@ -0,0 +1,329 @@
+#ifndef NUMERIC_KERNELS_HPP
+#define NUMERIC_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+// Loops over unboxed numeric buffers. They are written as plain counted
+// loops over __restrict pointers with independent partial results, the
+// shape GCC and Clang vectorize at -O3, so the same source runs 2 to 8
+// lanes wide with whatever SIMD the target has. Integer results are exact:
+// sums and dot products accumulate in 128 bits and elementwise arithmetic
+// wraps around like C's unsigned arithmetic instead of overflowing.
+class NumericKernels {
+ public:
+  // Floats are summed pairwise: blocks of PAIRWISE_BLOCK elements are added
+  // in LANES interleaved partial sums, larger ranges are split in halves.
+  // The rounding error grows with log(n) instead of n, as in numpy.
+  static constexpr size_t LANES = 8;
+  static constexpr size_t PAIRWISE_BLOCK = 128;
+
+  template <typename T>
+  static double floatSum(const T* __restrict data, size_t length) {
+    if (length < LANES) {
+      double total = 0.0;
+      for (size_t i = 0; i < length; ++i) total += data[i];
+      return total;
+    }
+
+    if (length <= PAIRWISE_BLOCK) {
+      double partial[LANES];
+      for (size_t lane = 0; lane < LANES; ++lane) partial[lane] = data[lane];
+
+      size_t i = LANES;
+      for (; i + LANES <= length; i += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+          partial[lane] += data[i + lane];
+        }
+      }
+
+      double total = ((partial[0] + partial[1]) + (partial[2] + partial[3])) +
+                     ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+      for (; i < length; ++i) total += data[i];
+      return total;
+    }
+
+    size_t half = length / 2;
+    half -= half % LANES;
+    return floatSum(data, half) + floatSum(data + half, length - half);
+  }
+
+  // Adds up the floatSum totals of consecutive blocks as a binary counter
+  // does, merging two totals whenever they cover the same number of blocks,
+  // so a buffer streamed a block at a time is still summed pairwise
+  class PairwiseTotal {
+   public:
+    void add(double total) {
+      for (size_t carry = blocks_; carry & 1; carry >>= 1) {
+        total = pending_[--depth_] + total;
+      }
+      pending_[depth_++] = total;
+      ++blocks_;
+    }
+
+    double result() const {
+      double total = 0.0;
+      for (size_t level = depth_; level-- > 0;) total = pending_[level] + total;
+      return total;
+    }
+
+   private:
+    double pending_[64];
+    size_t depth_ = 0;
+    size_t blocks_ = 0;
+  };
+
+  // Exact for every integer buffer shorter than 2^63 elements
+  template <typename T>
+  static __int128 intSum(const T* __restrict data, size_t length) {
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+      // 2^31 elements of 32 bits can not overflow an int64 partial sum
+      constexpr size_t CHUNK = size_t{1} << 31;
+      __int128 total = 0;
+      for (size_t start = 0; start < length; start += CHUNK) {
+        const size_t end = std::min(length, start + CHUNK);
+        int64_t partial = 0;
+        for (size_t i = start; i < end; ++i) partial += data[i];
+        total += partial;
+      }
+      return total;
+    } else {
+      __int128 total = 0;
+      for (size_t i = 0; i < length; ++i) total += data[i];
+      return total;
+    }
+  }
+
+  template <typename T>
+  static bool hasNan(const T* __restrict data, size_t length) {
+    if constexpr (std::is_floating_point_v<T>) {
+      bool found = false;
+      for (size_t i = 0; i < length; ++i) found |= data[i] != data[i];
+      return found;
+    } else {
+      return false;
+    }
+  }
+
+  // Position of the first minimum (or maximum) as Python's min() finds it,
+  // an element replaces the current one only if it is strictly smaller. With
+  // NaNs in the buffer that order matters, so the scan is sequential. The
+  // vectorized scan only finds the value, the first element equal to it is
+  // then searched, which tells 0.0 and -0.0 apart.
+  template <bool MAXIMUM, typename T>
+  static size_t extreme(const T* __restrict data, size_t length) {
+    if (hasNan(data, length)) {
+      size_t best = 0;
+      for (size_t i = 1; i < length; ++i) {
+        if (MAXIMUM ? data[best] < data[i] : data[i] < data[best]) best = i;
+      }
+      return best;
+    }
+
+    T lanes[LANES];
+    std::fill(lanes, lanes + LANES, data[0]);
+    size_t i = 0;
+    for (; i + LANES <= length; i += LANES) {
+      for (size_t lane = 0; lane < LANES; ++lane) {
+        const T value = data[i + lane];
+        lanes[lane] = MAXIMUM ? (lanes[lane] < value ? value : lanes[lane])
+                              : (value < lanes[lane] ? value : lanes[lane]);
+      }
+    }
+    T best = lanes[0];
+    for (size_t lane = 1; lane < LANES; ++lane) {
+      best = MAXIMUM ? std::max(best, lanes[lane])
+                     : std::min(best, lanes[lane]);
+    }
+    for (; i < length; ++i) {
+      best = MAXIMUM ? std::max(best, data[i]) : std::min(best, data[i]);
+    }
+    return find(data, length, best);
+  }
+
+  template <typename T>
+  static size_t count(const T* __restrict data, size_t length, T value) {
+    return countWhere(data, length, [value](T x) { return x == value; });
+  }
+
+  // Blocks of 64 are compared without early exit, only the block holding
+  // the match is scanned again. Returns length when there is no match.
+  template <typename T>
+  static size_t find(const T* __restrict data, size_t length, T value) {
+    return findWhere(data, length, [value](T x) { return x == value; });
+  }
+
+  // The same searches for elements within tolerance of value, the way
+  // Number::equals compares floats
+  static size_t countNear(const double* __restrict data, size_t length,
+                          double value, double tolerance) {
+    return countWhere(data, length, [value, tolerance](double x) {
+      return std::fabs(x - value) < tolerance;
+    });
+  }
+
+  static size_t findNear(const double* __restrict data, size_t length,
+                         double value, double tolerance) {
+    return findWhere(data, length, [value, tolerance](double x) {
+      return std::fabs(x - value) < tolerance;
+    });
+  }
+
+  template <typename T>
+  static double floatDot(const T* __restrict lhs, const T* __restrict rhs,
+                         size_t length) {
+    double partial[LANES] = {};
+    size_t i = 0;
+    for (; i + LANES <= length; i += LANES) {
+      for (size_t lane = 0; lane < LANES; ++lane) {
+        partial[lane] += static_cast<double>(lhs[i + lane]) * rhs[i + lane];
+      }
+    }
+    double total = ((partial[0] + partial[1]) + (partial[2] + partial[3])) +
+                   ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+    for (; i < length; ++i) total += static_cast<double>(lhs[i]) * rhs[i];
+    return total;
+  }
+
+  // Returns false if the total does not fit in 128 bits
+  template <typename T>
+  static bool intDot(const T* __restrict lhs, const T* __restrict rhs,
+                     size_t length, __int128& total) {
+    total = 0;
+    if constexpr (sizeof(T) <= sizeof(int32_t)) {
+      for (size_t i = 0; i < length; ++i) {
+        total += static_cast<int64_t>(lhs[i]) * rhs[i];
+      }
+      return true;
+    } else {
+      for (size_t i = 0; i < length; ++i) {
+        const __int128 product = static_cast<__int128>(lhs[i]) * rhs[i];
+        if (__builtin_add_overflow(total, product, &total)) return false;
+      }
+      return true;
+    }
+  }
+
+  template <typename T, typename TTotal>
+  static void cumulativeSum(TTotal* __restrict out, const T* __restrict data,
+                            size_t length) {
+    TTotal total = 0;
+    for (size_t i = 0; i < length; ++i) {
+      total = wrap<TTotal>(total, data[i], std::plus<>());
+      out[i] = total;
+    }
+  }
+
+  struct Add {
+    template <typename T>
+    T operator()(T lhs, T rhs) const {
+      return wrap<T>(lhs, rhs, std::plus<>());
+    }
+  };
+
+  struct Subtract {
+    template <typename T>
+    T operator()(T lhs, T rhs) const {
+      return wrap<T>(lhs, rhs, std::minus<>());
+    }
+  };
+
+  struct Multiply {
+    template <typename T>
+    T operator()(T lhs, T rhs) const {
+      return wrap<T>(lhs, rhs, std::multiplies<>());
+    }
+  };
+
+  template <typename T, typename TOperation>
+  static void elementwise(T* __restrict out, const T* __restrict lhs,
+                          const T* __restrict rhs, size_t length,
+                          TOperation operation) {
+    for (size_t i = 0; i < length; ++i) out[i] = operation(lhs[i], rhs[i]);
+  }
+
+  template <typename T, typename TOperation>
+  static void elementwise(T* __restrict out, const T* __restrict lhs, T rhs,
+                          size_t length, TOperation operation) {
+    for (size_t i = 0; i < length; ++i) out[i] = operation(lhs[i], rhs);
+  }
+
+  template <typename T, typename TOperation>
+  static void elementwise(T* __restrict out, T lhs, const T* __restrict rhs,
+                          size_t length, TOperation operation) {
+    for (size_t i = 0; i < length; ++i) out[i] = operation(lhs, rhs[i]);
+  }
+
+  // The comparisons write a mask of one bool per element
+  template <typename T, typename TCompare>
+  static void mask(bool* __restrict out, const T* __restrict lhs,
+                   const T* __restrict rhs, size_t length, TCompare compare) {
+    for (size_t i = 0; i < length; ++i) out[i] = compare(lhs[i], rhs[i]);
+  }
+
+  template <typename T, typename TCompare>
+  static void mask(bool* __restrict out, const T* __restrict lhs, T rhs,
+                   size_t length, TCompare compare) {
+    for (size_t i = 0; i < length; ++i) out[i] = compare(lhs[i], rhs);
+  }
+
+  template <typename T, typename TCompare>
+  static void mask(bool* __restrict out, T lhs, const T* __restrict rhs,
+                   size_t length, TCompare compare) {
+    for (size_t i = 0; i < length; ++i) out[i] = compare(lhs, rhs[i]);
+  }
+
+  // Element by element conversion, e.g. to widen an operand before mixing it
+  // with a wider type
+  template <typename TTo, typename TFrom>
+  static void convert(TTo* __restrict out, const TFrom* __restrict data,
+                      size_t length) {
+    for (size_t i = 0; i < length; ++i) out[i] = static_cast<TTo>(data[i]);
+  }
+
+ private:
+  template <typename T, typename TMatch>
+  static size_t countWhere(const T* __restrict data, size_t length,
+                           TMatch matches) {
+    size_t total = 0;
+    for (size_t i = 0; i < length; ++i) total += matches(data[i]);
+    return total;
+  }
+
+  template <typename T, typename TMatch>
+  static size_t findWhere(const T* __restrict data, size_t length,
+                          TMatch matches) {
+    constexpr size_t BLOCK = 64;
+    size_t start = 0;
+    for (; start + BLOCK <= length; start += BLOCK) {
+      bool found = false;
+      for (size_t i = start; i < start + BLOCK; ++i) found |= matches(data[i]);
+      if (found) break;
+    }
+    for (size_t i = start; i < length; ++i) {
+      if (matches(data[i])) return i;
+    }
+    return length;
+  }
+
+  // Signed overflow is undefined, integers are operated on as unsigned and
+  // converted back, which wraps around modulo 2^bits. The narrow types would
+  // be promoted to int, they are widened to unsigned int instead.
+  template <typename T, typename TOperation>
+  static T wrap(T lhs, T rhs, TOperation operation) {
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+      using Unsigned = std::conditional_t<sizeof(T) < sizeof(unsigned),
+                                          unsigned, std::make_unsigned_t<T>>;
+      return static_cast<T>(static_cast<Unsigned>(
+          operation(static_cast<Unsigned>(lhs), static_cast<Unsigned>(rhs))));
+    } else {
+      return static_cast<T>(operation(lhs, rhs));
+    }
+  }
+};
+
+#endif  // NUMERIC_KERNELS_HPP
@@ -48,7 +48,21 @@ class Object {
 
   virtual std::shared_ptr<Tuple> asTuple() const {
     throw std::runtime_error("Cannot convert to tuple");
-  } 
+  }
+
+  // x[i] where x is only known to be an object, such as a list element
+  // handed to a key function. Containers answer with their own indexing
+  virtual std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const {
+    (void)index;
+    throw std::runtime_error("'" + type() + "' object is not subscriptable");
+  }
+
+  template <typename TIndex>
+  std::shared_ptr<Object> operator[](
+      const std::shared_ptr<TIndex>& index) const {
+    return getItem(index);
+  }
 
   // explicit operator bool() const { return toBool(); }
   // operator std::string() const { return toString(); }
@@ -70,8 +84,19 @@ class Object {
     return compare(*other);
   }
 
+  // ints, floats and bools order by their value, so 1, 1.0 and True are
+  // one key of a dict or set as in Python
+  static bool isNumeric(const Object& object) {
+    const std::string objectType = object.type();
+    return objectType == "int" || objectType == "float" ||
+           objectType == "Bool";
+  }
+
   std::strong_ordering operator<=>(const Object& other) const {
-    if (type() != other.type()) return Object::compare(other);
+    if (type() != other.type()) {
+      if (isNumeric(*this) && isNumeric(other)) return compare(other);
+      return Object::compare(other);
+    }
     return compare(other);
   }
 
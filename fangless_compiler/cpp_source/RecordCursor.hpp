@@ -0,0 +1,109 @@
+#ifndef RECORD_CURSOR_HPP
+#define RECORD_CURSOR_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "List.hpp"
+#include "Object.hpp"
+#include "Tuple.hpp"
+
+// Fields of the current record of a 'for a, b, ... in source' loop. Tuples
+// are read in place, so no record is copied and no index is boxed per
+// field, any other record goes through its tuple conversion.
+class RecordFields {
+  size_t arity_;
+  std::shared_ptr<Object> record_;
+  std::shared_ptr<Tuple> converted_;
+  const std::vector<std::shared_ptr<Object>>* fields_ = nullptr;
+
+ protected:
+  explicit RecordFields(size_t arity) : arity_(arity) {}
+
+  // Makes record the current one, checking it holds arity fields
+  void unpack(const std::shared_ptr<Object>& record) {
+    record_ = record;
+    if (auto* tuple = dynamic_cast<const Tuple*>(record_.get())) {
+      fields_ = &tuple->getElements();
+    } else {
+      converted_ = record_->asTuple();
+      fields_ = &converted_->getElements();
+    }
+
+    checkArity(arity_, fields_->size());
+  }
+
+ public:
+  // Throws Python's error for unpacking a record of size fields into arity
+  // names
+  static void checkArity(size_t arity, size_t size) {
+    if (size > arity) {
+      throw std::runtime_error("too many values to unpack (expected " +
+                               std::to_string(arity) + ")");
+    }
+    if (size < arity) {
+      throw std::runtime_error("not enough values to unpack (expected " +
+                               std::to_string(arity) + ", got " +
+                               std::to_string(size) + ")");
+    }
+  }
+
+  const std::shared_ptr<Object>& field(size_t index) const {
+    return (*fields_)[index];
+  }
+};
+
+// Walks the records of the source one at a time, a record is only unpacked
+// when the loop reaches it
+template <typename TSource>
+class RecordCursor : public RecordFields {
+  using TIterator = decltype(std::declval<TSource&>().begin());
+
+  std::shared_ptr<TSource> source_;
+  TIterator current_;
+  TIterator end_;
+  bool started_ = false;
+
+ public:
+  RecordCursor(std::shared_ptr<TSource> source, size_t arity)
+      : RecordFields(arity),
+        source_(std::move(source)),
+        current_(source_->begin()),
+        end_(source_->end()) {}
+
+  // Moves to the next record, false once the source is exhausted
+  bool next() {
+    if (started_) ++current_;
+    started_ = true;
+    if (current_ == end_) return false;
+
+    unpack(*current_);
+    return true;
+  }
+};
+
+// A list is walked by position and its length is read on every step, so the
+// loop sees the elements its body appends or replaces, as a Python list
+// iterator does
+template <>
+class RecordCursor<List> : public RecordFields {
+  std::shared_ptr<const List> list_;
+  size_t position_ = 0;
+
+ public:
+  RecordCursor(std::shared_ptr<const List> list, size_t arity)
+      : RecordFields(arity), list_(std::move(list)) {}
+
+  bool next() {
+    const auto& elements = list_->getElements();
+    if (position_ >= elements.size()) return false;
+
+    unpack(elements[position_++]);
+    return true;
+  }
+};
+
+#endif  // RECORD_CURSOR_HPP
@@ -384,7 +384,7 @@ class Set final : public Object {
     return result;
   }
 
-  std::shared_ptr<Set> operator|=(const Set& other) {
+  Set& operator|=(const Set& other) {
     std::vector<std::shared_ptr<Object>> temp;
 
     std::ranges::set_union(elements_, other.elements_,
@@ -392,7 +392,7 @@ class Set final : public Object {
 
     elements_.clear();
     elements_.insert(temp.begin(), temp.end());
-    return std::shared_ptr<Set>(this, [](Set*) {});
+    return *this;
   }
 
   std::shared_ptr<Set> operator&(const Set& other) const {
@@ -404,14 +404,14 @@ class Set final : public Object {
     result->elements_.insert(temp.begin(), temp.end());
     return result;
   }
-  std::shared_ptr<Set> operator&=(const Set& other) {
+  Set& operator&=(const Set& other) {
     std::vector<std::shared_ptr<Object>> temp;
 
     std::ranges::set_intersection(elements_, other.elements_,
                                   std::back_inserter(temp));
     elements_.clear();
     elements_.insert(temp.begin(), temp.end());
-    return std::shared_ptr<Set>(this, [](Set*) {});
+    return *this;
   }
 
   std::shared_ptr<Set> operator^(const Set& other) const {
@@ -424,14 +424,14 @@ class Set final : public Object {
     return result;
   }
 
-  std::shared_ptr<Set> operator^=(const Set& other) {
+  Set& operator^=(const Set& other) {
     std::vector<std::shared_ptr<Object>> temp;
 
     std::ranges::set_symmetric_difference(elements_, other.elements_,
                                           std::back_inserter(temp));
     elements_.clear();
     elements_.insert(temp.begin(), temp.end());
-    return std::shared_ptr<Set>(this, [](Set*) {});
+    return *this;
   }
 
   std::shared_ptr<Set> operator-(const Set& other) const {
@@ -444,13 +444,13 @@ class Set final : public Object {
     return result;
   }
 
-  std::shared_ptr<Set> operator-=(const Set& other) {
+  Set& operator-=(const Set& other) {
     std::vector<std::shared_ptr<Object>> temp;
     std::ranges::set_difference(elements_, other.elements_,
                                 std::back_inserter(temp));
     elements_.clear();
     elements_.insert(temp.begin(), temp.end());
-    return std::shared_ptr<Set>(this, [](Set*) {});
+    return *this;
   }
 
   friend std::ostream& operator<<(std::ostream& os,
@@ -483,24 +483,36 @@ class Set final : public Object {
     return *a - *b;
   }
 
-  friend std::shared_ptr<Set> operator+=(const std::shared_ptr<Set>& a,
-                                         const std::shared_ptr<Set>& b) {
-    return *a |= *b;
+  // Sets are mutable, x |= y and the other augmented assignments change
+  // the set every name bound to it sees
+  friend std::shared_ptr<Set>& operator|=(std::shared_ptr<Set>& a,
+                                          const std::shared_ptr<Set>& b) {
+    *a |= *b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator-=(const std::shared_ptr<Set>& a,
-                                         const std::shared_ptr<Set>& b) {
-    return *a -= *b;
+  friend std::shared_ptr<Set>& operator+=(std::shared_ptr<Set>& a,
+                                          const std::shared_ptr<Set>& b) {
+    *a |= *b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator^=(const std::shared_ptr<Set>& a,
-                                         const std::shared_ptr<Set>& b) {
-    return *a ^= *b;
+  friend std::shared_ptr<Set>& operator-=(std::shared_ptr<Set>& a,
+                                          const std::shared_ptr<Set>& b) {
+    *a -= *b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator&=(const std::shared_ptr<Set>& a,
-                                         const std::shared_ptr<Set>& b) {
-    return *a &= *b;
+  friend std::shared_ptr<Set>& operator^=(std::shared_ptr<Set>& a,
+                                          const std::shared_ptr<Set>& b) {
+    *a ^= *b;
+    return a;
+  }
+
+  friend std::shared_ptr<Set>& operator&=(std::shared_ptr<Set>& a,
+                                          const std::shared_ptr<Set>& b) {
+    *a &= *b;
+    return a;
   }
 
   friend std::shared_ptr<Set> operator|(const std::shared_ptr<Set>& a,
@@ -528,24 +540,34 @@ class Set final : public Object {
     return *a - b;
   }
 
-  friend std::shared_ptr<Set> operator+=(const std::shared_ptr<Set>& a,
-                                         const Set& b) {
-    return *a |= b;
+  friend std::shared_ptr<Set>& operator|=(std::shared_ptr<Set>& a,
+                                          const Set& b) {
+    *a |= b;
+    return a;
+  }
+
+  friend std::shared_ptr<Set>& operator+=(std::shared_ptr<Set>& a,
+                                          const Set& b) {
+    *a |= b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator-=(const std::shared_ptr<Set>& a,
-                                         const Set& b) {
-    return *a -= b;
+  friend std::shared_ptr<Set>& operator-=(std::shared_ptr<Set>& a,
+                                          const Set& b) {
+    *a -= b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator^=(const std::shared_ptr<Set>& a,
-                                         const Set& b) {
-    return *a ^= b;
+  friend std::shared_ptr<Set>& operator^=(std::shared_ptr<Set>& a,
+                                          const Set& b) {
+    *a ^= b;
+    return a;
   }
 
-  friend std::shared_ptr<Set> operator&=(const std::shared_ptr<Set>& a,
-                                         const Set& b) {
-    return *a &= b;
+  friend std::shared_ptr<Set>& operator&=(std::shared_ptr<Set>& a,
+                                          const Set& b) {
+    *a &= b;
+    return a;
   }
 };
 
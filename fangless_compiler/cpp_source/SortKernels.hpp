@@ -0,0 +1,847 @@
+#ifndef SORT_KERNELS_HPP
+#define SORT_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Sorts of unboxed keys, each paired with the rank of its element so the
+// caller can put the elements in order afterwards. Ranks are distinct and
+// break every tie, which makes the unstable algorithms below give the
+// stable order Python promises:
+//  - radixSort, LSD radix sort of 64 bit keys, for ints
+//  - pdqsort, pattern-defeating quicksort with branchless block
+//    partitioning (Orson Peters' design), for floats
+//  - multikeySort, multikey quicksort (Bentley and Sedgewick), for strings
+// Input made of a few presorted runs skips them and is merged by timsort,
+// which also sorts any other elements, given only a less than comparison.
+class SortKernels {
+ public:
+  template <typename TKey>
+  struct Record {
+    TKey key;
+    size_t rank;
+  };
+
+  // Ints map to keys that order the same as unsigned numbers
+  static uint64_t intKey(int64_t value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t{1} << 63);
+  }
+
+  // One pass counts the digits of every byte position, then only the
+  // positions where keys differ are scattered. Equal keys keep their order.
+  static void radixSort(std::vector<Record<uint64_t>>& records) {
+    constexpr int DIGIT_BITS = 8;
+    constexpr size_t RADIX = size_t{1} << DIGIT_BITS;
+    constexpr int PASSES = 64 / DIGIT_BITS;
+
+    const size_t length = records.size();
+    if (length < 2 || mergeRuns(records.data(), length, keyLess)) return;
+
+    std::vector<std::array<size_t, RADIX>> counts(PASSES);
+    for (const auto& record : records) {
+      for (int pass = 0; pass < PASSES; ++pass) {
+        ++counts[pass][(record.key >> (pass * DIGIT_BITS)) & (RADIX - 1)];
+      }
+    }
+
+    std::vector<Record<uint64_t>> buffer(length);
+    Record<uint64_t>* from = records.data();
+    Record<uint64_t>* to = buffer.data();
+    for (int pass = 0; pass < PASSES; ++pass) {
+      const int shift = pass * DIGIT_BITS;
+      auto& offsets = counts[pass];
+      if (offsets[(from[0].key >> shift) & (RADIX - 1)] == length) continue;
+
+      size_t total = 0;
+      for (size_t& offset : offsets) {
+        const size_t count = offset;
+        offset = total;
+        total += count;
+      }
+      for (size_t i = 0; i < length; ++i) {
+        to[offsets[(from[i].key >> shift) & (RADIX - 1)]++] = from[i];
+      }
+      std::swap(from, to);
+    }
+    if (from != records.data()) std::copy(from, from + length, records.data());
+  }
+
+  // NaNs are not ordered with anything, they go after every number, in
+  // their order. Ties between 0.0 and -0.0 go by rank.
+  static void pdqsort(std::vector<Record<double>>& records) {
+    const auto isNumber = [](const Record<double>& record) {
+      return !std::isnan(record.key);
+    };
+    auto numbers = records.end();
+    if (!std::all_of(records.begin(), records.end(), isNumber)) {
+      numbers = std::stable_partition(records.begin(), records.end(), isNumber);
+    }
+
+    const auto less = [](const Record<double>& lhs,
+                         const Record<double>& rhs) {
+      return (lhs.key < rhs.key) |
+             ((lhs.key == rhs.key) & (lhs.rank < rhs.rank));
+    };
+    const size_t length = numbers - records.begin();
+    if (length < 2 || mergeRuns(records.data(), length, keyLess)) return;
+    Pdq<Record<double>, decltype(less)>::loop(
+        records.data(), records.data() + length, less,
+        static_cast<int>(std::bit_width(length)) - 1, true);
+  }
+
+  // Strings order by their UTF-8 bytes, which is the order of their code
+  // points
+  static void multikeySort(std::vector<Record<std::string_view>>& records) {
+    if (mergeRuns(records.data(), records.size(), keyLess)) return;
+    multikey(records.data(), records.size(), 0);
+  }
+
+  // Stable sort of items by less, comparing elements only with it
+  template <typename T, typename TLess>
+  static void timsort(std::vector<T>& items, TLess less) {
+    Tim<T, TLess>(items.data(), less).sort(items.size());
+  }
+
+ private:
+  static constexpr size_t MULTIKEY_INSERTION_THRESHOLD = 12;
+  static constexpr size_t MAX_PRESORTED_RUNS = 16;
+
+  // Records start in rank order, so comparing keys alone keeps ties stable
+  // in a stable sort
+  static constexpr auto keyLess = [](const auto& lhs, const auto& rhs) {
+    return lhs.key < rhs.key;
+  };
+
+  // Timsorts the records when they are at most MAX_PRESORTED_RUNS
+  // ascending or strictly descending runs, which it merges in close to
+  // linear time. Returns false, leaving them as they were, otherwise.
+  template <typename T, typename TLess>
+  static bool mergeRuns(T* records, size_t length, TLess less) {
+    size_t runs = 0;
+    for (size_t start = 0; start < length;) {
+      if (++runs > MAX_PRESORTED_RUNS) return false;
+      size_t end = start + 1;
+      if (end < length && less(records[end], records[start])) {
+        while (end < length && less(records[end], records[end - 1])) ++end;
+      } else {
+        while (end < length && !less(records[end], records[end - 1])) ++end;
+      }
+      start = end;
+    }
+    Tim<T, TLess>(records, less).sort(length);
+    return true;
+  }
+
+  using TextRecord = Record<std::string_view>;
+
+  // -1 once the string has ended, so shorter strings come first
+  static int byteAt(const TextRecord& record, size_t depth) {
+    return depth < record.key.size()
+               ? static_cast<unsigned char>(record.key[depth])
+               : -1;
+  }
+
+  static bool textLess(const TextRecord& lhs, const TextRecord& rhs,
+                       size_t depth) {
+    const auto order = lhs.key.substr(depth) <=> rhs.key.substr(depth);
+    if (order != 0) return order < 0;
+    return lhs.rank < rhs.rank;
+  }
+
+  // The records agree on their first depth bytes. Each round splits them
+  // three ways on the byte at depth, the middle part moves to the next byte
+  static void multikey(TextRecord* records, size_t length, size_t depth) {
+    while (length > 1) {
+      if (length < MULTIKEY_INSERTION_THRESHOLD) {
+        std::sort(records, records + length,
+                  [depth](const TextRecord& lhs, const TextRecord& rhs) {
+                    return textLess(lhs, rhs, depth);
+                  });
+        return;
+      }
+
+      const int first = byteAt(records[0], depth);
+      const int middle = byteAt(records[length / 2], depth);
+      const int last = byteAt(records[length - 1], depth);
+      const int pivot = std::max(std::min(first, middle),
+                                 std::min(std::max(first, middle), last));
+
+      size_t less = 0;
+      size_t greater = length;
+      for (size_t i = 0; i < greater;) {
+        const int byte = byteAt(records[i], depth);
+        if (byte < pivot) {
+          std::swap(records[less++], records[i++]);
+        } else if (byte > pivot) {
+          std::swap(records[i], records[--greater]);
+        } else {
+          ++i;
+        }
+      }
+
+      multikey(records, less, depth);
+      multikey(records + greater, length - greater, depth);
+
+      // The middle strings all ended here, so they are equal
+      if (pivot == -1) {
+        std::sort(records + less, records + greater,
+                  [](const TextRecord& lhs, const TextRecord& rhs) {
+                    return lhs.rank < rhs.rank;
+                  });
+        return;
+      }
+      records += less;
+      length = greater - less;
+      ++depth;
+    }
+  }
+
+  template <typename T, typename TLess>
+  struct Pdq {
+    static constexpr ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+    static constexpr ptrdiff_t NINTHER_THRESHOLD = 128;
+    static constexpr size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    static void insertionSort(T* begin, T* end, TLess less) {
+      if (begin == end) return;
+      for (T* current = begin + 1; current != end; ++current) {
+        T* sift = current;
+        T* previous = current - 1;
+        if (less(*sift, *previous)) {
+          T value = std::move(*sift);
+          do {
+            *sift-- = std::move(*previous);
+          } while (sift != begin && less(value, *--previous));
+          *sift = std::move(value);
+        }
+      }
+    }
+
+    // The element before begin is not greater than any in the range, so
+    // the scans need no bound check
+    static void unguardedInsertionSort(T* begin, T* end, TLess less) {
+      if (begin == end) return;
+      for (T* current = begin + 1; current != end; ++current) {
+        T* sift = current;
+        T* previous = current - 1;
+        if (less(*sift, *previous)) {
+          T value = std::move(*sift);
+          do {
+            *sift-- = std::move(*previous);
+          } while (less(value, *--previous));
+          *sift = std::move(value);
+        }
+      }
+    }
+
+    // Gives up once more than PARTIAL_INSERTION_SORT_LIMIT elements moved,
+    // returns whether the range ended up sorted
+    static bool partialInsertionSort(T* begin, T* end, TLess less) {
+      if (begin == end) return true;
+      size_t moved = 0;
+      for (T* current = begin + 1; current != end; ++current) {
+        T* sift = current;
+        T* previous = current - 1;
+        if (less(*sift, *previous)) {
+          T value = std::move(*sift);
+          do {
+            *sift-- = std::move(*previous);
+          } while (sift != begin && less(value, *--previous));
+          *sift = std::move(value);
+          moved += current - sift;
+        }
+        if (moved > PARTIAL_INSERTION_SORT_LIMIT) return false;
+      }
+      return true;
+    }
+
+    static void sort2(T* a, T* b, TLess less) {
+      if (less(*b, *a)) std::iter_swap(a, b);
+    }
+
+    static void sort3(T* a, T* b, T* c, TLess less) {
+      sort2(a, b, less);
+      sort2(b, c, less);
+      sort2(a, b, less);
+    }
+
+    static void swapOffsets(T* first, T* last, const unsigned char* left,
+                            const unsigned char* right, size_t count,
+                            bool useSwaps) {
+      if (useSwaps) {
+        for (size_t i = 0; i < count; ++i) {
+          std::iter_swap(first + left[i], last - right[i]);
+        }
+      } else if (count > 0) {
+        // A cycle of moves instead of swaps
+        T* l = first + left[0];
+        T* r = last - right[0];
+        T value = std::move(*l);
+        *l = std::move(*r);
+        for (size_t i = 1; i < count; ++i) {
+          l = first + left[i];
+          *r = std::move(*l);
+          r = last - right[i];
+          *l = std::move(*r);
+        }
+        *r = std::move(value);
+      }
+    }
+
+    // Partitions around *begin into elements less than it and the rest.
+    // Blocks of BLOCK_SIZE elements are compared from both ends and the
+    // offsets of misplaced ones recorded without branching, then swapped.
+    // Returns the pivot's final position and whether no element had to move.
+    static std::pair<T*, bool> partitionRight(T* begin, T* end, TLess less) {
+      T pivot = std::move(*begin);
+      T* first = begin;
+      T* last = end;
+
+      // The median of three guarantees an element not less than the pivot
+      // at the end, so the first scan needs no bound check
+      while (less(*++first, pivot)) {
+      }
+      if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot)) {
+        }
+      } else {
+        while (!less(*--last, pivot)) {
+        }
+      }
+
+      const bool alreadyPartitioned = first >= last;
+      if (!alreadyPartitioned) {
+        std::iter_swap(first, last);
+        ++first;
+
+        unsigned char leftOffsets[BLOCK_SIZE];
+        unsigned char rightOffsets[BLOCK_SIZE];
+        T* leftBase = first;
+        T* rightBase = last;
+        size_t leftCount = 0, rightCount = 0;
+        size_t leftStart = 0, rightStart = 0;
+
+        while (first < last) {
+          const size_t unknown = last - first;
+          const size_t leftSplit =
+              leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown) : 0;
+          const size_t rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+
+          const size_t leftBlock = std::min(leftSplit, BLOCK_SIZE);
+          for (size_t i = 0; i < leftBlock; ++i) {
+            leftOffsets[leftCount] = static_cast<unsigned char>(i);
+            leftCount += !less(*first, pivot);
+            ++first;
+          }
+          const size_t rightBlock = std::min(rightSplit, BLOCK_SIZE);
+          for (size_t i = 0; i < rightBlock;) {
+            rightOffsets[rightCount] = static_cast<unsigned char>(++i);
+            rightCount += less(*--last, pivot);
+          }
+
+          const size_t count = std::min(leftCount, rightCount);
+          swapOffsets(leftBase, rightBase, leftOffsets + leftStart,
+                      rightOffsets + rightStart, count,
+                      leftCount == rightCount);
+          leftCount -= count;
+          rightCount -= count;
+          leftStart += count;
+          rightStart += count;
+          if (leftCount == 0) {
+            leftStart = 0;
+            leftBase = first;
+          }
+          if (rightCount == 0) {
+            rightStart = 0;
+            rightBase = last;
+          }
+        }
+
+        // One side may still hold misplaced elements, they go next to the
+        // boundary
+        if (leftCount > 0) {
+          while (leftCount-- > 0) {
+            std::iter_swap(leftBase + leftOffsets[leftStart + leftCount],
+                           --last);
+          }
+          first = last;
+        }
+        if (rightCount > 0) {
+          while (rightCount-- > 0) {
+            std::iter_swap(rightBase - rightOffsets[rightStart + rightCount],
+                           first);
+            ++first;
+          }
+          last = first;
+        }
+      }
+
+      T* pivotPosition = first - 1;
+      *begin = std::move(*pivotPosition);
+      *pivotPosition = std::move(pivot);
+      return {pivotPosition, alreadyPartitioned};
+    }
+
+    // Puts the elements equal to the pivot on its left, used when the pivot
+    // equals the element before the range, so no element is smaller
+    static T* partitionLeft(T* begin, T* end, TLess less) {
+      T pivot = std::move(*begin);
+      T* first = begin;
+      T* last = end;
+
+      while (less(pivot, *--last)) {
+      }
+      if (last + 1 == end) {
+        while (first < last && !less(pivot, *++first)) {
+        }
+      } else {
+        while (!less(pivot, *++first)) {
+        }
+      }
+
+      while (first < last) {
+        std::iter_swap(first, last);
+        while (less(pivot, *--last)) {
+        }
+        while (!less(pivot, *++first)) {
+        }
+      }
+
+      *begin = std::move(*last);
+      *last = std::move(pivot);
+      return last;
+    }
+
+    // Sorts [begin, end). badAllowed counts the unbalanced partitions left
+    // before falling back to heapsort, leftmost is whether the range starts
+    // the buffer (otherwise the element before it bounds it from below).
+    static void loop(T* begin, T* end, TLess less, int badAllowed,
+                     bool leftmost) {
+      while (true) {
+        const ptrdiff_t size = end - begin;
+        if (size < INSERTION_SORT_THRESHOLD) {
+          if (leftmost) {
+            insertionSort(begin, end, less);
+          } else {
+            unguardedInsertionSort(begin, end, less);
+          }
+          return;
+        }
+
+        // Median of three, or Tukey's ninther for large ranges, as pivot
+        const ptrdiff_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+          sort3(begin, begin + half, end - 1, less);
+          sort3(begin + 1, begin + (half - 1), end - 2, less);
+          sort3(begin + 2, begin + (half + 1), end - 3, less);
+          sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+          std::iter_swap(begin, begin + half);
+        } else {
+          sort3(begin + half, begin, end - 1, less);
+        }
+
+        if (!leftmost && !less(*(begin - 1), *begin)) {
+          begin = partitionLeft(begin, end, less) + 1;
+          continue;
+        }
+
+        auto [pivot, alreadyPartitioned] = partitionRight(begin, end, less);
+        const ptrdiff_t leftSize = pivot - begin;
+        const ptrdiff_t rightSize = end - (pivot + 1);
+
+        if (leftSize < size / 8 || rightSize < size / 8) {
+          if (--badAllowed == 0) {
+            std::make_heap(begin, end, less);
+            std::sort_heap(begin, end, less);
+            return;
+          }
+
+          // Shuffle a few elements to break the pattern that caused it
+          if (leftSize >= INSERTION_SORT_THRESHOLD) {
+            std::iter_swap(begin, begin + leftSize / 4);
+            std::iter_swap(pivot - 1, pivot - leftSize / 4);
+            if (leftSize > NINTHER_THRESHOLD) {
+              std::iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+              std::iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+              std::iter_swap(pivot - 2, pivot - (leftSize / 4 + 1));
+              std::iter_swap(pivot - 3, pivot - (leftSize / 4 + 2));
+            }
+          }
+          if (rightSize >= INSERTION_SORT_THRESHOLD) {
+            std::iter_swap(pivot + 1, pivot + (1 + rightSize / 4));
+            std::iter_swap(end - 1, end - rightSize / 4);
+            if (rightSize > NINTHER_THRESHOLD) {
+              std::iter_swap(pivot + 2, pivot + (2 + rightSize / 4));
+              std::iter_swap(pivot + 3, pivot + (3 + rightSize / 4));
+              std::iter_swap(end - 2, end - (1 + rightSize / 4));
+              std::iter_swap(end - 3, end - (2 + rightSize / 4));
+            }
+          }
+        } else if (alreadyPartitioned &&
+                   partialInsertionSort(begin, pivot, less) &&
+                   partialInsertionSort(pivot + 1, end, less)) {
+          // A sorted looking range that insertion sort finished cheaply
+          return;
+        }
+
+        loop(begin, pivot, less, badAllowed, leftmost);
+        begin = pivot + 1;
+        leftmost = false;
+      }
+    }
+  };
+
+  // Timsort (Tim Peters' listsort, as in CPython): natural runs are found
+  // and extended to minRun elements by binary insertion, then merged while
+  // the stack of pending run lengths keeps its invariants. A merge that
+  // keeps taking from the same side switches to galloping, exponential
+  // searches that move whole stretches at once.
+  template <typename T, typename TLess>
+  struct Tim {
+    static constexpr size_t MIN_MERGE = 64;
+    static constexpr size_t MIN_GALLOP = 7;
+
+    struct Run {
+      size_t base;
+      size_t length;
+    };
+
+    T* items;
+    TLess less;
+    size_t minGallop = MIN_GALLOP;
+    std::vector<Run> runs;
+    std::vector<T> buffer;
+
+    Tim(T* items, TLess less) : items(items), less(less) {}
+
+    void sort(size_t length) {
+      if (length < 2) return;
+      const size_t minRun = minRunLength(length);
+      for (size_t low = 0; low < length;) {
+        size_t run = countRun(items + low, items + length);
+        if (run < minRun) {
+          const size_t forced = std::min(minRun, length - low);
+          binaryInsertionSort(items + low, items + low + run,
+                              items + low + forced);
+          run = forced;
+        }
+        runs.push_back({low, run});
+        mergeCollapse();
+        low += run;
+      }
+      while (runs.size() > 1) {
+        size_t n = runs.size() - 2;
+        if (n > 0 && runs[n - 1].length < runs[n + 1].length) --n;
+        mergeAt(n);
+      }
+    }
+
+    // Between MIN_MERGE / 2 and MIN_MERGE, chosen so that length / minRun
+    // is a power of two or a little less
+    static size_t minRunLength(size_t length) {
+      size_t odd = 0;
+      while (length >= MIN_MERGE) {
+        odd |= length & 1;
+        length >>= 1;
+      }
+      return length + odd;
+    }
+
+    // Length of the run at begin, a strictly descending one is reversed.
+    // Strictness keeps equal elements in their order.
+    size_t countRun(T* begin, T* end) {
+      T* current = begin + 1;
+      if (current == end) return 1;
+      if (less(*current, *begin)) {
+        while (++current != end && less(*current, *(current - 1))) {
+        }
+        std::reverse(begin, current);
+      } else {
+        while (++current != end && !less(*current, *(current - 1))) {
+        }
+      }
+      return current - begin;
+    }
+
+    // [begin, sorted) is sorted, the rest is inserted after its equals
+    void binaryInsertionSort(T* begin, T* sorted, T* end) {
+      for (; sorted != end; ++sorted) {
+        T value = std::move(*sorted);
+        T* position = std::upper_bound(begin, sorted, value, less);
+        std::move_backward(position, sorted, sorted + 1);
+        *position = std::move(value);
+      }
+    }
+
+    // Merges until the run lengths, from the top of the stack, grow at
+    // least as fast as the Fibonacci numbers
+    void mergeCollapse() {
+      while (runs.size() > 1) {
+        size_t n = runs.size() - 2;
+        if ((n > 0 &&
+             runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+            (n > 1 &&
+             runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+          if (runs[n - 1].length < runs[n + 1].length) --n;
+        } else if (runs[n].length > runs[n + 1].length) {
+          break;
+        }
+        mergeAt(n);
+      }
+    }
+
+    // Position of the first element of sorted[0, length) not less than
+    // key, searched from hint outwards
+    size_t gallopLeft(const T& key, const T* sorted, size_t length,
+                      size_t hint) {
+      size_t lastOffset = 0;
+      size_t offset = 1;
+      if (less(sorted[hint], key)) {
+        const size_t maxOffset = length - hint;
+        while (offset < maxOffset && less(sorted[hint + offset], key)) {
+          lastOffset = offset;
+          offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint + 1;
+        offset += hint;
+      } else {
+        const size_t maxOffset = hint + 1;
+        while (offset < maxOffset && !less(sorted[hint - offset], key)) {
+          lastOffset = offset;
+          offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        const size_t last = lastOffset;
+        lastOffset = hint + 1 - offset;
+        offset = hint - last;
+      }
+      return std::lower_bound(sorted + lastOffset, sorted + offset, key,
+                              less) -
+             sorted;
+    }
+
+    // Position after the last element of sorted[0, length) not greater
+    // than key, searched from hint outwards
+    size_t gallopRight(const T& key, const T* sorted, size_t length,
+                       size_t hint) {
+      size_t lastOffset = 0;
+      size_t offset = 1;
+      if (less(key, sorted[hint])) {
+        const size_t maxOffset = hint + 1;
+        while (offset < maxOffset && less(key, sorted[hint - offset])) {
+          lastOffset = offset;
+          offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        const size_t last = lastOffset;
+        lastOffset = hint + 1 - offset;
+        offset = hint - last;
+      } else {
+        const size_t maxOffset = length - hint;
+        while (offset < maxOffset && !less(key, sorted[hint + offset])) {
+          lastOffset = offset;
+          offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint + 1;
+        offset += hint;
+      }
+      return std::upper_bound(sorted + lastOffset, sorted + offset, key,
+                              less) -
+             sorted;
+    }
+
+    // Merges the runs n and n + 1 of the stack. The start of the first
+    // and the end of the second already are in place and are skipped, the
+    // rest goes through a buffer as long as the shorter side.
+    void mergeAt(size_t n) {
+      T* left = items + runs[n].base;
+      size_t leftLength = runs[n].length;
+      T* right = items + runs[n + 1].base;
+      size_t rightLength = runs[n + 1].length;
+      runs[n].length += rightLength;
+      runs.erase(runs.begin() + n + 1);
+
+      const size_t skipped = gallopRight(*right, left, leftLength, 0);
+      left += skipped;
+      leftLength -= skipped;
+      if (leftLength == 0) return;
+
+      rightLength =
+          gallopLeft(left[leftLength - 1], right, rightLength, rightLength - 1);
+      if (rightLength == 0) return;
+
+      if (leftLength <= rightLength) {
+        mergeLow(left, leftLength, right, rightLength);
+      } else {
+        mergeHigh(left, leftLength, right, rightLength);
+      }
+    }
+
+    // The left run is the shorter, it is buffered and the merge fills the
+    // space from the front. The first element of right belongs first and
+    // the last of left last.
+    void mergeLow(T* left, size_t leftLength, T* right, size_t rightLength) {
+      buffer.assign(std::make_move_iterator(left),
+                    std::make_move_iterator(left + leftLength));
+      T* buffered = buffer.data();
+      T* destination = left;
+      *destination++ = std::move(*right++);
+      --rightLength;
+
+      if (rightLength > 0 && leftLength > 1) {
+        mergeLowRuns(buffered, leftLength, right, rightLength, destination);
+      }
+      if (leftLength == 1 && rightLength > 0) {
+        destination = std::move(right, right + rightLength, destination);
+        *destination = std::move(*buffered);
+      } else {
+        std::move(buffered, buffered + leftLength, destination);
+      }
+    }
+
+    // Returns once right ran out or a single buffered element is left
+    void mergeLowRuns(T*& buffered, size_t& leftLength, T*& right,
+                      size_t& rightLength, T*& destination) {
+      while (true) {
+        size_t leftWins = 0;
+        size_t rightWins = 0;
+        while (true) {
+          if (less(*right, *buffered)) {
+            *destination++ = std::move(*right++);
+            ++rightWins;
+            leftWins = 0;
+            if (--rightLength == 0) return;
+            if (rightWins >= minGallop) break;
+          } else {
+            *destination++ = std::move(*buffered++);
+            ++leftWins;
+            rightWins = 0;
+            if (--leftLength == 1) return;
+            if (leftWins >= minGallop) break;
+          }
+        }
+
+        ++minGallop;
+        do {
+          minGallop -= minGallop > 1;
+          leftWins = gallopRight(*right, buffered, leftLength, 0);
+          if (leftWins > 0) {
+            destination =
+                std::move(buffered, buffered + leftWins, destination);
+            buffered += leftWins;
+            leftLength -= leftWins;
+            if (leftLength <= 1) return;
+          }
+          *destination++ = std::move(*right++);
+          if (--rightLength == 0) return;
+
+          rightWins = gallopLeft(*buffered, right, rightLength, 0);
+          if (rightWins > 0) {
+            destination = std::move(right, right + rightWins, destination);
+            right += rightWins;
+            rightLength -= rightWins;
+            if (rightLength == 0) return;
+          }
+          *destination++ = std::move(*buffered++);
+          if (--leftLength == 1) return;
+        } while (leftWins >= MIN_GALLOP || rightWins >= MIN_GALLOP);
+        ++minGallop;
+      }
+    }
+
+    // The right run is the shorter, it is buffered and the merge fills the
+    // space from the back. The last element of left belongs last and the
+    // first of right first.
+    void mergeHigh(T* left, size_t leftLength, T* right, size_t rightLength) {
+      buffer.assign(std::make_move_iterator(right),
+                    std::make_move_iterator(right + rightLength));
+      T* buffered = buffer.data() + rightLength - 1;
+      T* destination = right + rightLength - 1;
+      left += leftLength - 1;
+      *destination-- = std::move(*left--);
+      --leftLength;
+
+      if (leftLength > 0 && rightLength > 1) {
+        mergeHighRuns(left, leftLength, buffered, rightLength, destination);
+      }
+      if (rightLength == 1 && leftLength > 0) {
+        destination -= leftLength;
+        left -= leftLength;
+        std::move_backward(left + 1, left + 1 + leftLength,
+                           destination + 1 + leftLength);
+        *destination = std::move(*buffered);
+      } else {
+        std::move(buffered + 1 - rightLength, buffered + 1,
+                  destination + 1 - rightLength);
+      }
+    }
+
+    // left and buffered point at the last elements still to merge, returns
+    // once left ran out or a single buffered element is left
+    void mergeHighRuns(T*& left, size_t& leftLength, T*& buffered,
+                       size_t& rightLength, T*& destination) {
+      while (true) {
+        size_t leftWins = 0;
+        size_t rightWins = 0;
+        while (true) {
+          if (less(*buffered, *left)) {
+            *destination-- = std::move(*left--);
+            ++leftWins;
+            rightWins = 0;
+            if (--leftLength == 0) return;
+            if (leftWins >= minGallop) break;
+          } else {
+            *destination-- = std::move(*buffered--);
+            ++rightWins;
+            leftWins = 0;
+            if (--rightLength == 1) return;
+            if (rightWins >= minGallop) break;
+          }
+        }
+
+        ++minGallop;
+        do {
+          minGallop -= minGallop > 1;
+          leftWins = leftLength - gallopRight(*buffered, left + 1 - leftLength,
+                                              leftLength, leftLength - 1);
+          if (leftWins > 0) {
+            destination -= leftWins;
+            left -= leftWins;
+            std::move_backward(left + 1, left + 1 + leftWins,
+                               destination + 1 + leftWins);
+            leftLength -= leftWins;
+            if (leftLength == 0) return;
+          }
+          *destination-- = std::move(*buffered--);
+          if (--rightLength == 1) return;
+
+          rightWins = rightLength - gallopLeft(*left,
+                                               buffered + 1 - rightLength,
+                                               rightLength, rightLength - 1);
+          if (rightWins > 0) {
+            destination -= rightWins;
+            buffered -= rightWins;
+            std::move(buffered + 1, buffered + 1 + rightWins, destination + 1);
+            rightLength -= rightWins;
+            if (rightLength <= 1) return;
+          }
+          *destination-- = std::move(*left--);
+          if (--leftLength == 0) return;
+        } while (leftWins >= MIN_GALLOP || rightWins >= MIN_GALLOP);
+        ++minGallop;
+      }
+    }
+  };
+};
+
+#endif  // SORT_KERNELS_HPP
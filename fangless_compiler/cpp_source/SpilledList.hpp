@@ -0,0 +1,574 @@
+#ifndef SPILLED_LIST_HPP
+#define SPILLED_LIST_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Bool.hpp"
+#include "List.hpp"
+#include "None.hpp"
+#include "Number.hpp"
+#include "Object.hpp"
+#include "Slice.hpp"
+#include "String.hpp"
+#include "Tuple.hpp"
+
+// Sizes the out of core machinery works with. The defaults are meant for
+// real datasets, tests pass small ones so that a few records already take
+// several sort runs, merge passes and window moves.
+struct SpillLimits {
+  // encoded bytes sorted in memory at once by the external merge sort
+  size_t sortRunBytes = 1 << 26;
+  // files merged at once by sort(), bounds the open descriptors
+  size_t mergeFanIn = 64;
+  // bytes of a spill file mapped at a time
+  size_t windowBytes = 1 << 24;
+};
+
+// Append only temporary file read back through a bounded memory mapped
+// window. The file is unlinked as soon as it is created, so the kernel
+// reclaims the space when the process exits, even if it crashes.
+class SpillFile {
+  static constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+  size_t windowSize_;
+  int fd_ = -1;
+  size_t flushed_ = 0;
+  std::string pending_;
+
+  char* window_ = nullptr;
+  size_t windowStart_ = 0;
+  size_t windowLength_ = 0;
+
+  void unmap() {
+    if (window_ != nullptr) munmap(window_, windowLength_);
+    window_ = nullptr;
+    windowLength_ = 0;
+  }
+
+ public:
+  explicit SpillFile(size_t windowSize) : windowSize_(windowSize) {
+    const char* directory = std::getenv("TMPDIR");
+    std::string path = std::string(directory ? directory : "/tmp") +
+                       "/fangless_spill_XXXXXX";
+
+    fd_ = mkstemp(path.data());
+    if (fd_ == -1) {
+      throw std::runtime_error("could not create spill file: " +
+                               std::string(std::strerror(errno)));
+    }
+    unlink(path.c_str());
+    pending_.reserve(WRITE_BUFFER_SIZE);
+  }
+
+  SpillFile(const SpillFile&) = delete;
+  SpillFile& operator=(const SpillFile&) = delete;
+
+  ~SpillFile() {
+    unmap();
+    if (fd_ != -1) close(fd_);
+  }
+
+  size_t size() const { return flushed_ + pending_.size(); }
+
+  void write(const char* data, size_t length) {
+    pending_.append(data, length);
+    if (pending_.size() >= WRITE_BUFFER_SIZE) flush();
+  }
+
+  void flush() {
+    size_t written = 0;
+    while (written < pending_.size()) {
+      ssize_t result = pwrite(fd_, pending_.data() + written,
+                              pending_.size() - written, flushed_ + written);
+      if (result == -1) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error("could not write spill file: " +
+                                 std::string(std::strerror(errno)));
+      }
+      written += static_cast<size_t>(result);
+    }
+
+    flushed_ += pending_.size();
+    pending_.clear();
+  }
+
+  // Pointer to the bytes [offset, offset + length), only valid until the
+  // next call since the window may be moved
+  const char* read(size_t offset, size_t length) {
+    if (offset + length > flushed_) flush();
+
+    if (window_ == nullptr || offset < windowStart_ ||
+        offset + length > windowStart_ + windowLength_) {
+      unmap();
+
+      static const size_t pageSize =
+        static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      windowStart_ = offset - offset % pageSize;
+      windowLength_ = std::min(
+        std::max(windowSize_, offset + length - windowStart_),
+        flushed_ - windowStart_);
+
+      void* mapped = mmap(nullptr, windowLength_, PROT_READ, MAP_SHARED, fd_,
+                          static_cast<off_t>(windowStart_));
+      if (mapped == MAP_FAILED) {
+        windowLength_ = 0;
+        throw std::runtime_error("could not map spill file: " +
+                                 std::string(std::strerror(errno)));
+      }
+      window_ = static_cast<char*>(mapped);
+    }
+
+    return window_ + (offset - windowStart_);
+  }
+};
+
+// Out of core list for datasets larger than RAM. Records are serialized to
+// a spill file next to a file of record offsets, only a bounded window of
+// each one is mapped at a time. Supports None, bool, int of any size,
+// float, str and tuples or lists of those.
+class SpilledList : public Object {
+  SpillLimits limits_;
+  std::unique_ptr<SpillFile> data_;
+  std::unique_ptr<SpillFile> offsets_;
+  size_t size_ = 0;
+
+  // one tag byte in front of every encoded value
+  static constexpr char TAG_NONE = 'N';
+  static constexpr char TAG_TRUE = 'T';
+  static constexpr char TAG_FALSE = 'F';
+  static constexpr char TAG_INT = 'i';
+  static constexpr char TAG_BIG_INT = 'b';
+  static constexpr char TAG_FLOAT = 'd';
+  static constexpr char TAG_STR = 's';
+  static constexpr char TAG_TUPLE = 't';
+  static constexpr char TAG_LIST = 'l';
+
+  static void put(std::string& out, const void* value, size_t length) {
+    out.append(static_cast<const char*>(value), length);
+  }
+
+  static void putSequence(std::string& out, char tag,
+                          const std::vector<std::shared_ptr<Object>>& items) {
+    out.push_back(tag);
+    uint64_t count = items.size();
+    put(out, &count, sizeof(count));
+    for (const auto& item : items) encode(*item, out);
+  }
+
+  static void encode(const Object& object, std::string& out) {
+    const std::string objectType = object.type();
+
+    if (objectType == "NoneType") {
+      out.push_back(TAG_NONE);
+    } else if (objectType == "Bool") {
+      out.push_back(object.toBool() ? TAG_TRUE : TAG_FALSE);
+    } else if (objectType == "int") {
+      const auto& number = static_cast<const Number&>(object);
+      if (number.isBig()) [[unlikely]] {
+        // sign byte, limb count and the little endian limbs
+        BigInt value = number.toBigInt();
+        const BigInt::Magnitude& limbs = value.magnitude();
+        uint64_t count = limbs.size();
+        out.push_back(TAG_BIG_INT);
+        out.push_back(value.isNegative() ? 1 : 0);
+        put(out, &count, sizeof(count));
+        put(out, limbs.data(), count * sizeof(BigInt::Limb));
+        return;
+      }
+      int64_t value = number.getInt();
+      out.push_back(TAG_INT);
+      put(out, &value, sizeof(value));
+    } else if (objectType == "float") {
+      double value = static_cast<const Number&>(object).getDouble();
+      out.push_back(TAG_FLOAT);
+      put(out, &value, sizeof(value));
+    } else if (objectType == "str") {
+      std::string value = *static_cast<const String&>(object);
+      uint64_t length = value.size();
+      out.push_back(TAG_STR);
+      put(out, &length, sizeof(length));
+      out.append(value);
+    } else if (auto* tuple = dynamic_cast<const Tuple*>(&object)) {
+      putSequence(out, TAG_TUPLE, tuple->getElements());
+    } else if (auto* list = dynamic_cast<const List*>(&object)) {
+      putSequence(out, TAG_LIST, list->getElements());
+    } else {
+      throw std::runtime_error("'" + objectType +
+                               "' object can not be spilled to disk");
+    }
+  }
+
+  template <typename T>
+  static T take(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+  }
+
+  static std::shared_ptr<Object> decode(const char*& cursor) {
+    switch (*cursor++) {
+      case TAG_NONE:
+        return None::spawn();
+      case TAG_TRUE:
+        return Bool::spawn(true);
+      case TAG_FALSE:
+        return Bool::spawn(false);
+      case TAG_INT:
+        return Number::spawn(take<int64_t>(cursor));
+      case TAG_BIG_INT: {
+        bool negative = *cursor++ != 0;
+        uint64_t count = take<uint64_t>(cursor);
+        BigInt::Magnitude limbs(count);
+        std::memcpy(limbs.data(), cursor, count * sizeof(BigInt::Limb));
+        cursor += count * sizeof(BigInt::Limb);
+        BigInt value = BigInt::fromMagnitude(std::move(limbs));
+        return std::make_shared<Number>(negative ? -value : value);
+      }
+      case TAG_FLOAT:
+        return Number::spawn(take<double>(cursor));
+      case TAG_STR: {
+        uint64_t length = take<uint64_t>(cursor);
+        std::string value(cursor, length);
+        cursor += length;
+        return String::spawn(value);
+      }
+      case TAG_TUPLE: {
+        uint64_t count = take<uint64_t>(cursor);
+        std::vector<std::shared_ptr<Object>> items;
+        items.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) items.push_back(decode(cursor));
+        return std::make_shared<Tuple>(items);
+      }
+      case TAG_LIST: {
+        uint64_t count = take<uint64_t>(cursor);
+        auto items = List::spawn();
+        for (uint64_t i = 0; i < count; ++i) items->append(decode(cursor));
+        return items;
+      }
+    }
+    throw std::runtime_error("corrupted spill file");
+  }
+
+  // byte range of record i inside the data file
+  std::pair<size_t, size_t> extent(size_t i) const {
+    const char* cursor = offsets_->read(i * sizeof(uint64_t),
+      (i + 1 < size_ ? 2 : 1) * sizeof(uint64_t));
+    size_t start = take<uint64_t>(cursor);
+    size_t end = i + 1 < size_ ? take<uint64_t>(cursor) : data_->size();
+    return {start, end - start};
+  }
+
+  std::shared_ptr<Object> load(size_t i) const {
+    auto [start, length] = extent(i);
+    const char* cursor = data_->read(start, length);
+    return decode(cursor);
+  }
+
+  size_t normalize(int64_t index) const {
+    if (index < 0) index += static_cast<int64_t>(size_);
+    if (index < 0 || static_cast<size_t>(index) >= size_) {
+      throw std::out_of_range("list index out of range");
+    }
+    return static_cast<size_t>(index);
+  }
+
+  using Runs = std::vector<std::unique_ptr<SpilledList>>;
+
+  struct Order {
+    bool reverse;
+
+    bool operator()(const std::shared_ptr<Object>& i,
+                    const std::shared_ptr<Object>& j) const {
+      return reverse ? *j < *i : *i < *j;
+    }
+  };
+
+  // k way merge of runs [first, last), ties go to the earlier run so the
+  // sort stays stable
+  std::unique_ptr<SpilledList> mergeRuns(Runs& runs, size_t first,
+                                         size_t last, Order before) const {
+    using Head = std::pair<std::shared_ptr<Object>, size_t>;
+    auto after = [&before](const Head& i, const Head& j) {
+      if (before(j.first, i.first)) return true;
+      if (before(i.first, j.first)) return false;
+      return i.second > j.second;
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(after)> heads(after);
+    std::vector<Iterator> positions;
+
+    for (size_t run = first; run < last; ++run) {
+      positions.push_back(runs[run]->begin());
+      heads.emplace(*positions.back(), run);
+    }
+
+    auto merged = std::make_unique<SpilledList>(limits_);
+    while (!heads.empty()) {
+      auto [item, run] = heads.top();
+      heads.pop();
+      merged->append(item);
+
+      auto& position = positions[run - first];
+      if (++position != runs[run]->end()) heads.emplace(*position, run);
+    }
+
+    for (size_t run = first; run < last; ++run) runs[run].reset();
+    return merged;
+  }
+
+  void adopt(SpilledList& other) {
+    std::swap(data_, other.data_);
+    std::swap(offsets_, other.offsets_);
+    std::swap(size_, other.size_);
+  }
+
+ public:
+  class Iterator {
+    const SpilledList* list_ = nullptr;
+    size_t position_ = 0;
+    std::shared_ptr<Object> current_;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::shared_ptr<Object>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    Iterator() = default;
+    Iterator(const SpilledList* list, size_t position)
+      : list_(list), position_(position) {}
+
+    reference operator*() {
+      if (current_.get() == nullptr) current_ = list_->load(position_);
+      return current_;
+    }
+
+    pointer operator->() { return &operator*(); }
+
+    Iterator& operator++() {
+      ++position_;
+      current_.reset();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return position_ == other.position_;
+    }
+  };
+
+  explicit SpilledList(SpillLimits limits = {}) : limits_(limits) {
+    if (limits_.sortRunBytes == 0 || limits_.mergeFanIn < 2 ||
+        limits_.windowBytes == 0) {
+      throw std::invalid_argument(
+        "spilled_list() needs a positive run size and window and a merge "
+        "fan in of at least 2");
+    }
+    data_ = std::make_unique<SpillFile>(limits_.windowBytes);
+    offsets_ = std::make_unique<SpillFile>(limits_.windowBytes);
+  }
+
+  template <typename TIterator>
+  SpilledList(TIterator begin, TIterator end, SpillLimits limits = {})
+      : SpilledList(limits) {
+    for (; begin != end; ++begin) append(*begin);
+  }
+
+  static std::shared_ptr<SpilledList> spawn(SpillLimits limits = {}) {
+    return std::make_shared<SpilledList>(limits);
+  }
+
+  template <typename TType>
+  static std::shared_ptr<SpilledList> spawn(
+      const std::shared_ptr<TType>& items, SpillLimits limits = {}) {
+    return std::make_shared<SpilledList>(items->begin(), items->end(),
+                                         limits);
+  }
+
+  const SpillLimits& limits() const { return limits_; }
+
+  std::string type() const override { return "list"; }
+
+  std::string toString() const override {
+    std::string result = "[";
+    for (size_t i = 0; i < size_; ++i) {
+      if (i > 0) result += ", ";
+      result += load(i)->toString();
+    }
+    return result + "]";
+  }
+
+  bool equals(const Object& other) const override {
+    if (auto* spilled = dynamic_cast<const SpilledList*>(&other)) {
+      if (spilled->size_ != size_) return false;
+      for (size_t i = 0; i < size_; ++i) {
+        if (!load(i)->equals(*spilled->load(i))) return false;
+      }
+      return true;
+    }
+
+    if (auto* list = dynamic_cast<const List*>(&other)) {
+      const auto& elements = list->getElements();
+      if (elements.size() != size_) return false;
+      for (size_t i = 0; i < size_; ++i) {
+        if (!load(i)->equals(*elements[i])) return false;
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+  size_t hash() const override {
+    throw std::runtime_error("unhashable type: 'list'");
+  }
+
+  bool toBool() const override { return size_ > 0; }
+
+  bool isInstance(const std::string& type) const override {
+    return type == "list" || type == "object";
+  }
+
+  std::shared_ptr<Object> getAttr(const std::string& name) const override {
+    throw std::runtime_error("'list' object has no attribute '" + name + "'");
+  }
+
+  void setAttr(const std::string&,
+               std::shared_ptr<Object>) override {
+    throw std::runtime_error("'list' object has no attributes");
+  }
+
+  void append(const std::shared_ptr<Object>& item) {
+    uint64_t offset = data_->size();
+    offsets_->write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+
+    std::string record;
+    encode(*item, record);
+    data_->write(record.data(), record.size());
+    ++size_;
+  }
+
+  std::shared_ptr<Number> len() const {
+    return Number::spawn(static_cast<int64_t>(size_));
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, size_); }
+
+  std::shared_ptr<Object> operator[](const Number& index) const {
+    return load(normalize(index.getInt()));
+  }
+
+  std::shared_ptr<Object> operator[](
+      const std::shared_ptr<Number>& index) const {
+    return load(normalize(index->getInt()));
+  }
+
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return load(normalize(Number::indexOf(
+      *index, "list indices must be integers or slices, not ")));
+  }
+
+  std::shared_ptr<SpilledList> operator[](const Slice& slice) const {
+    int64_t size = static_cast<int64_t>(size_);
+    int64_t step = slice.step == 0 ?
+      throw std::invalid_argument("Step cannot be zero") : slice.step;
+    int64_t start = slice.start == INT_MAX ?
+      (step > 0 ? 0 : size - 1) : slice.start;
+    int64_t end = slice.end == INT_MAX ? (step > 0 ? size : -1) : slice.end;
+
+    if (slice.start != INT_MAX && start < 0) start += size;
+    if (slice.end != INT_MAX && end < 0) end += size;
+
+    auto result = SpilledList::spawn(limits_);
+    if (step > 0) {
+      start = std::clamp<int64_t>(start, 0, size);
+      end = std::clamp<int64_t>(end, 0, size);
+      for (int64_t i = start; i < end; i += step) result->append(load(i));
+    } else {
+      start = std::clamp<int64_t>(start, -1, size - 1);
+      end = std::clamp<int64_t>(end, -1, size - 1);
+      for (int64_t i = start; i > end; i += step) result->append(load(i));
+    }
+
+    return result;
+  }
+
+  std::shared_ptr<SpilledList> slice(const Slice& slice) const {
+    return this->operator[](slice);
+  }
+
+  std::shared_ptr<SpilledList> slice(std::shared_ptr<Slice> slice) const {
+    return this->operator[](*slice);
+  }
+
+  // External merge sort: runs of at most sortRunBytes are sorted in memory
+  // and spilled, then merged at most mergeFanIn at a time (each run keeps
+  // two files open) until a single run is left. Mixed ints, floats and
+  // bools sort together by value, as List::sort does.
+  void sort(const std::shared_ptr<Bool>& descending = Bool::spawn(false)) {
+    const Order before{descending->toBool()};
+
+    Runs runs;
+    std::vector<std::shared_ptr<Object>> chunk;
+    std::shared_ptr<Object> first;
+    size_t chunkBytes = 0;
+
+    auto spillRun = [&]() {
+      std::stable_sort(chunk.begin(), chunk.end(), before);
+      runs.push_back(
+        std::make_unique<SpilledList>(chunk.begin(), chunk.end(), limits_));
+      chunk.clear();
+      chunkBytes = 0;
+    };
+
+    for (size_t i = 0; i < size_; ++i) {
+      auto item = load(i);
+      if (i == 0) first = item;
+      List::checkSortable(*first, *item);
+
+      chunk.push_back(item);
+      chunkBytes += extent(i).second;
+      if (chunkBytes >= limits_.sortRunBytes) spillRun();
+    }
+    if (!chunk.empty()) spillRun();
+    if (runs.empty()) return;
+
+    while (runs.size() > 1) {
+      Runs merged;
+      for (size_t first = 0; first < runs.size();
+           first += limits_.mergeFanIn) {
+        size_t last = std::min(first + limits_.mergeFanIn, runs.size());
+        merged.push_back(mergeRuns(runs, first, last, before));
+      }
+      runs = std::move(merged);
+    }
+
+    adopt(*runs.front());
+  }
+};
+
+#endif  // SPILLED_LIST_HPP
@@ -2,47 +2,406 @@
 #define STRING_HPP
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <climits>
 #include <compare>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Function.hpp"
+#include "Hash.hpp"
 #include "Iterable.hpp"
 #include "Tuple.hpp"
 #include "Bool.hpp"
 #include "Number.hpp"
+#include "NumberParse.hpp"
 #include "Object.hpp"
 #include "Slice.hpp"
+#include "StringAscii.hpp"
+#include "StringSearch.hpp"
+#include "StringUtf8.hpp"
+
+// The text of a string literal as a template argument, each distinct
+// literal of the program is then its own String::literal<> instantiation
+template <size_t N>
+struct LiteralText {
+  char text[N];
+
+  constexpr LiteralText(const char (&value)[N]) {
+    std::copy_n(value, N, text);
+  }
+
+  constexpr size_t size() const { return N - 1; }
+};
 
 class String : public Object {
-  std::string value_;
+  friend class StringFormat;
+  friend bool textOf(const Object& object, std::string_view& text);
+
+  // A string owns its text in value_, or is a view of [offset_, offset_ +
+  // length_) in a buffer shared with the string it was cut from. Views are
+  // read through view() without copying, text() and any mutation copy the
+  // piece out first
+  mutable std::string value_;
+  mutable std::shared_ptr<const std::string> buffer_;
+  mutable size_t offset_ = 0;
+  mutable size_t length_ = 0;
+
+  // shorter pieces are copied, they fit in the small string buffer anyway
+  static constexpr size_t VIEW_MIN_LENGTH = 32;
+  // a view this many times smaller than its buffer copies itself out once
+  // it is the last one holding the buffer, instead of pinning all of it
+  static constexpr size_t VIEW_PIN_RATIO = 8;
+
+  // Interned strings (the literals and sys.intern results) point to their
+  // canonical entry (text -> hash) in the intern table, so two of them are
+  // equal exactly when they share the entry. The hash of any string is
+  // cached on first use, mutations detach the string from the table and
+  // drop the cached hash.
+  using InternEntry = std::pair<const std::string, size_t>;
+
+  const InternEntry* interned_ = nullptr;
+  mutable size_t hash_ = Hash::UNSET;
+
+  // Whether every byte is below 0x80, found on first use like the hash.
+  // ASCII strings take the vectorized classification paths
+  enum class AsciiState : char { UNKNOWN, ASCII, NON_ASCII };
+  mutable AsciiState ascii_ = AsciiState::UNKNOWN;
+
+  // Indices, len() and slices count code points. ASCII strings map them
+  // to bytes directly, other strings build a sparse index on first use:
+  // the byte offset of every CODE_POINT_STRIDE-th code point, so finding
+  // any code point walks at most one stride of bytes
+  static constexpr size_t CODE_POINT_STRIDE = 64;
+
+  mutable std::vector<size_t> checkpoints_;
+  mutable size_t codePoints_ = 0;
+  mutable bool indexed_ = false;
+
+  // Entries are never removed: the table holds each distinct literal and
+  // each text passed to sys.intern once, for the life of the program
+  static std::unordered_map<std::string, size_t>& internTable() {
+    static std::unordered_map<std::string, size_t> table;
+    return table;
+  }
+
+  void internValue() {
+    auto& table = internTable();
+    auto it = table.find(text());
+    if (it == table.end()) {
+      it = table.emplace(text(), Hash::text(text())).first;
+    }
+    interned_ = &*it;
+  }
+
+  bool isView() const { return buffer_.get() != nullptr; }
+
+  // Copies the piece out of the shared buffer
+  void own() const {
+    if (!isView()) return;
+
+    value_.assign(*buffer_, offset_, length_);
+    buffer_.reset();
+  }
+
+  // Moves the text into a shared buffer so pieces can point into it
+  const std::shared_ptr<const std::string>& sharedBuffer() const {
+    if (!isView()) {
+      buffer_ = std::make_shared<const std::string>(std::move(value_));
+      value_.clear();
+      offset_ = 0;
+      length_ = buffer_->size();
+    }
+    return buffer_;
+  }
+
+  // The text as a contiguous std::string. A view over a whole buffer reads
+  // the buffer directly, any other view is copied out once
+  const std::string& text() const {
+    if (isView()) {
+      if (offset_ == 0 && length_ == buffer_->size()) return *buffer_;
+      own();
+    }
+    return value_;
+  }
+
+  std::string_view view() const {
+    if (!isView()) return value_;
+
+    if (buffer_.use_count() == 1 && length_ * VIEW_PIN_RATIO < buffer_->size()) {
+      own();
+      return value_;
+    }
+    return std::string_view(*buffer_).substr(offset_, length_);
+  }
+
+  // Piece [offset, offset + length) of this string, long pieces share the
+  // buffer instead of copying
+  std::shared_ptr<String> substring(size_t offset, size_t length) const {
+    if (length < VIEW_MIN_LENGTH) {
+      return String::spawn(std::string(view().substr(offset, length)));
+    }
+
+    auto result = std::make_shared<String>();
+    result->offset_ = (isView() ? offset_ : 0) + offset;
+    result->buffer_ = sharedBuffer();
+    result->length_ = length;
+    return result;
+  }
+
+  void detach() {
+    own();
+    interned_ = nullptr;
+    hash_ = Hash::UNSET;
+    ascii_ = AsciiState::UNKNOWN;
+    checkpoints_.clear();
+    indexed_ = false;
+  }
+
+  void buildIndex() const {
+    if (indexed_) return;
+
+    std::string_view text = view();
+    checkpoints_.clear();
+    codePoints_ = 0;
+    for (size_t offset = 0; offset < text.size();
+         offset = StringUtf8::next(text, offset)) {
+      if (codePoints_ % CODE_POINT_STRIDE == 0) checkpoints_.push_back(offset);
+      ++codePoints_;
+    }
+    indexed_ = true;
+  }
+
+  // Byte offset where code point index starts, the size for the end
+  size_t byteOffset(size_t index) const {
+    if (isAscii()) return std::min(index, view().size());
+
+    buildIndex();
+    std::string_view text = view();
+    if (index >= codePoints_) return text.size();
+
+    size_t offset = checkpoints_[index / CODE_POINT_STRIDE];
+    for (size_t step = index % CODE_POINT_STRIDE; step > 0; --step) {
+      offset = StringUtf8::next(text, offset);
+    }
+    return offset;
+  }
+
+  // Code point index of the one starting at byte offset
+  size_t codePointIndex(size_t offset) const {
+    if (isAscii()) return offset;
+
+    buildIndex();
+    auto checkpoint = std::upper_bound(checkpoints_.begin(),
+                                       checkpoints_.end(), offset);
+    if (checkpoint == checkpoints_.begin()) return 0;
+    --checkpoint;
+
+    size_t stride = static_cast<size_t>(checkpoint - checkpoints_.begin());
+    return stride * CODE_POINT_STRIDE +
+      StringUtf8::count(view().substr(*checkpoint, offset - *checkpoint));
+  }
+
+  // Bytes of the code points [first, last)
+  std::shared_ptr<String> codePoints(size_t first, size_t last) const {
+    size_t begin = byteOffset(first);
+    return substring(begin, byteOffset(last) - begin);
+  }
+
+  // Resolves the start/end arguments of find, count... the way a slice
+  // does, the search then happens inside [first, second)
+  std::pair<size_t, size_t> searchBounds(int start, int end) const {
+    int size = static_cast<int>(length());
+    if (end == INT_MAX) end = size;
+    if (start < 0) start += size;
+    if (end < 0) end += size;
+
+    return {static_cast<size_t>(std::clamp(start, 0, size)),
+            static_cast<size_t>(std::clamp(end, 0, size))};
+  }
+
+  std::shared_ptr<Number> findIn(const String& sub, int start, int end) const {
+    auto [first, last] = searchBounds(start, end);
+    if (first > last) return std::make_shared<Number>(-1);
+
+    std::string_view window = view().substr(0, byteOffset(last));
+    size_t pos = StringSearch::find(window, sub.view(), byteOffset(first));
+    if (pos == std::string::npos) return std::make_shared<Number>(-1);
+
+    return std::make_shared<Number>(static_cast<int>(codePointIndex(pos)));
+  }
+
+  std::shared_ptr<Number> rfindIn(const String& sub, int start,
+                                  int end) const {
+    auto [first, last] = searchBounds(start, end);
+    if (first > last) return std::make_shared<Number>(-1);
+
+    size_t begin = byteOffset(first);
+    std::string_view window = view().substr(begin, byteOffset(last) - begin);
+    size_t pos = StringSearch::rfind(window, sub.view());
+    if (pos == std::string::npos) return std::make_shared<Number>(-1);
+
+    return std::make_shared<Number>(static_cast<int>(
+      codePointIndex(pos + begin)));
+  }
+
+  std::shared_ptr<Number> countIn(const String& sub, int start,
+                                  int end) const {
+    auto [first, last] = searchBounds(start, end);
+    if (first > last) return std::make_shared<Number>(0);
+    // the empty needle still matches at the end, but not past it
+    if (sub.view().empty() && start > static_cast<int>(length())) {
+      return std::make_shared<Number>(0);
+    }
+
+    return std::make_shared<Number>(static_cast<int>(
+      StringSearch::count(view(), sub.view(), byteOffset(first),
+                          byteOffset(last))));
+  }
+
+  // A missing separator leaves the whole string in the first slot for
+  // partition and in the last one for rpartition
+  std::shared_ptr<Tuple> partitionAt(size_t pos, const String& separator,
+                                     bool fromRight) {
+    size_t size = view().size();
+    if (pos == std::string::npos) {
+        auto whole = substring(0, size);
+        auto empty = String::spawn("");
+        if (fromRight) return Tuple::spawn({empty, empty, whole});
+        return Tuple::spawn({whole, empty, empty});
+    }
+
+    size_t afterPos = pos + separator.view().size();
+    return Tuple::spawn({
+        substring(0, pos),
+        std::make_shared<String>(separator),
+        substring(afterPos, size - afterPos)
+    });
+  }
 
  public:
   explicit String(const std::string& value = "") : value_(value) {}
 
-  String(const String& other) : value_(other.value_) {}
+  explicit String(std::string&& value) : value_(std::move(value)) {}
+
+  String(const String& other)
+    : value_(other.value_),
+      buffer_(other.buffer_),
+      offset_(other.offset_),
+      length_(other.length_),
+      interned_(other.interned_),
+      hash_(other.hash_),
+      ascii_(other.ascii_) {}
 
   static std::shared_ptr<String> spawn(const std::string& value) {
     return std::make_shared<String>(value);
   }
 
+  static std::shared_ptr<String> spawn(std::string&& value) {
+    return std::make_shared<String>(std::move(value));
+  }
+
+  // Interned strings built at run time, such as the one character table
+  static std::shared_ptr<String> literal(const std::string& value) {
+    auto result = std::make_shared<String>(value);
+    result->internValue();
+    return result;
+  }
+
+  // The string literals of the program are interned once, on their first
+  // evaluation, and shared by every later one. Strings other handles hold
+  // are never changed in place (see operator+=), so the sharing is
+  // invisible, as with Number::literal<>().
+  template <LiteralText TEXT>
+  static const std::shared_ptr<String>& literal() {
+    static const std::shared_ptr<String> value =
+      literal(std::string(TEXT.text, TEXT.size()));
+    return value;
+  }
+
+  // Python's sys.intern, returns an equal string bound to the intern table
+  std::shared_ptr<String> intern() const {
+    auto result = std::make_shared<String>(*this);
+    if (result->interned_ == nullptr) result->internValue();
+    return result;
+  }
+
+  bool isInterned() const { return interned_ != nullptr; }
+
+  bool sameInterned(const String& other) const {
+    return interned_ != nullptr && interned_ == other.interned_;
+  }
+
+  // The 256 one byte strings, built once and shared by everything that
+  // produces single characters, so walking a text allocates nothing
+  static const std::shared_ptr<String>& character(unsigned char c) {
+    static const auto table = [] {
+      std::array<std::shared_ptr<String>, 256> characters;
+      for (size_t i = 0; i < characters.size(); ++i) {
+        characters[i] = literal(std::string(1, static_cast<char>(i)));
+      }
+      return characters;
+    }();
+    return table[c];
+  }
+
+  size_t size() const { return view().size(); }
+
+  // Number of code points, what len() reports
+  size_t length() const {
+    if (isAscii()) return view().size();
+
+    buildIndex();
+    return codePoints_;
+  }
+
+  bool isAscii() const {
+    if (ascii_ == AsciiState::UNKNOWN) {
+      ascii_ = StringAscii::isAscii(view()) ?
+        AsciiState::ASCII : AsciiState::NON_ASCII;
+    }
+    return ascii_ == AsciiState::ASCII;
+  }
+
   String& operator=(const String& other) {
     if (this != &other) {
       value_ = other.value_;
+      buffer_ = other.buffer_;
+      offset_ = other.offset_;
+      length_ = other.length_;
+      interned_ = other.interned_;
+      hash_ = other.hash_;
+      ascii_ = other.ascii_;
+      checkpoints_.clear();
+      indexed_ = false;
     }
     return *this;
   }
 
-  std::string operator*() const { return value_; }
+  std::string operator*() const { return std::string(view()); }
 
   std::string type() const override { return "str"; }
 
-  std::string toString() const override { return "'" + value_ + "'"; }
+  std::string toString() const override { return "'" + text() + "'"; }
 
   bool equals(const Object& other) const override {
+    if (this == &other) return true;
+
     if (auto* strObj = dynamic_cast<const String*>(&other)) {
-      return value_ == strObj->value_;
+      if (interned_ != nullptr && strObj->interned_ != nullptr) {
+        return interned_ == strObj->interned_;
+      }
+      if (hash_ != Hash::UNSET && strObj->hash_ != Hash::UNSET &&
+          hash_ != strObj->hash_) {
+        return false;
+      }
+      return view() == strObj->view();
     }
 
     return false;
@@ -80,17 +439,24 @@ class String : public Object {
   }
 
   std::strong_ordering compare(const Object& other) const override {
-    if (other.type() != "str") return Object::compare(other);
+    auto* otherString = dynamic_cast<const String*>(&other);
+    if (otherString == nullptr) return Object::compare(other);
 
-    auto* otherBool = dynamic_cast<const String*>(&other);
-
-    return value_ <=> otherBool->value_;
+    if (this == otherString || sameInterned(*otherString)) {
+      return std::strong_ordering::equal;
+    }
+    return view() <=> otherString->view();
   }
 
-  size_t hash() const override { return std::hash<std::string>{}(value_); }
+  size_t hash() const override {
+    if (interned_ != nullptr) return interned_->second;
 
-  bool toBool() const override { return !value_.empty(); }
-  bool operator!() const { return value_.empty(); }
+    if (hash_ == Hash::UNSET) hash_ = Hash::text(view());
+    return hash_;
+  }
+
+  bool toBool() const override { return !view().empty(); }
+  bool operator!() const { return view().empty(); }
   friend bool operator!(const std::shared_ptr<String>& obj) {
     return obj->operator!();
   }
@@ -112,20 +478,77 @@ class String : public Object {
     throw std::runtime_error("'str' object attributes are read-only");
   }
 
-  auto begin() { return value_.begin(); }
-  auto end() { return value_.end(); }
-  auto begin() const { return value_.begin(); }
-  auto end() const { return value_.end(); }
+  // Walks the code points as one character Strings, ASCII ones come from
+  // the shared character table. The iterator holds the shared buffer, so
+  // the loop walks the text as it was when it started even if the body
+  // appends to the string.
+  class Iterator {
+    std::shared_ptr<const std::string> buffer_;
+    size_t offset_ = 0;
+    mutable std::shared_ptr<String> current_;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::shared_ptr<String>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    Iterator() = default;
+    Iterator(std::shared_ptr<const std::string> buffer, size_t offset)
+      : buffer_(std::move(buffer)), offset_(offset) {}
+
+    reference operator*() const {
+      if (current_.get() == nullptr) {
+        auto lead = static_cast<unsigned char>((*buffer_)[offset_]);
+        if (lead < 0x80) {
+          current_ = character(lead);
+        } else {
+          size_t next = StringUtf8::next(*buffer_, offset_);
+          current_ = String::spawn(buffer_->substr(offset_, next - offset_));
+        }
+      }
+      return current_;
+    }
 
-  auto rbegin() { return value_.rbegin(); }
-  auto rend() { return value_.rend(); }
-  auto rbegin() const { return value_.rbegin(); }
-  auto rend() const { return value_.rend(); }
+    pointer operator->() const { return &operator*(); }
+
+    Iterator& operator++() {
+      offset_ = StringUtf8::next(*buffer_, offset_);
+      current_.reset();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return offset_ == other.offset_;
+    }
+  };
+
+  // sharedBuffer() turns an owning string into a view over its whole text,
+  // so offset_ and length_ are read after it
+  Iterator begin() const {
+    const auto& buffer = sharedBuffer();
+    return Iterator(buffer, offset_);
+  }
+
+  Iterator end() const {
+    const auto& buffer = sharedBuffer();
+    return Iterator(buffer, offset_ + length_);
+  }
 
   // Python string methods
   std::shared_ptr<String> capitalize() const {
-    std::string result = value_;
-    result[0] = std::toupper(static_cast<unsigned char>(value_[0]));
+    std::string result = text();
+    StringAscii::toLower(result);
+    if (!result.empty()) {
+      result[0] = std::toupper(static_cast<unsigned char>(result[0]));
+    }
     return std::make_shared<String>(result);
   }
 
@@ -135,17 +558,17 @@ class String : public Object {
 
   std::shared_ptr<String> center(const Number& width,
     const String& fill = String(std::string(" "))) {
-    if (static_cast<int64_t>(value_.size()) >= width.getInt()) {
-        return std::make_shared<String>(value_);
+    if (static_cast<int64_t>(text().size()) >= width.getInt()) {
+        return std::make_shared<String>(text());
     }
 
-    size_t total_padding = width.getInt() - value_.size();
+    size_t total_padding = width.getInt() - text().size();
     size_t left_padding = total_padding / 2;
     size_t right_padding = total_padding - left_padding;
 
     return std::make_shared<String>(
       std::string(left_padding, (*fill).c_str()[0]) +
-      value_ +
+      text() +
       std::string(right_padding, (*fill).c_str()[0])
     );
   }
@@ -160,7 +583,7 @@ class String : public Object {
     size_t column = 0;
     const size_t tabSize = tab.getInt();
 
-    for (char c : value_) {
+    for (char c : text()) {
         if (c == '\t') {
             size_t spaces = tabSize - (column % tabSize);
             result.append(spaces, ' ');
@@ -180,24 +603,21 @@ class String : public Object {
   }
 
   std::shared_ptr<String> upper() const {
-    std::string result = value_;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    std::string result = text();
+    StringAscii::toUpper(result);
     return std::make_shared<String>(result);
   }
 
   std::shared_ptr<String> lower() const {
-    std::string result = value_;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    std::string result = text();
+    StringAscii::toLower(result);
     return std::make_shared<String>(result);
   }
 
   std::shared_ptr<String> lstrip(const String& chars) {
-    size_t start = value_.find_first_not_of(*chars);
-    if (start == std::string::npos) {
-        return String::spawn(std::string(""));
-    }
-
-    return String::spawn(value_.substr(start));
+    auto [first, last] =
+      StringAscii::stripBounds(view(), chars.view(), true, false);
+    return substring(first, last - first);
   }
 
   std::shared_ptr<String> lstrip(
@@ -207,12 +627,9 @@ class String : public Object {
   }
 
   std::shared_ptr<String> rstrip(const String& chars) {
-    size_t end = value_.find_last_not_of(*chars);
-    if (end == std::string::npos) {
-        return String::spawn(std::string(""));
-    }
-
-    return String::spawn(value_.substr(0, end + 1));
+    auto [first, last] =
+      StringAscii::stripBounds(view(), chars.view(), false, true);
+    return substring(first, last - first);
   }
 
   std::shared_ptr<String> rstrip(
@@ -222,23 +639,7 @@ class String : public Object {
   }
 
   std::shared_ptr<Tuple> partition(const String& value) {
-    size_t pos = value_.find(*value);
-
-    if (pos == std::string::npos) {
-        return Tuple::spawn({
-            String::spawn(value_),
-            String::spawn(""),
-            String::spawn("")
-        });
-    }
-
-    std::shared_ptr<String> before = String::spawn(value_.substr(0, pos));
-    std::shared_ptr<String> separator = String::spawn(*value);
-    
-    size_t after_pos = pos + (*value).size();
-    std::shared_ptr<String> after = String::spawn(after_pos < value_.size() ? value_.substr(after_pos) : "");
-
-    return Tuple::spawn({before, separator, after});
+    return partitionAt(StringSearch::find(view(), value.view()), value, false);
   }
 
   std::shared_ptr<Tuple> partition(const std::shared_ptr<String>& value) {
@@ -246,23 +647,7 @@ class String : public Object {
   }
 
   std::shared_ptr<Tuple> rpartition(const String& value) {
-    size_t pos = value_.rfind(*value);
-
-    if (pos == std::string::npos) {
-        return Tuple::spawn({
-            String::spawn(value_),
-            String::spawn(""),
-            String::spawn("")
-        });
-    }
-
-    std::shared_ptr<String> before = String::spawn(value_.substr(0, pos));
-    std::shared_ptr<String> separator = String::spawn(*value);
-    
-    size_t after_pos = pos + (*value).size();
-    std::shared_ptr<String> after = String::spawn(after_pos < value_.size() ? value_.substr(after_pos) : "");
-
-    return Tuple::spawn({before, separator, after});
+    return partitionAt(StringSearch::rfind(view(), value.view()), value, true);
   }
   
   std::shared_ptr<Tuple> rpartition(const std::shared_ptr<String>& value) {
@@ -270,48 +655,53 @@ class String : public Object {
   }
   
   std::shared_ptr<String> strip(const std::shared_ptr<String>& value =
-    String::spawn(std::string(" \t\n\r"))) const {
-    auto start = value_.find_first_not_of((**value).c_str());
-    auto end = value_.find_last_not_of((**value).c_str());
-
-    if (start == std::string::npos) return std::make_shared<String>("");
-
-    return std::make_shared<String>(value_.substr(start, end - start + 1));
+    String::spawn(std::string(" \t\n\r\f\v"))) const {
+    auto [first, last] =
+      StringAscii::stripBounds(view(), value->view(), true, true);
+    return substring(first, last - first);
   }
 
   std::shared_ptr<List> rsplit(const String& separator,
     const Number& maxOccurrences = Number(-1)) {
     auto result = std::make_shared<List>();
-    size_t end = value_.size();
+    size_t end = view().size();
     size_t start;
     int maxSplits = maxOccurrences.getInt();
     int currentSplit = 0;
+    size_t separatorSize = separator.view().size();
 
-    if ((*separator).empty()) {
-        result->append(String::spawn(value_));
+    if (separatorSize == 0) {
+        result->append(substring(0, end));
         return result;
     }
 
-    while ((start = value_.rfind(*separator, end - 1)) != std::string::npos) {
+    // pieces are collected from the back and put in order at the end
+    auto& pieces = result->getElements();
+    while (end >= separatorSize &&
+           (start = StringSearch::rfind(view(), separator.view(),
+                                        end - separatorSize)) !=
+           std::string::npos) {
         if (maxSplits >= 0 && currentSplit >= maxSplits) break;
-        result->getElements().insert(result->getElements().begin(),
-            String::spawn(value_.substr(start + (*separator).size(), end - (start + (*separator).size()))));
+        pieces.push_back(substring(start + separatorSize,
+                                   end - start - separatorSize));
         end = start;
         currentSplit++;
     }
 
-    result->getElements().insert(result->getElements().begin(),
-        String::spawn(value_.substr(0, end)));
+    pieces.push_back(substring(0, end));
+    std::reverse(pieces.begin(), pieces.end());
 
     return result;
   }
 
   std::shared_ptr<List> rsplit(
-    const std::shared_ptr<String>& separator = String::spawn(std::string(" "))
-    , const std::shared_ptr<Number>& maxSplit = Number::spawn(-1)) {
+    const std::shared_ptr<String>& separator,
+    const std::shared_ptr<Number>& maxSplit = Number::spawn(-1)) {
     return rsplit(*separator, *maxSplit);
   }
 
+  std::shared_ptr<List> rsplit() { return split(); }
+
   std::shared_ptr<List> split(const String& separator,
     const Number& maxOcurrences = Number(-1)) {
     auto result = std::make_shared<List>();
@@ -319,52 +709,89 @@ class String : public Object {
     int currentSplit = 0;
     int maxSplits = maxOcurrences.getInt();
 
-    if ((*separator).empty()) {
-        result->append(String::spawn(value_));
+    if (separator.view().empty()) {
+        result->append(substring(0, view().size()));
         return result;
     }
 
-    while ((end = value_.find(*separator, start)) != std::string::npos) {
+    // pieces that are long enough point into this string's buffer
+    while ((end = StringSearch::find(view(), separator.view(), start)) !=
+           std::string::npos) {
         if (maxSplits >= 0 && currentSplit >= maxSplits) break;
 
-        result->append(String::spawn(value_.substr(start, end - start)));
-        start = end + (*separator).size();
+        result->append(substring(start, end - start));
+        start = end + separator.view().size();
         currentSplit++;
     }
 
-    result->append(String::spawn(value_.substr(start)));
+    result->append(substring(start, view().size() - start));
     
     return result;
   }
 
 
   std::shared_ptr<List> split(
-    const std::shared_ptr<String>& separator =
-    String::spawn(std::string(" ")),
+    const std::shared_ptr<String>& separator,
     const std::shared_ptr<Number>& maxOcurrences = Number::spawn(-1)) {
     return split(*separator, *maxOcurrences);
   }
 
+  // Without a separator runs of whitespace split and are dropped
+  std::shared_ptr<List> split() {
+    auto result = std::make_shared<List>();
+    std::string_view text = view();
+    StringAscii::forEachField(text, [&](std::string_view field) {
+      result->append(substring(field.data() - text.data(), field.size()));
+    });
+    return result;
+  }
+
+  // int() and float() of every whitespace separated field, the fields are
+  // parsed in place instead of being cut into strings first
+  std::shared_ptr<List> splitInts() const {
+    auto result = std::make_shared<List>();
+    auto& elements = result->getElements();
+    StringAscii::forEachField(view(), [&](std::string_view field) {
+      elements.push_back(NumberParse::parseInt(field));
+    });
+    return result;
+  }
+
+  std::shared_ptr<List> splitFloats() const {
+    auto result = std::make_shared<List>();
+    auto& elements = result->getElements();
+    StringAscii::forEachField(view(), [&](std::string_view field) {
+      elements.push_back(Number::spawn(NumberParse::parseFloat(field)));
+    });
+    return result;
+  }
+
+  std::shared_ptr<Number> toInt(int base = 10) const {
+    return NumberParse::parseInt(view(), base);
+  }
+
+  double toFloat() const { return NumberParse::parseFloat(view()); }
+
   std::shared_ptr<List> splitlines(const Bool& keepLineBreaks) {
     auto result = std::make_shared<List>();
     size_t start = 0;
 
-    for (size_t i = 0; i < value_.size(); ++i) {
-      if (value_[i] == '\n' || value_[i] == '\r' ||
-        value_[i] == '\v' || value_[i] == '\f' ||
-        value_[i] == '\x1c' || value_[i] == '\x1d' ||
-        value_[i] == '\x1e' || value_[i] == '\x85') {
+    for (size_t i = 0; i < text().size(); ++i) {
+      if (text()[i] == '\n' || text()[i] == '\r' ||
+        text()[i] == '\v' || text()[i] == '\f' ||
+        text()[i] == '\x1c' || text()[i] == '\x1d' ||
+        text()[i] == '\x1e' || text()[i] == '\x85') {
 
         size_t length = i - start;
-        if (keepLineBreaks.toBool() && i < value_.size()) {
+        if (keepLineBreaks.toBool() && i < text().size()) {
           length++; // Include the line break
         }
         
-        result->append(String::spawn(value_.substr(start, length)));
+        result->append(String::spawn(text().substr(start, length)));
 
-        if (value_[i] == '\r' && i + 1 < value_.size() && value_[i + 1] == '\n') {
+        if (text()[i] == '\r' && i + 1 < text().size() && text()[i + 1] == '\n') {
           if (keepLineBreaks.toBool()) {
-              result->append(String::spawn(value_.substr(i, 2))); // Add \r\n
+              result->append(String::spawn(text().substr(i, 2))); // Add \r\n
           }
           ++i; // Skip the \n
         }
@@ -373,8 +800,8 @@ class String : public Object {
       }
     }
 
-    if (start < value_.size()) {
-        result->append(String::spawn(value_.substr(start)));
+    if (start < text().size()) {
+        result->append(String::spawn(text().substr(start)));
     }
 
     return result;
@@ -388,19 +815,17 @@ class String : public Object {
   bool startswith(const String& prefix, const Number& start = Number(0),
     const Number& end = Number(0)) const {
     if (end == Number(0)) {
-      return value_.substr(
+      return text().substr(
         start.getInt(),
-        Number(static_cast<int64_t>(prefix.value_.length())).getInt())
-        == prefix.value_;
+        Number(static_cast<int64_t>(prefix.text().length())).getInt())
+        == prefix.text();
     }
 
-    return value_.substr(start.getInt(), end.getInt()) == prefix.value_;
+    return text().substr(start.getInt(), end.getInt()) == prefix.text();
   }
 
   bool endswith(const String& suffix) const {
-    if (suffix.value_.length() > value_.length()) return false;
-    return value_.substr(value_.length() - suffix.value_.length()) ==
-           suffix.value_;
+    return view().ends_with(suffix.view());
   }
 
   bool endswith(std::shared_ptr<String> suffix) const {
@@ -413,14 +838,36 @@ class String : public Object {
     return startswith(*prefix, *start, *end);
   }
 
+  // Builds the result in one pass, copying the text between matches
+  // instead of shifting the tail of the string on every replacement
   std::shared_ptr<String> replace(const String& oldStr,
                                   const String& newStr) const {
-    std::string result = value_;
-    size_t pos = 0;
-    while ((pos = result.find(oldStr.value_, pos)) != std::string::npos) {
-      result.replace(pos, oldStr.value_.length(), newStr.value_);
-      pos += newStr.value_.length();
+    const std::string& oldValue = oldStr.text();
+    const std::string& newValue = newStr.text();
+    std::string result;
+
+    if (oldValue.empty()) {
+      result.reserve(text().size() + (text().size() + 1) * newValue.size());
+      result += newValue;
+      for (char c : text()) {
+        result += c;
+        result += newValue;
+      }
+      return std::make_shared<String>(result);
+    }
+
+    size_t last = 0;
+    size_t pos = StringSearch::find(text(), oldValue);
+    if (pos == std::string::npos) return std::make_shared<String>(text());
+
+    result.reserve(text().size());
+    for (; pos != std::string::npos;
+         pos = StringSearch::find(text(), oldValue, last)) {
+      result.append(text(), last, pos - last);
+      result += newValue;
+      last = pos + oldValue.size();
     }
+    result.append(text(), last, std::string::npos);
 
     return std::make_shared<String>(result);
   }
@@ -431,36 +878,43 @@ class String : public Object {
   }
 
   std::shared_ptr<String> operator+(const String& other) const {
-    return std::make_shared<String>(value_ + other.value_);
+    std::string_view left = view();
+    std::string_view right = other.view();
+    std::string result;
+    result.reserve(left.size() + right.size());
+    result.append(left).append(right);
+    return std::make_shared<String>(result);
   }
 
-  std::shared_ptr<String> operator+=(const String& other) {
-    value_ += other.value_;
-    return std::shared_ptr<String>(this, [](String*){});
+  String& operator+=(const String& other) {
+    detach();
+    value_ += other.view();
+    return *this;
   }
 
   std::shared_ptr<String> operator+(const Object& other) const {
-    return std::make_shared<String>(value_ + other.toString());
+    return std::make_shared<String>(text() + other.toString());
   }
 
   std::shared_ptr<String> operator*(const Number& number) const {
     std::string result;
     int n = number.getInt();
     for (int i = 0; i < n; ++i) {
-      result += value_;
+      result += text();
     }
 
     return std::make_shared<String>(result);
   }
 
-  std::shared_ptr<String> operator*=(const Number& number) {
+  String& operator*=(const Number& number) {
     int n = number.getInt();
     std::string result;
     for (int i = 0; i < n; ++i) {
-        result += value_;
+        result += text();
     }
+    detach();
     value_ = result;
-    return std::shared_ptr<String>(this, [](String*){});
+    return *this;
   }
 
   std::shared_ptr<String> operator*(const Bool& number) const {
@@ -475,7 +929,7 @@ class String : public Object {
     std::string result;
     int n = number->getInt();
     for (int i = 0; i < n; ++i) {
-      result += value_;
+      result += text();
     }
 
     return std::make_shared<String>(result);
@@ -486,124 +940,88 @@ class String : public Object {
   }
 
   std::shared_ptr<Number> len() const {
-    return Number::spawn(static_cast<int>(value_.size()));
+    return Number::spawn(static_cast<int>(length()));
   }
 
   std::shared_ptr<Number> count(const String& sub, Number startNum = Number(0),
                                 Number endNum = Number(INT_MAX)) const {
-    int start = startNum.getInt();
-    int end = endNum.getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end || sub.value_.empty()) return std::make_shared<Number>(0);
-
-    int count = 0;
-    size_t pos = start;
-    while ((pos = value_.find(sub.value_, pos)) != std::string::npos &&
-           pos < static_cast<size_t>(end)) {
-      count++;
-      pos += sub.value_.length();
-    }
-
-    return std::make_shared<Number>(count);
+    return countIn(sub, startNum.getInt(), endNum.getInt());
   }
 
   std::shared_ptr<Number> count(
       std::shared_ptr<String> sub,
       std::shared_ptr<Number> startNum = Number::spawn(0),
       std::shared_ptr<Number> endNum = Number::spawn(INT_MAX)) const {
-    int start = startNum->getInt();
-    int end = endNum->getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end || sub->value_.empty()) return std::make_shared<Number>(0);
-
-    int count = 0;
-    size_t pos = start;
-    while ((pos = value_.find(sub->value_, pos)) != std::string::npos &&
-           pos < static_cast<size_t>(end)) {
-      count++;
-      pos += sub->value_.length();
-    }
-    return std::make_shared<Number>(count);
+    return countIn(*sub, startNum->getInt(), endNum->getInt());
   }
 
-  std::shared_ptr<String> at(const Number& pos) const {
-    int index = pos.getInt();
-    int actual_index = index;
-    if (index < 0) actual_index += value_.size();
+  // Character at a Python index, negative indices count from the end
+  std::shared_ptr<String> charAt(int64_t index) const {
+    int64_t size = static_cast<int64_t>(length());
+    if (index < 0) index += size;
 
-    if (actual_index < 0 || actual_index >= static_cast<int>(value_.size())) {
+    if (index < 0 || index >= size) {
       throw std::out_of_range("string index out of range");
     }
-    return std::make_shared<String>(std::string{value_[actual_index]});
-  }
 
-  std::shared_ptr<String> at(std::shared_ptr<Number> pos) const {
-    int index = pos->getInt();
-    int actual_index = index;
-    if (index < 0) actual_index += value_.size();
+    size_t offset = byteOffset(static_cast<size_t>(index));
+    auto lead = static_cast<unsigned char>(view()[offset]);
+    if (lead < 0x80) return character(lead);
 
-    if (actual_index < 0 || actual_index >= static_cast<int>(value_.size())) {
-      throw std::out_of_range("string index out of range");
-    }
+    return String::spawn(std::string(view().substr(
+      offset, StringUtf8::next(view(), offset) - offset)));
+  }
 
-    return std::make_shared<String>(std::string{value_[actual_index]});
+  std::shared_ptr<String> at(const Number& pos) const {
+    return charAt(pos.getInt());
   }
 
-  std::shared_ptr<String> operator[](const Number& pos) const {
-    int index = pos.getInt();
-    int actual_index = index;
-    if (index < 0) actual_index += value_.size();
+  std::shared_ptr<String> at(std::shared_ptr<Number> pos) const {
+    return charAt(pos->getInt());
+  }
 
-    if (actual_index < 0 || actual_index >= static_cast<int>(value_.size())) {
-      throw std::out_of_range("string index out of range");
-    }
-    return std::make_shared<String>(std::string{value_[actual_index]});
+  std::shared_ptr<String> operator[](const Number& pos) const {
+    return charAt(pos.getInt());
   }
 
   std::shared_ptr<String> operator[](const std::shared_ptr<Number>& pos) const {
-    int index = pos->getInt();
-    int actual_index = index;
-    if (index < 0) actual_index += value_.size();
+    return charAt(pos->getInt());
+  }
 
-    if (actual_index < 0 || actual_index >= static_cast<int>(value_.size())) {
-      throw std::out_of_range("string index out of range");
-    }
-    return std::make_shared<String>(std::string{value_[actual_index]});
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return charAt(
+      Number::indexOf(*index, "string indices must be integers, not "));
   }
 
   std::shared_ptr<String> operator[](const Slice& slice) const {
+    int size = static_cast<int>(length());
     int start = slice.start == INT_MAX ? 0 : slice.start;
-    int end = slice.end == INT_MAX ? value_.size() : slice.end;
+    int end = slice.end == INT_MAX ? size : slice.end;
     int step = slice.step == 0 ?
       throw std::invalid_argument("Step cannot be zero") : slice.step;
 
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
+    if (start < 0) start += size;
+    if (end < 0) end += size;
+
+    start = std::clamp(start, 0, size);
+    end = std::clamp(end, 0, size);
 
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
+    // contiguous slices are views of this string
+    if (step == 1) return codePoints(start, std::max(start, end));
 
+    std::string_view text = view();
     std::string result;
 
     if (step > 0) {
         for (int i = start; i < end; i += step) {
-            result += value_[i];
+            size_t offset = byteOffset(i);
+            result += text.substr(offset, StringUtf8::next(text, offset) - offset);
         }
     } else {
         for (int i = start; i > end; i += step) {
-            result += value_[i];
+            size_t offset = byteOffset(i);
+            result += text.substr(offset, StringUtf8::next(text, offset) - offset);
         }
     }
 
@@ -617,67 +1035,26 @@ class String : public Object {
     return this->operator[](*slice);
   }
 
+  // substring membership, backs the 'in' operator
+  bool contains(const String& sub) const {
+    return StringSearch::find(view(), sub.view()) != std::string::npos;
+  }
+
   std::shared_ptr<Number> find(
       std::shared_ptr<String> sub,
       std::shared_ptr<Number> startNum = Number::spawn(0),
       std::shared_ptr<Number> endNum = Number::spawn(INT_MAX)) const {
-    int start = startNum->getInt();
-    int end = endNum->getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end) return std::make_shared<Number>(-1);
-
-    size_t pos = value_.find(sub->value_, start);
-    if (pos == std::string::npos || pos >= static_cast<size_t>(end)) {
-      return std::make_shared<Number>(-1);
-    }
-
-    return std::make_shared<Number>(static_cast<int>(pos));
+    return findIn(*sub, startNum->getInt(), endNum->getInt());
   }
 
   std::shared_ptr<Number> find(const String& sub, Number startNum = Number(0),
                                Number endNum = Number(INT_MAX)) const {
-    int start = startNum.getInt();
-    int end = endNum.getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end) return std::make_shared<Number>(-1);
-
-    size_t pos = value_.find(sub.value_, start);
-    if (pos == std::string::npos || pos >= static_cast<size_t>(end)) {
-      return std::make_shared<Number>(-1);
-    }
-    return std::make_shared<Number>(static_cast<int>(pos));
+    return findIn(sub, startNum.getInt(), endNum.getInt());
   }
 
   std::shared_ptr<Number> rfind(const String& sub, Number startNum = Number(0),
                                 Number endNum = Number(INT_MAX)) const {
-    int start = startNum.getInt();
-    int end = endNum.getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end) return std::make_shared<Number>(-1);
-
-    size_t pos = value_.rfind(sub.value_, end);
-    if (pos == std::string::npos || pos < static_cast<size_t>(start)) {
-      return std::make_shared<Number>(-1);
-    }
-    return std::make_shared<Number>(static_cast<int>(pos));
+    return rfindIn(sub, startNum.getInt(), endNum.getInt());
   }
 
   std::shared_ptr<Number> index(const String& sub, Number startNum = Number(0),
@@ -703,23 +1080,7 @@ class String : public Object {
       std::shared_ptr<String> sub,
       std::shared_ptr<Number> startNum = Number::spawn(0),
       std::shared_ptr<Number> endNum = Number::spawn(INT_MAX)) const {
-    int start = startNum->getInt();
-    int end = endNum->getInt();
-    if (end == INT_MAX) end = value_.size();
-    if (start < 0) start += value_.size();
-    if (end < 0) end += value_.size();
-
-    start = std::clamp(start, 0, static_cast<int>(value_.size()));
-    end = std::clamp(end, 0, static_cast<int>(value_.size()));
-
-    if (start > end) return std::make_shared<Number>(-1);
-
-    size_t pos = value_.rfind(sub->value_, end);
-    if (pos == std::string::npos || pos < static_cast<size_t>(start)) {
-      return std::make_shared<Number>(-1);
-    }
-
-    return std::make_shared<Number>(static_cast<int>(pos));
+    return rfindIn(*sub, startNum->getInt(), endNum->getInt());
   }
 
   std::shared_ptr<Number> index(
@@ -745,13 +1106,17 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> isascii_() const {
-    return Bool::spawn(true);
+    return Bool::spawn(isAscii());
   }
 
   std::shared_ptr<Bool> isalpha() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::allOf(text(), StringAscii::CharClass::ALPHA));
+    }
     return Bool::spawn(
-        std::all_of(value_.begin(), value_.end(),
+        std::all_of(text().begin(), text().end(),
                     [](unsigned char c) { return std::isalpha(c); }));
   }
 
@@ -764,32 +1129,44 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> isdigit() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::allOf(text(), StringAscii::CharClass::DIGIT));
+    }
     return Bool::spawn(
-        std::all_of(value_.begin(), value_.end(),
+        std::all_of(text().begin(), text().end(),
                     [](unsigned char c) { return std::isdigit(c); }));
   }
 
   std::shared_ptr<Bool> isalnum() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::allOf(text(), StringAscii::CharClass::ALNUM));
+    }
     return Bool::spawn(
-        std::all_of(value_.begin(), value_.end(),
+        std::all_of(text().begin(), text().end(),
                     [](unsigned char c) { return std::isalnum(c); }));
   }
 
   std::shared_ptr<Bool> isspace() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::allOf(text(), StringAscii::CharClass::SPACE));
+    }
     return Bool::spawn(
-        std::all_of(value_.begin(), value_.end(),
+        std::all_of(text().begin(), text().end(),
                     [](unsigned char c) { return std::isspace(c); }));
   }
 
   std::shared_ptr<Bool> isidentifier() const {
-    if (value_.empty() || !(std::isalpha(value_[0]) || value_[0] == '_')) {
+    if (text().empty() || !(std::isalpha(text()[0]) || text()[0] == '_')) {
       return Bool::spawn(false);
     }
 
-    for (char c : value_) {
+    for (char c : text()) {
       if (!(std::isalnum(c) || c == '_')) {
           return Bool::spawn(false);
       }
@@ -799,7 +1176,12 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> isprintable() const {
-    for (char c : value_) {
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::allOf(text(), StringAscii::CharClass::PRINTABLE));
+    }
+
+    for (char c : text()) {
         if (!std::isprint(static_cast<unsigned char>(c))) {
             return Bool::spawn(false);
         }
@@ -808,9 +1190,15 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> isupper() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::anyOf(text(), StringAscii::CharClass::UPPER) &&
+        !StringAscii::anyOf(text(), StringAscii::CharClass::LOWER));
+    }
+
     bool hasUpper = false;
-    for (unsigned char c : value_) {
+    for (unsigned char c : text()) {
       if (std::islower(c)) return Bool::spawn(0);
       if (std::isupper(c)) hasUpper = true;
     }
@@ -818,9 +1206,15 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> islower() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
+    if (isAscii()) {
+      return Bool::spawn(
+        StringAscii::anyOf(text(), StringAscii::CharClass::LOWER) &&
+        !StringAscii::anyOf(text(), StringAscii::CharClass::UPPER));
+    }
+
     bool hasLower = false;
-    for (unsigned char c : value_) {
+    for (unsigned char c : text()) {
       if (std::isupper(c)) return Bool::spawn(0);
       if (std::islower(c)) hasLower = true;
     }
@@ -828,16 +1222,16 @@ class String : public Object {
   }
 
   std::shared_ptr<Bool> istitle() const {
-    if (value_.empty()) return Bool::spawn(0);
+    if (text().empty()) return Bool::spawn(0);
     bool prevCased = false;
     bool hasUpper = false;
 
-    for (size_t i = 0; i < value_.size(); ++i) {
-      if (std::isalpha(value_[i])) {
+    for (size_t i = 0; i < text().size(); ++i) {
+      if (std::isalpha(text()[i])) {
         if (prevCased) {
-          if (std::isupper(value_[i])) return Bool::spawn(0);
+          if (std::isupper(text()[i])) return Bool::spawn(0);
         } else {
-          if (std::islower(value_[i])) return Bool::spawn(0);
+          if (std::islower(text()[i])) return Bool::spawn(0);
           hasUpper = true;
         }
         prevCased = true;
@@ -849,36 +1243,56 @@ class String : public Object {
   }
 
   std::shared_ptr<String> join(const String& elements) {
-    std::string result;
+    std::string_view separator = view();
+    std::string_view characters = elements.view();
+    size_t count = elements.length();
+    if (count == 0) return String::spawn("");
 
-    auto it = elements.begin();
-    if (it != elements.end()) {
-        result += *it;  // Add the first element to result
-        ++it;
+    std::string result;
+    result.reserve(characters.size() + separator.size() * (count - 1));
+    for (size_t offset = 0; offset < characters.size();) {
+      if (offset > 0) result.append(separator);
 
-        for (; it != elements.end(); ++it) {
-            result += value_;
-            result += *it;
-        }
+      size_t next = StringUtf8::next(characters, offset);
+      result.append(characters.substr(offset, next - offset));
+      offset = next;
     }
 
-    return String::spawn(result);
+    return String::spawn(std::move(result));
   }
 
-
+  // The first pass checks the elements and sizes the result, the second
+  // one copies them, so the result is allocated exactly once
   template<TIterable TType>
   std::shared_ptr<String> join(const TType& elements) {
-    std::string result;
-
-    if (elements.begin() != elements.end()) {
-      result +=
-        Function::removeQuotesIfNeeded((*(elements.begin()))->toString());
-      for (auto i = elements.begin()+1; i != elements.end(); ++i) {
-          result += value_ + Function::removeQuotesIfNeeded((*i)->toString());
+    std::string_view separator = view();
+    size_t size = 0;
+    size_t index = 0;
+
+    for (const auto& element : elements) {
+      auto* item = dynamic_cast<const String*>(element.get());
+      if (item == nullptr) {
+        throw std::runtime_error(
+          "sequence item " + std::to_string(index) +
+          ": expected str instance, " + element->type() + " found"
+        );
       }
+
+      if (index > 0) size += separator.size();
+      size += item->size();
+      ++index;
     }
 
-    return String::spawn(result);
+    std::string result;
+    result.reserve(size);
+    bool first = true;
+    for (const auto& element : elements) {
+      if (!first) result.append(separator);
+      result.append(static_cast<const String*>(element.get())->view());
+      first = false;
+    }
+
+    return String::spawn(std::move(result));
   }
 
   template<TIterable TType>
@@ -888,12 +1302,12 @@ class String : public Object {
 
   std::shared_ptr<String> ljust(const Number& width,
     const String& fill = String(std::string(" "))) {
-    if (static_cast<int64_t>(value_.size()) >= width.getInt()) {
-        return String::spawn(value_);
+    if (static_cast<int64_t>(text().size()) >= width.getInt()) {
+        return String::spawn(text());
     }
 
-    return String::spawn(value_ +
-      std::string(width.getInt() - value_.size(), (*fill).c_str()[0]));
+    return String::spawn(text() +
+      std::string(width.getInt() - text().size(), (*fill).c_str()[0]));
   }
 
   std::shared_ptr<String> ljust(const std::shared_ptr<Number>& width,
@@ -902,18 +1316,18 @@ class String : public Object {
   }
 
 std::shared_ptr<String> rjust(const Number& width, const String& fill = String(" ")) {
-    size_t currentSize = value_.size();
+    size_t currentSize = text().size();
     int64_t targetWidth = width.getInt();
 
     if (currentSize >= static_cast<size_t>(targetWidth)) {
-        return String::spawn(value_);
+        return String::spawn(text());
     }
 
     char fillChar = (!(*fill).empty()) ? (*fill).c_str()[0] : ' ';
 
     size_t paddingSize = targetWidth - currentSize;
 
-    return String::spawn(std::string(paddingSize, fillChar) + value_);
+    return String::spawn(std::string(paddingSize, fillChar) + text());
   }
 
   std::shared_ptr<String> rjust(const std::shared_ptr<Number>& width,
@@ -922,18 +1336,8 @@ std::shared_ptr<String> rjust(const Number& width, const String& fill = String("
   }
 
   std::shared_ptr<String> swapcase() {
-    std::string result;
-
-    for (char c : value_) {
-        if (std::isalpha(static_cast<unsigned char>(c))) {
-            result += std::isupper(static_cast<unsigned char>(c)) ?
-                std::tolower(static_cast<unsigned char>(c)) :
-                std::toupper(static_cast<unsigned char>(c));
-        } else {
-            result += c;
-        }
-    }
-
+    std::string result = text();
+    StringAscii::swapCase(result);
     return String::spawn(result);
   }
 
@@ -942,7 +1346,7 @@ std::shared_ptr<String> rjust(const Number& width, const String& fill = String("
     
     bool newWord = true;
 
-    for ( char c : value_ ) {
+    for ( char c : text() ) {
       if (std::isalpha(static_cast<unsigned char>(c))) {
         result += newWord ?
           std::toupper(static_cast<unsigned char>(c))
@@ -958,24 +1362,24 @@ std::shared_ptr<String> rjust(const Number& width, const String& fill = String("
   }
 
   std::shared_ptr<String> zfill(const Number& width) const {
-    int64_t amount = width.getInt() - static_cast<int64_t>(value_.length());
+    int64_t amount = width.getInt() - static_cast<int64_t>(text().length());
     std::string result;
 
     if (amount > 0) {
-      if (!value_.empty() && (value_[0] == '+' || value_[0] == '-')) {
-        result += value_[0]; 
+      if (!text().empty() && (text()[0] == '+' || text()[0] == '-')) {
+        result += text()[0]; 
         for (int64_t current = 0; current < amount; ++current) {
           result += '0'; 
         }
-        result += value_.substr(1); 
+        result += text().substr(1); 
       } else {
         for (int64_t current = 0; current < amount; ++current) {
           result += '0';
         }
-        result += value_;
+        result += text();
       }
     } else {
-      result = value_;
+      result = text();
     }
 
     return String::spawn(result);
@@ -1018,28 +1422,59 @@ std::shared_ptr<String> rjust(const Number& width, const String& fill = String("
 
   friend std::shared_ptr<String> operator+(const std::shared_ptr<Object>& first,
     const std::shared_ptr<String>& second) {
-    return std::make_shared<String>(first->toString() + second->value_);
+    return std::make_shared<String>(first->toString() + second->text());
   }
 
   friend std::shared_ptr<String> operator+(const std::shared_ptr<String>& first,
     const std::shared_ptr<Object>& second) {
-    return std::make_shared<String>(first->value_ + second->toString());
+    return std::make_shared<String>(first->text() + second->toString());
+  }
+
+  // Concatenating onto a temporary that nobody else holds reuses its buffer,
+  // so chains like a + b + c grow one string instead of one per operator
+  friend std::shared_ptr<String> operator+(std::shared_ptr<String>&& first,
+    const std::shared_ptr<String>& second) {
+    if (first.use_count() != 1) return *first + *second;
+
+    first->operator+=(*second);
+    return std::move(first);
   }
 
-  friend std::shared_ptr<String> operator+=(const std::shared_ptr<String>& lhs,
+  // Augmented assignment appends in place only when lhs is the sole owner
+  // of the string, otherwise lhs is rebound to a new one and every other
+  // reference keeps seeing the old value, as Python's immutable str does
+  friend std::shared_ptr<String>& operator+=(std::shared_ptr<String>& lhs,
     const std::shared_ptr<String>& rhs) {
-    return lhs->operator+=( *rhs );
+    if (lhs.use_count() != 1) {
+      lhs = *lhs + *rhs;
+      return lhs;
+    }
+
+    lhs->operator+=( *rhs );
+    return lhs;
   }
 
-  friend std::shared_ptr<String> operator+=(const std::shared_ptr<String>& lhs,
+  friend std::shared_ptr<String>& operator+=(std::shared_ptr<String>& lhs,
     const std::shared_ptr<Object>& rhs) {
-    return lhs->operator+=( String(rhs->toString()) );
+    return lhs += String::spawn(rhs->toString());
   }
 
-  friend std::shared_ptr<String> operator*=(const std::shared_ptr<String>& lhs,
+  friend std::shared_ptr<String>& operator*=(std::shared_ptr<String>& lhs,
     const std::shared_ptr<Number>& rhs) {
-    return lhs->operator*=( *rhs );
+    if (lhs.use_count() != 1) {
+      lhs = *lhs * *rhs;
+      return lhs;
+    }
+
+    lhs->operator*=( *rhs );
+    return lhs;
   }
 };
 
+inline bool textOf(const Object& object, std::string_view& text) {
+  if (typeid(object) != typeid(String)) return false;
+  text = static_cast<const String&>(object).view();
+  return true;
+}
+
 #endif  // STRING_HPP
\ No newline at end of file
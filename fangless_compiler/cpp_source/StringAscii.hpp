@@ -0,0 +1,232 @@
+#ifndef STRING_ASCII_HPP
+#define STRING_ASCII_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Character classification and case kernels for the String methods. Bytes
+// are tested 16 at a time with range compares, which is exact for ASCII
+// text; callers fall back to the byte by byte <cctype> loops otherwise.
+// The case kernels only touch 'a'-'z' and 'A'-'Z', so they are safe on any
+// buffer.
+class StringAscii {
+ public:
+  enum class CharClass { ALPHA, DIGIT, ALNUM, SPACE, UPPER, LOWER, PRINTABLE };
+
+ private:
+  static constexpr size_t BLOCK = 16;
+
+  static bool inRange(unsigned char c, unsigned char low, unsigned char high) {
+    return low <= c && c <= high;
+  }
+
+  // Python's classification for a single ASCII character, which counts
+  // \x1c-\x1f as whitespace unlike <cctype>
+  static bool inClass(unsigned char c, CharClass charClass) {
+    switch (charClass) {
+      case CharClass::ALPHA:
+        return inRange(c, 'A', 'Z') || inRange(c, 'a', 'z');
+      case CharClass::DIGIT:
+        return inRange(c, '0', '9');
+      case CharClass::ALNUM:
+        return inClass(c, CharClass::ALPHA) || inClass(c, CharClass::DIGIT);
+      case CharClass::SPACE:
+        return inRange(c, '\t', '\r') || inRange(c, 0x1c, ' ');
+      case CharClass::UPPER:
+        return inRange(c, 'A', 'Z');
+      case CharClass::LOWER:
+        return inRange(c, 'a', 'z');
+      case CharClass::PRINTABLE:
+        return inRange(c, ' ', '~');
+    }
+    return false;
+  }
+
+#ifdef __SSE2__
+  static __m128i load(const char* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  }
+
+  // Signed compares, bytes >= 0x80 are negative and never in range
+  static __m128i inRange(__m128i block, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(low - 1)),
+                         _mm_cmplt_epi8(block, _mm_set1_epi8(high + 1)));
+  }
+
+  static __m128i inClass(__m128i block, CharClass charClass) {
+    switch (charClass) {
+      case CharClass::ALPHA:
+        return _mm_or_si128(inRange(block, 'A', 'Z'),
+                            inRange(block, 'a', 'z'));
+      case CharClass::DIGIT:
+        return inRange(block, '0', '9');
+      case CharClass::ALNUM:
+        return _mm_or_si128(inClass(block, CharClass::ALPHA),
+                            inClass(block, CharClass::DIGIT));
+      case CharClass::SPACE:
+        return _mm_or_si128(inRange(block, '\t', '\r'),
+                            inRange(block, 0x1c, ' '));
+      case CharClass::UPPER:
+        return inRange(block, 'A', 'Z');
+      case CharClass::LOWER:
+        return inRange(block, 'a', 'z');
+      case CharClass::PRINTABLE:
+        return inRange(block, ' ', '~');
+    }
+    return _mm_setzero_si128();
+  }
+
+  // Flips bit 5 (the ASCII case bit) of every byte selected by the mask
+  static void flipCase(char* data, size_t size, char low, char high,
+                       bool both) {
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    size_t i = 0;
+
+    for (; i + BLOCK <= size; i += BLOCK) {
+      __m128i block = load(data + i);
+      __m128i mask = inRange(block, low, high);
+      if (both) mask = _mm_or_si128(mask, inRange(block, 'a', 'z'));
+      if (_mm_movemask_epi8(mask) == 0) continue;
+
+      block = _mm_xor_si128(block, _mm_and_si128(mask, caseBit));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), block);
+    }
+
+    for (; i < size; ++i) {
+      unsigned char c = static_cast<unsigned char>(data[i]);
+      if (inRange(c, low, high) || (both && inRange(c, 'a', 'z'))) {
+        data[i] = static_cast<char>(c ^ 0x20);
+      }
+    }
+  }
+#else
+  static void flipCase(char* data, size_t size, char low, char high,
+                       bool both) {
+    for (size_t i = 0; i < size; ++i) {
+      unsigned char c = static_cast<unsigned char>(data[i]);
+      if (inRange(c, low, high) || (both && inRange(c, 'a', 'z'))) {
+        data[i] = static_cast<char>(c ^ 0x20);
+      }
+    }
+  }
+#endif
+
+ public:
+  static bool isAscii(std::string_view text) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    __m128i seen = _mm_setzero_si128();
+    for (; i + BLOCK <= text.size(); i += BLOCK) {
+      seen = _mm_or_si128(seen, load(text.data() + i));
+    }
+    if (_mm_movemask_epi8(seen) != 0) return false;
+#endif
+
+    for (; i < text.size(); ++i) {
+      if (static_cast<unsigned char>(text[i]) >= 0x80) return false;
+    }
+    return true;
+  }
+
+  // Every character of an ASCII text belongs to the class
+  static bool allOf(std::string_view text, CharClass charClass) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + BLOCK <= text.size(); i += BLOCK) {
+      __m128i mask = inClass(load(text.data() + i), charClass);
+      if (_mm_movemask_epi8(mask) != 0xffff) return false;
+    }
+#endif
+
+    for (; i < text.size(); ++i) {
+      if (!inClass(static_cast<unsigned char>(text[i]), charClass)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Some character of an ASCII text belongs to the class
+  static bool anyOf(std::string_view text, CharClass charClass) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + BLOCK <= text.size(); i += BLOCK) {
+      __m128i mask = inClass(load(text.data() + i), charClass);
+      if (_mm_movemask_epi8(mask) != 0) return true;
+    }
+#endif
+
+    for (; i < text.size(); ++i) {
+      if (inClass(static_cast<unsigned char>(text[i]), charClass)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void toUpper(std::string& text) {
+    flipCase(text.data(), text.size(), 'a', 'z', false);
+  }
+
+  static void toLower(std::string& text) {
+    flipCase(text.data(), text.size(), 'A', 'Z', false);
+  }
+
+  static void swapCase(std::string& text) {
+    flipCase(text.data(), text.size(), 'A', 'Z', true);
+  }
+
+  static bool isSpace(char c) {
+    return inClass(static_cast<unsigned char>(c), CharClass::SPACE);
+  }
+
+  // Calls visit with each run of non whitespace bytes, the fields that
+  // str.split() without a separator returns
+  template <typename TVisitor>
+  static void forEachField(std::string_view text, TVisitor&& visit) {
+    size_t position = 0;
+    while (position < text.size()) {
+      while (position < text.size() && isSpace(text[position])) ++position;
+      size_t start = position;
+      while (position < text.size() && !isSpace(text[position])) ++position;
+      if (position > start) visit(text.substr(start, position - start));
+    }
+  }
+
+  // Bounds [first, second) of text once the bytes in chars are removed
+  // from the requested ends. One table lookup per byte instead of a scan
+  // of chars for every byte
+  static std::pair<size_t, size_t> stripBounds(std::string_view text,
+                                               std::string_view chars,
+                                               bool left, bool right) {
+    std::array<bool, 256> strip{};
+    for (char c : chars) strip[static_cast<unsigned char>(c)] = true;
+
+    size_t first = 0;
+    size_t last = text.size();
+    if (left) {
+      while (first < last && strip[static_cast<unsigned char>(text[first])]) {
+        ++first;
+      }
+    }
+    if (right) {
+      while (last > first && strip[static_cast<unsigned char>(text[last - 1])]) {
+        --last;
+      }
+    }
+
+    return {first, last};
+  }
+};
+
+#endif  // STRING_ASCII_HPP
@@ -0,0 +1,626 @@
+#ifndef STRING_FORMAT_HPP
+#define STRING_FORMAT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Bool.hpp"
+#include "Number.hpp"
+#include "NumberFormat.hpp"
+#include "Object.hpp"
+#include "String.hpp"
+#include "StringUtf8.hpp"
+#include "Tuple.hpp"
+
+// Runtime side of f-strings, str.format and the % operator. The code
+// generator parses the templates and their format specs at compile time
+// and emits the pieces, so formatting only renders the fields: numbers go
+// through std::to_chars into a reused scratch buffer, strings are read in
+// place, and the result is allocated once all of them are sized
+class StringFormat {
+ public:
+  // A parsed [[fill]align][sign][z][#][0][width][grouping][.precision][type]
+  // spec, an empty fill or a null align take the defaults of the value.
+  // The generated code sets the parts it uses, Spec().align('>').width(6)
+  class Spec {
+    friend class StringFormat;
+
+    std::string_view fill_;
+    char align_ = '\0';
+    char sign_ = '-';
+    bool noNegativeZero_ = false;
+    bool alternate_ = false;
+    bool zero_ = false;
+    int width_ = 0;
+    char grouping_ = '\0';
+    int precision_ = -1;
+    char type_ = '\0';
+    // 's' or 'r', the value is converted to a string before formatting
+    char conversion_ = '\0';
+    // printf style field: strings align right and %d takes floats
+    bool percent_ = false;
+
+   public:
+    Spec& fill(std::string_view value) { fill_ = value; return *this; }
+    Spec& align(char value) { align_ = value; return *this; }
+    Spec& sign(char value) { sign_ = value; return *this; }
+    Spec& noNegativeZero(bool value) { noNegativeZero_ = value; return *this; }
+    Spec& alternate(bool value) { alternate_ = value; return *this; }
+    Spec& zero(bool value) { zero_ = value; return *this; }
+    Spec& width(int value) { width_ = value; return *this; }
+    Spec& grouping(char value) { grouping_ = value; return *this; }
+    Spec& precision(int value) { precision_ = value; return *this; }
+    Spec& type(char value) { type_ = value; return *this; }
+    Spec& conversion(char value) { conversion_ = value; return *this; }
+    Spec& percent(bool value) { percent_ = value; return *this; }
+  };
+
+  // Literal text, or the field that formats the argument at that index
+  class Piece {
+    friend class StringFormat;
+
+    std::string_view text_;
+    int argument_ = -1;
+    Spec spec_;
+
+   public:
+    // implicit, the generated code lists text pieces as plain literals
+    Piece(const char* text) : text_(text) {}
+    Piece(int argument, const Spec& spec) : argument_(argument), spec_(spec) {}
+  };
+
+ private:
+  // A rendered field, its text lives in the scratch buffer unless it is
+  // read in place from a string
+  struct Field {
+    size_t prefix = 0;
+    size_t prefixSize = 0;
+    size_t body = 0;
+    size_t bodySize = 0;
+    std::string_view view;
+    bool inPlace = false;
+    std::string_view fill;
+    size_t left = 0;
+    size_t inner = 0;
+    size_t right = 0;
+  };
+
+  static constexpr size_t NUMBER_BUFFER = 128;
+
+  static std::string& scratch() {
+    thread_local std::string buffer;
+    return buffer;
+  }
+
+  static std::vector<Field>& fields() {
+    thread_local std::vector<Field> rendered;
+    return rendered;
+  }
+
+  static std::runtime_error unknownCode(char type, const std::string& name) {
+    return std::runtime_error(std::string("Unknown format code '") + type +
+                              "' for object of type '" + name + "'");
+  }
+
+  static bool isDefault(const Spec& spec) {
+    return spec.fill_.empty() && spec.align_ == '\0' && spec.sign_ == '-' &&
+           !spec.alternate_ && !spec.zero_ && spec.width_ == 0 &&
+           spec.grouping_ == '\0' && spec.precision_ < 0 && spec.type_ == '\0';
+  }
+
+  // Pads the field up to the spec width with the alignment the value
+  // takes by default
+  static void pad(Field& field, const Spec& spec, size_t width, bool number) {
+    field.fill = spec.fill_;
+    if (field.fill.empty()) {
+      field.fill = spec.zero_ && (number || !spec.percent_) ? "0" : " ";
+    }
+
+    char align = spec.align_;
+    if (align == '\0') {
+      if (number) {
+        align = spec.zero_ ? '=' : '>';
+      } else {
+        align = spec.percent_ ? '>' : '<';
+      }
+    }
+
+    size_t target = static_cast<size_t>(spec.width_);
+    if (width >= target) return;
+
+    size_t padding = target - width;
+    switch (align) {
+      case '<': field.right = padding; break;
+      case '>': field.left = padding; break;
+      case '=': field.inner = padding; break;
+      default:
+        field.left = padding / 2;
+        field.right = padding - field.left;
+    }
+  }
+
+  // Appends digits to the scratch buffer, separating the first intSize
+  // ones in groups. A zero filled field grows its integer part with
+  // grouped zeros instead of padding, until it takes minWidth
+  static void appendGrouped(std::string& out, std::string_view digits,
+                            size_t intSize, char separator, size_t group,
+                            size_t minWidth) {
+    auto groupedSize = [&](size_t count) {
+      return count + (separator != '\0' && count > 0 ? (count - 1) / group : 0);
+    };
+
+    size_t count = intSize;
+    size_t rest = digits.size() - intSize;
+    while (groupedSize(count) + rest < minWidth) ++count;
+
+    for (size_t i = 0; i < count; ++i) {
+      size_t remaining = count - i;
+      if (i > 0 && separator != '\0' && remaining % group == 0) {
+        out += separator;
+      }
+      out += i < count - intSize ? '0' : digits[i - (count - intSize)];
+    }
+    out.append(digits.substr(intSize));
+  }
+
+  static void appendSign(std::string& out, bool negative, char sign) {
+    if (negative) {
+      out += '-';
+    } else if (sign == '+' || sign == ' ') {
+      out += sign;
+    }
+  }
+
+  // Zero filled fields move the padding inside the grouped digits
+  static size_t zeroWidth(const Spec& spec, size_t prefixSize) {
+    bool zeroFill = (spec.fill_.empty() && spec.zero_) || spec.fill_ == "0";
+    bool inner = spec.align_ == '=' || (spec.align_ == '\0' && spec.zero_);
+    if (!zeroFill || !inner || spec.grouping_ == '\0') return 0;
+
+    size_t width = static_cast<size_t>(spec.width_);
+    return width > prefixSize ? width - prefixSize : 0;
+  }
+
+  // `big` holds the value instead when it is outside the int64 range
+  static void renderInteger(int64_t value, const Spec& spec, Field& field,
+                            const BigInt* big = nullptr) {
+    std::string& out = scratch();
+    char type = spec.type_ == '\0' || spec.type_ == 'n' ? 'd' : spec.type_;
+
+    switch (type) {
+      case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case '%':
+        renderFloat(big ? big->toDouble() : static_cast<double>(value), spec,
+                    field);
+        return;
+      case 'c':
+        field.body = out.size();
+        if (big || value < 0 || value > StringUtf8::MAX_CODE_POINT) {
+          throw std::overflow_error("%c arg not in range(0x110000)");
+        }
+        out += StringUtf8::encode(static_cast<uint32_t>(value));
+        field.bodySize = out.size() - field.body;
+        pad(field, spec, 1, true);
+        return;
+      case 'd': case 'b': case 'o': case 'x': case 'X':
+        break;
+      default:
+        throw unknownCode(type, "int");
+    }
+
+    if (spec.precision_ >= 0 && !spec.percent_) {
+      throw std::runtime_error(
+        "Precision not allowed in integer format specifier");
+    }
+    if (spec.grouping_ == ',' && type != 'd') {
+      throw std::runtime_error(std::string("Cannot specify ',' with '") +
+                               type + "'.");
+    }
+
+    int base = type == 'b' ? 2 : type == 'o' ? 8 : type == 'd' ? 10 : 16;
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                   : static_cast<uint64_t>(value);
+    std::array<char, 72> digits;
+    char* end = std::to_chars(digits.data(), digits.data() + digits.size(),
+                              magnitude, base).ptr;
+    std::string_view text(digits.data(), end - digits.data());
+    std::string bigDigits;
+    if (big) [[unlikely]] {
+      bigDigits = big->abs().toString(base);
+      text = bigDigits;
+    }
+
+    field.prefix = out.size();
+    appendSign(out, big ? big->isNegative() : value < 0, spec.sign_);
+    if (spec.alternate_ && type != 'd') {
+      out += '0';
+      out += type;
+    }
+    field.prefixSize = out.size() - field.prefix;
+
+    // printf precision is a minimum number of digits
+    std::string padded;
+    if (spec.percent_ && spec.precision_ > static_cast<int>(text.size())) {
+      padded.assign(spec.precision_ - text.size(), '0');
+      padded.append(text);
+      text = padded;
+    }
+
+    field.body = out.size();
+    size_t bodyStart = out.size();
+    appendGrouped(out, text, text.size(), spec.grouping_, base == 10 ? 3 : 4,
+                  zeroWidth(spec, field.prefixSize));
+    if (type == 'X') {
+      for (size_t i = bodyStart; i < out.size(); ++i) {
+        out[i] = static_cast<char>(std::toupper(out[i]));
+      }
+    }
+    field.bodySize = out.size() - field.body;
+
+    pad(field, spec, field.prefixSize + field.bodySize, true);
+  }
+
+  // Digits of |value| in general format, which keeps significant digits:
+  // fixed point unless the exponent is below -4 or reaches the threshold
+  static std::string_view general(char* buffer, char* end, double value,
+                                  int precision, int threshold,
+                                  bool keepZeros) {
+    char* last = std::to_chars(buffer, end, value,
+                               std::chars_format::scientific,
+                               precision - 1).ptr;
+    std::string_view text(buffer, last - buffer);
+    // the text is not terminated, so parse only up to its end; to_chars
+    // always writes the exponent sign
+    size_t sign = text.find('e') + 1;
+    int exponent = 0;
+    std::from_chars(text.data() + sign + 1, last, exponent);
+    if (text[sign] == '-') exponent = -exponent;
+
+    if (-4 <= exponent && exponent < threshold) {
+      last = std::to_chars(buffer, end, value, std::chars_format::fixed,
+                           precision - 1 - exponent).ptr;
+      text = std::string_view(buffer, last - buffer);
+    }
+    if (keepZeros) return text;
+
+    // strip the trailing zeros of the mantissa
+    size_t mantissaEnd = std::min(text.find('e'), text.size());
+    if (text.substr(0, mantissaEnd).find('.') == std::string_view::npos) {
+      return text;
+    }
+    size_t cut = mantissaEnd;
+    while (text[cut - 1] == '0') --cut;
+    if (text[cut - 1] == '.') --cut;
+    if (cut == mantissaEnd) return text;
+
+    std::copy(text.begin() + mantissaEnd, text.end(), buffer + cut);
+    return std::string_view(buffer, cut + text.size() - mantissaEnd);
+  }
+
+  static void renderFloat(double value, const Spec& spec, Field& field) {
+    std::string& out = scratch();
+    char type = spec.type_ == 'n' ? 'g' : spec.type_;
+
+    switch (type) {
+      case '\0': case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+      case '%':
+        break;
+      default:
+        throw unknownCode(type, "float");
+    }
+    bool negative = std::signbit(value) && !std::isnan(value);
+    double magnitude = std::fabs(value);
+    bool upper = type == 'E' || type == 'F' || type == 'G';
+
+    std::array<char, NUMBER_BUFFER> buffer;
+    std::string spill;
+    std::string_view text;
+
+    if (std::isinf(magnitude) || std::isnan(magnitude)) {
+      text = std::isnan(magnitude) ? (upper ? "NAN" : "nan")
+                                   : (upper ? "INF" : "inf");
+    } else if (type == '\0' && spec.precision_ < 0) {
+      char* end = NumberFormat::writeFloat(buffer.data(), magnitude);
+      text = std::string_view(buffer.data(), end - buffer.data());
+    } else {
+      int precision = spec.precision_ < 0 ? 6 : spec.precision_;
+      double scaled = type == '%' ? magnitude * 100 : magnitude;
+
+      // fixed point text of huge values does not fit the local buffer
+      char* first = buffer.data();
+      char* last = buffer.data() + buffer.size();
+      bool fixed = type == 'f' || type == 'F' || type == '%';
+      if (fixed && (scaled >= 1e60 || precision > 60)) {
+        spill.resize(320 + precision);
+        first = spill.data();
+        last = spill.data() + spill.size();
+      } else if (precision > 60) {
+        spill.resize(32 + precision);
+        first = spill.data();
+        last = spill.data() + spill.size();
+      }
+
+      if (fixed) {
+        auto result = std::to_chars(first, last, scaled,
+                                    std::chars_format::fixed, precision);
+        text = std::string_view(first, result.ptr - first);
+      } else if (type == 'e' || type == 'E') {
+        auto result = std::to_chars(first, last, scaled,
+                                    std::chars_format::scientific, precision);
+        text = std::string_view(first, result.ptr - first);
+      } else if (type == '\0') {
+        // like 'g' but fixed point keeps a decimal and yields sooner
+        int significant = std::max(precision, 1);
+        text = general(first, last, scaled, significant, significant - 1,
+                       spec.alternate_);
+        if (text.find_first_of(".e") == std::string_view::npos) {
+          first[text.size()] = '.';
+          first[text.size() + 1] = '0';
+          text = std::string_view(first, text.size() + 2);
+        }
+      } else {
+        int significant = std::max(precision, 1);
+        text = general(first, last, scaled, significant, significant,
+                       spec.alternate_);
+      }
+
+      if (spec.alternate_ && text.find('.') == std::string_view::npos) {
+        size_t exponent = std::min(text.find('e'), text.size());
+        std::string dotted(text.substr(0, exponent));
+        dotted += '.';
+        dotted.append(text.substr(exponent));
+        spill = std::move(dotted);
+        text = spill;
+      }
+    }
+
+    if (negative && spec.noNegativeZero_) {
+      size_t mantissaEnd = std::min(text.find('e'), text.size());
+      negative = text.substr(0, mantissaEnd).find_first_of("123456789") !=
+                 std::string_view::npos;
+    }
+
+    field.prefix = out.size();
+    appendSign(out, negative, spec.sign_);
+    field.prefixSize = out.size() - field.prefix;
+
+    field.body = out.size();
+    size_t intSize = std::min(text.find_first_not_of("0123456789"),
+                              text.size());
+    size_t minWidth = zeroWidth(spec, field.prefixSize + (type == '%'));
+    if (!std::isfinite(magnitude)) {
+      appendGrouped(out, text, intSize, '\0', 3, 0);
+    } else {
+      appendGrouped(out, text, intSize, spec.grouping_, 3, minWidth);
+    }
+    if (type == '%') out += '%';
+    if (upper) {
+      for (size_t i = field.body; i < out.size(); ++i) {
+        out[i] = static_cast<char>(std::toupper(out[i]));
+      }
+    }
+    field.bodySize = out.size() - field.body;
+
+    pad(field, spec, field.prefixSize + field.bodySize, true);
+  }
+
+  static void renderText(std::string_view text, bool inPlace,
+                         const Spec& spec, Field& field) {
+    if (spec.type_ != '\0' && spec.type_ != 's') {
+      throw unknownCode(spec.type_, "str");
+    }
+    if (!spec.percent_) {
+      if (spec.sign_ != '-') {
+        throw std::runtime_error(
+          "Sign not allowed in string format specifier");
+      }
+      if (spec.alternate_) {
+        throw std::runtime_error(
+          "Alternate form (#) not allowed in string format specifier");
+      }
+      if (spec.align_ == '=') {
+        throw std::runtime_error(
+          "'=' alignment not allowed in string format specifier");
+      }
+      if (spec.grouping_ != '\0') {
+        throw std::runtime_error(std::string("Cannot specify '") +
+                                 spec.grouping_ + "' with 's'.");
+      }
+    }
+
+    // the precision keeps that many code points
+    size_t width = StringUtf8::count(text);
+    if (spec.precision_ >= 0 && static_cast<size_t>(spec.precision_) < width) {
+      size_t offset = 0;
+      for (int i = 0; i < spec.precision_; ++i) {
+        offset = StringUtf8::next(text, offset);
+      }
+      text = text.substr(0, offset);
+      width = static_cast<size_t>(spec.precision_);
+    }
+
+    if (inPlace) {
+      field.inPlace = true;
+      field.view = text;
+    } else {
+      field.body = scratch().size();
+      scratch().append(text);
+    }
+    field.bodySize = text.size();
+
+    pad(field, spec, width, false);
+  }
+
+  // !s and !r fields format the text of the value
+  static void renderConverted(const std::string& text, const Spec& spec,
+                              Field& field) {
+    Spec asText = spec;
+    asText.conversion_ = '\0';
+    renderText(text, false, asText, field);
+  }
+
+  static void render(const Object* value, const Spec& spec, Field& field) {
+    auto* string = dynamic_cast<const String*>(value);
+
+    if (spec.conversion_ == 'r') {
+      renderConverted(value->toString(), spec, field);
+      return;
+    }
+    if (spec.conversion_ == 's' && string == nullptr) {
+      renderConverted(value->toString(), spec, field);
+      return;
+    }
+
+    if (string != nullptr) {
+      // %c takes a single character as well
+      Spec asText = spec;
+      if (spec.percent_ && spec.type_ == 'c' && string->length() == 1) {
+        asText.type_ = '\0';
+      }
+      renderText(string->view(), true, asText, field);
+      return;
+    }
+
+    if (auto* number = dynamic_cast<const Number*>(value)) {
+      if (number->isBig()) [[unlikely]] {
+        BigInt big = number->toBigInt();
+        renderInteger(0, spec, field, &big);
+        return;
+      }
+      if (!number->isDouble()) {
+        renderInteger(number->getInt(), spec, field);
+        return;
+      }
+
+      // %d and %i truncate floats, the other integer codes reject them
+      if (spec.percent_ && spec.type_ == 'd') {
+        double value = number->getDouble();
+        if (std::isfinite(value) && std::fabs(value) >= 9223372036854775808.0) {
+          BigInt big = BigInt::fromDouble(value);
+          renderInteger(0, spec, field, &big);
+          return;
+        }
+        renderInteger(static_cast<int64_t>(value), spec, field);
+        return;
+      }
+      if (spec.percent_ && spec.type_ != '\0' &&
+          std::string_view("oxXc").find(spec.type_) != std::string_view::npos) {
+        throw std::runtime_error(std::string("%") + spec.type_ +
+                                 " format: an integer is required, not float");
+      }
+      renderFloat(number->getDouble(), spec, field);
+      return;
+    }
+
+    // bool formats as an int unless the spec is empty
+    if (auto* boolean = dynamic_cast<const Bool*>(value)) {
+      if (isDefault(spec)) {
+        renderText(boolean->toBool() ? "True" : "False", false, spec, field);
+      } else {
+        renderInteger(boolean->toBool() ? 1 : 0, spec, field);
+      }
+      return;
+    }
+
+    if (!isDefault(spec)) {
+      throw std::runtime_error("unsupported format string passed to " +
+                               value->type() + ".__format__");
+    }
+    renderConverted(value->toString(), spec, field);
+  }
+
+  static std::shared_ptr<String> build(std::initializer_list<Piece> pieces,
+                                       const Object* const* values) {
+    std::string& out = scratch();
+    std::vector<Field>& rendered = fields();
+    out.clear();
+    rendered.clear();
+
+    // first pass, render the fields and size the result
+    size_t size = 0;
+    for (const Piece& piece : pieces) {
+      if (piece.argument_ < 0) {
+        size += piece.text_.size();
+        continue;
+      }
+
+      Field& field = rendered.emplace_back();
+      render(values[piece.argument_], piece.spec_, field);
+      size += field.prefixSize + field.bodySize +
+        (field.left + field.inner + field.right) * field.fill.size();
+    }
+
+    std::string result;
+    result.reserve(size);
+    auto fill = [&result](std::string_view with, size_t count) {
+      for (size_t i = 0; i < count; ++i) result.append(with);
+    };
+
+    size_t next = 0;
+    for (const Piece& piece : pieces) {
+      if (piece.argument_ < 0) {
+        result.append(piece.text_);
+        continue;
+      }
+
+      const Field& field = rendered[next++];
+      fill(field.fill, field.left);
+      result.append(out, field.prefix, field.prefixSize);
+      fill(field.fill, field.inner);
+      if (field.inPlace) {
+        result.append(field.view);
+      } else {
+        result.append(out, field.body, field.bodySize);
+      }
+      fill(field.fill, field.right);
+    }
+
+    return String::spawn(std::move(result));
+  }
+
+ public:
+  // str.format, f-strings and % with a tuple literal, the arguments are
+  // passed in the order the fields refer to them
+  template <typename... Args>
+  static std::shared_ptr<String> format(std::initializer_list<Piece> pieces,
+                                        const std::shared_ptr<Args>&... args) {
+    std::array<const Object*, sizeof...(Args)> values{args.get()...};
+    return build(pieces, values.data());
+  }
+
+  // text % value, a tuple holds the arguments and anything else is the
+  // only one
+  template <typename T>
+  static std::shared_ptr<String> percent(std::initializer_list<Piece> pieces,
+                                         size_t count,
+                                         const std::shared_ptr<T>& value) {
+    std::vector<const Object*> values;
+    if (auto* tuple = dynamic_cast<const Tuple*>(value.get())) {
+      for (const auto& element : *tuple) values.push_back(element.get());
+    } else {
+      values.push_back(value.get());
+    }
+
+    if (values.size() < count) {
+      throw std::runtime_error("not enough arguments for format string");
+    }
+    if (values.size() > count) {
+      throw std::runtime_error(
+        "not all arguments converted during string formatting");
+    }
+    return build(pieces, values.data());
+  }
+};
+
+#endif  // STRING_FORMAT_HPP
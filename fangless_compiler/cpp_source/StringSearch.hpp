@@ -0,0 +1,254 @@
+#ifndef STRING_SEARCH_HPP
+#define STRING_SEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FANGLESS_X86_SIMD 1
+#endif
+
+#include "StringUtf8.hpp"
+
+// Substring search kernels used by the String methods. Candidates are found
+// by comparing the first and last byte of the needle against a whole block
+// of the haystack at once (SSE2, or AVX2 when the CPU has it), only those
+// are verified with memcmp. Long needles go to glibc's memmem, a two way
+// search that stays linear on adversarial inputs.
+class StringSearch {
+  static constexpr size_t NPOS = std::string_view::npos;
+  static constexpr size_t TWO_WAY_MIN_NEEDLE = 64;
+
+#ifdef FANGLESS_X86_SIMD
+  static bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+  }
+
+  __attribute__((target("avx2")))
+  static size_t findAvx2(const char* text, size_t size, const char* needle,
+                         size_t length) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+    size_t i = 0;
+
+    for (; i + length - 1 + 32 <= size; i += 32) {
+      const __m256i blockFirst =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+      const __m256i blockLast = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(text + i + length - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst),
+                         _mm256_cmpeq_epi8(last, blockLast))));
+
+      while (mask != 0) {
+        size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+        if (std::memcmp(text + candidate + 1, needle + 1, length - 2) == 0) {
+          return candidate;
+        }
+        mask &= mask - 1;
+      }
+    }
+
+    return findScalar(text, size, needle, length, i);
+  }
+
+  __attribute__((target("avx2")))
+  static size_t rfindAvx2(const char* text, size_t size, const char* needle,
+                          size_t length) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+    // candidates start in [0, end)
+    size_t end = size - length + 1;
+
+    for (; end >= 32; end -= 32) {
+      size_t i = end - 32;
+      const __m256i blockFirst =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+      const __m256i blockLast = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(text + i + length - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst),
+                         _mm256_cmpeq_epi8(last, blockLast))));
+
+      while (mask != 0) {
+        size_t candidate = i + 31 - static_cast<size_t>(__builtin_clz(mask));
+        if (std::memcmp(text + candidate + 1, needle + 1, length - 2) == 0) {
+          return candidate;
+        }
+        mask &= ~(1u << (31 - __builtin_clz(mask)));
+      }
+    }
+
+    return rfindScalar(text, needle, length, end);
+  }
+
+  static size_t findSse2(const char* text, size_t size, const char* needle,
+                         size_t length) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[length - 1]);
+    size_t i = 0;
+
+    for (; i + length - 1 + 16 <= size; i += 16) {
+      const __m128i blockFirst =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+      const __m128i blockLast = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(text + i + length - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst),
+                      _mm_cmpeq_epi8(last, blockLast))));
+
+      while (mask != 0) {
+        size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+        if (std::memcmp(text + candidate + 1, needle + 1, length - 2) == 0) {
+          return candidate;
+        }
+        mask &= mask - 1;
+      }
+    }
+
+    return findScalar(text, size, needle, length, i);
+  }
+
+  static size_t rfindSse2(const char* text, size_t size, const char* needle,
+                          size_t length) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[length - 1]);
+    size_t end = size - length + 1;
+
+    for (; end >= 16; end -= 16) {
+      size_t i = end - 16;
+      const __m128i blockFirst =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+      const __m128i blockLast = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(text + i + length - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst),
+                      _mm_cmpeq_epi8(last, blockLast))));
+
+      while (mask != 0) {
+        size_t candidate = i + 31 - static_cast<size_t>(__builtin_clz(mask));
+        if (std::memcmp(text + candidate + 1, needle + 1, length - 2) == 0) {
+          return candidate;
+        }
+        mask &= ~(1u << (31 - __builtin_clz(mask)));
+      }
+    }
+
+    return rfindScalar(text, needle, length, end);
+  }
+#endif
+
+  // tail of the forward search, candidates start in [from, size - length]
+  static size_t findScalar(const char* text, size_t size, const char* needle,
+                           size_t length, size_t from) {
+    for (size_t i = from; i + length <= size; ++i) {
+      if (text[i] == needle[0] && text[i + length - 1] == needle[length - 1] &&
+          std::memcmp(text + i + 1, needle + 1, length - 2) == 0) {
+        return i;
+      }
+    }
+    return NPOS;
+  }
+
+  // tail of the backward search, candidates start in [0, end)
+  static size_t rfindScalar(const char* text, const char* needle,
+                            size_t length, size_t end) {
+    for (size_t i = end; i-- > 0;) {
+      if (text[i] == needle[0] && text[i + length - 1] == needle[length - 1] &&
+          std::memcmp(text + i + 1, needle + 1, length - 2) == 0) {
+        return i;
+      }
+    }
+    return NPOS;
+  }
+
+  // search in text[0, size) assuming 2 <= length <= size
+  static size_t findBlock(const char* text, size_t size, const char* needle,
+                          size_t length) {
+    if (length >= TWO_WAY_MIN_NEEDLE) {
+      const void* found = memmem(text, size, needle, length);
+      return found == nullptr ?
+        NPOS : static_cast<size_t>(static_cast<const char*>(found) - text);
+    }
+
+#ifdef FANGLESS_X86_SIMD
+    if (hasAvx2()) return findAvx2(text, size, needle, length);
+    return findSse2(text, size, needle, length);
+#else
+    return findScalar(text, size, needle, length, 0);
+#endif
+  }
+
+  static size_t rfindBlock(const char* text, size_t size, const char* needle,
+                           size_t length) {
+#ifdef FANGLESS_X86_SIMD
+    if (hasAvx2()) return rfindAvx2(text, size, needle, length);
+    return rfindSse2(text, size, needle, length);
+#else
+    return rfindScalar(text, needle, length, size - length + 1);
+#endif
+  }
+
+ public:
+  // First position >= from where needle starts, npos if there is none.
+  // Same contract as std::string::find
+  static size_t find(std::string_view text, std::string_view needle,
+                     size_t from = 0) {
+    if (from > text.size() || needle.size() > text.size() - from) return NPOS;
+    if (needle.empty()) return from;
+
+    const char* start = text.data() + from;
+    size_t size = text.size() - from;
+
+    if (needle.size() == 1) {
+      const void* found = std::memchr(start, needle[0], size);
+      return found == nullptr ?
+        NPOS : static_cast<size_t>(static_cast<const char*>(found) - text.data());
+    }
+
+    size_t position = findBlock(start, size, needle.data(), needle.size());
+    return position == NPOS ? NPOS : position + from;
+  }
+
+  // Last position <= before where needle starts, npos if there is none.
+  // Same contract as std::string::rfind
+  static size_t rfind(std::string_view text, std::string_view needle,
+                      size_t before = NPOS) {
+    if (needle.size() > text.size()) return NPOS;
+
+    size_t lastStart = std::min(before, text.size() - needle.size());
+    if (needle.empty()) return lastStart;
+
+    // only text[0, lastStart + length) can hold a match
+    size_t size = lastStart + needle.size();
+    if (needle.size() == 1) {
+      const void* found = memrchr(text.data(), needle[0], size);
+      return found == nullptr ?
+        NPOS : static_cast<size_t>(static_cast<const char*>(found) - text.data());
+    }
+
+    return rfindBlock(text.data(), size, needle.data(), needle.size());
+  }
+
+  // Non overlapping occurrences of needle inside text[from, to)
+  static size_t count(std::string_view text, std::string_view needle,
+                      size_t from = 0, size_t to = NPOS) {
+    text = text.substr(0, std::min(to, text.size()));
+    if (from > text.size()) return 0;
+    // the empty needle matches before every code point and at the end
+    if (needle.empty()) return StringUtf8::count(text.substr(from)) + 1;
+
+    size_t occurrences = 0;
+    for (size_t position = find(text, needle, from); position != NPOS;
+         position = find(text, needle, position + needle.size())) {
+      ++occurrences;
+    }
+    return occurrences;
+  }
+};
+
+#endif  // STRING_SEARCH_HPP
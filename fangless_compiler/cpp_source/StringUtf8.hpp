@@ -0,0 +1,85 @@
+#ifndef STRING_UTF8_HPP
+#define STRING_UTF8_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// UTF-8 helpers for the String methods that work in code points. Malformed
+// input is never rejected: a code point is any byte that is not a
+// continuation byte together with the continuation bytes that follow it.
+class StringUtf8 {
+ public:
+  static constexpr uint32_t MAX_CODE_POINT = 0x10ffff;
+
+  static bool isContinuation(unsigned char c) { return (c & 0xc0) == 0x80; }
+
+  // Bytes taken by the code point starting with lead
+  static size_t sequenceLength(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead & 0xe0) == 0xc0) return 2;
+    if ((lead & 0xf0) == 0xe0) return 3;
+    if ((lead & 0xf8) == 0xf0) return 4;
+    return 1;
+  }
+
+  // Every byte that is not a continuation byte starts a code point
+  static size_t count(std::string_view text) {
+    size_t codePoints = 0;
+    for (char c : text) {
+      codePoints += !isContinuation(static_cast<unsigned char>(c));
+    }
+    return codePoints;
+  }
+
+  // Offset of the code point that follows the one starting at offset
+  static size_t next(std::string_view text, size_t offset) {
+    ++offset;
+    while (offset < text.size() &&
+           isContinuation(static_cast<unsigned char>(text[offset]))) {
+      ++offset;
+    }
+    return offset;
+  }
+
+  static uint32_t decode(std::string_view character) {
+    auto lead = static_cast<unsigned char>(character[0]);
+    size_t length = sequenceLength(lead);
+    if (length == 1 || length > character.size()) return lead;
+
+    uint32_t codePoint = lead & (0x7f >> length);
+    for (size_t i = 1; i < length; ++i) {
+      codePoint = (codePoint << 6) |
+        (static_cast<unsigned char>(character[i]) & 0x3f);
+    }
+    return codePoint;
+  }
+
+  static std::string encode(uint32_t codePoint) {
+    if (codePoint > MAX_CODE_POINT) {
+      throw std::out_of_range("chr() arg not in range(0x110000)");
+    }
+
+    std::string result;
+    if (codePoint < 0x80) {
+      result += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      result += static_cast<char>(0xc0 | (codePoint >> 6));
+      result += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+      result += static_cast<char>(0xe0 | (codePoint >> 12));
+      result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+      result += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else {
+      result += static_cast<char>(0xf0 | (codePoint >> 18));
+      result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+      result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+      result += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+    return result;
+  }
+};
+
+#endif  // STRING_UTF8_HPP
@@ -5,12 +5,14 @@
 #ifndef TUPLE_HPP
 #define TUPLE_HPP
 
+#include <algorithm>
 #include <vector>
 #include <concepts>
 #include <ranges>
 
 using std::views::iota;
 
+#include "Hash.hpp"
 #include "Number.hpp"
 #include "Object.hpp"
 
@@ -20,6 +22,24 @@ concept SharedObject = std::is_convertible<T, std::shared_ptr<Object>>::value;
 class Tuple : public Object {
   const std::vector<std::shared_ptr<Object>> elements_;
 
+  // Computed on first use. The elements never change and the numbers and
+  // strings among them are not changed in place while a tuple holds them,
+  // so the hash stays valid.
+  mutable size_t hash_ = Hash::UNSET;
+  // Different hashes only rule out equality when every element compares
+  // exactly. Floats compare with a tolerance (see Number::equals), so two
+  // equal tuples holding them can hash differently.
+  mutable bool exactHash_ = false;
+
+  static bool comparesExactly(const Object& element) {
+    if (auto* tuple = dynamic_cast<const Tuple*>(&element)) {
+      return tuple->exactHash_;
+    }
+    const std::string elementType = element.type();
+    return elementType == "str" || elementType == "int" ||
+           elementType == "Bool" || elementType == "NoneType";
+  }
+
  public:
   template <typename... Args>
       requires(SharedObject<Args> && ...)
@@ -65,6 +85,9 @@ class Tuple : public Object {
   bool equals(const Object& other) const override {
     if (auto* ptr = dynamic_cast<const Tuple*>(&other)) {
       if (ptr->elements_.size() != elements_.size()) return false;
+      if (exactHash_ && ptr->exactHash_ && hash_ != ptr->hash_) {
+        return false;
+      }
 
       for (auto index : iota(0, static_cast<int32_t>(elements_.size()))) {
         if (*ptr->elements_[index] != *elements_[index]) return false;
@@ -77,11 +100,15 @@ class Tuple : public Object {
   }
 
   size_t hash() const override {
-    std::size_t hash = 0;
+    if (hash_ != Hash::UNSET) return hash_;
+    Hash::Combiner hash;
+    bool exact = true;
 
     for (const auto& element : elements_) {
       try {
-        hash ^= element->hash();
+        // a nested tuple knows whether it compares exactly once hashed
+        hash.add(element->hash());
+        exact = exact && comparesExactly(*element);
       } catch (...) {
         throw std::runtime_error(
             "An object in the Tuple is not hashable. Tuple is therefore not "
@@ -89,7 +116,23 @@ class Tuple : public Object {
       }
     }
 
-    return hash;
+    hash_ = hash.finish(elements_.size());
+    exactHash_ = exact;
+    return hash_;
+  }
+
+  // Tuples order element by element, so dict and set keys that are tuples
+  // compare without formatting them to strings first
+  std::strong_ordering compare(const Object& other) const override {
+    const auto* tuple = dynamic_cast<const Tuple*>(&other);
+    if (!tuple) return Object::compare(other);
+
+    const size_t shared = std::min(elements_.size(), tuple->elements_.size());
+    for (size_t i = 0; i < shared; ++i) {
+      const auto order = elements_[i]->compare(*tuple->elements_[i]);
+      if (order != std::strong_ordering::equal) return order;
+    }
+    return elements_.size() <=> tuple->elements_.size();
   }
 
   bool toBool() const override { return !elements_.empty(); }
@@ -159,6 +202,12 @@ class Tuple : public Object {
     return elements_[normalizeIndex(index.getInt())];
   }
 
+  std::shared_ptr<Object> getItem(
+      const std::shared_ptr<Object>& index) const override {
+    return elements_[normalizeIndex(Number::indexOf(
+      *index, "tuple indices must be integers or slices, not "))];
+  }
+
   std::shared_ptr<Number> index(const std::shared_ptr<Object>& object,
     const std::shared_ptr<Number>& start = Number::spawn(0),
     const std::shared_ptr<Number> end = Number::spawn(-1)) const {
@@ -191,6 +240,10 @@ class Tuple : public Object {
     return Number::spawn(static_cast<int>(elements_.size()));
   }
 
+  inline const std::vector<std::shared_ptr<Object>>& getElements() const {
+    return elements_;
+  }
+
   // at() methods - same behavior as operator[] but clearer intent
   std::shared_ptr<Object> at(const Number& index) const {
     return operator[](index);
@@ -11,3 +11,8 @@ class IndentationMismatchError(Exception):
 class ParserError(Exception):
     def __init__(self, message: str) -> None:
         super().__init__(message)
+
+
+class GeneratorError(Exception):
+    def __init__(self, message: str) -> None:
+        super().__init__(message)
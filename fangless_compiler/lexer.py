@@ -5,9 +5,10 @@ import colors
 from indentation_manager import FanglessIndentationManager
 from collections.abc import Iterable
 from ply import lex
-from common import new_token, TOKENS, RESERVED_WORDS
+from common import new_token, MODULE_FUNCTIONS, TOKENS, RESERVED_WORDS
 from compiler_settings import VERBOSE_LEXER
 from exceptions import LexerError
+from string_formatting import FormatError, split_f_string
 
 
 class FanglessLexer:
@@ -91,6 +92,9 @@ class FanglessLexer:
         )
 
         lex_tokens = self.remove_redundant_newlines(lex_tokens)
+        lex_tokens = self.expand_format_strings(lex_tokens)
+        lex_tokens = self.reorder_comprehensions(lex_tokens)
+        lex_tokens = self.resolve_modules(lex_tokens)
 
         line_number = 1
         if len(lex_tokens) != 0:
@@ -115,6 +119,150 @@ class FanglessLexer:
             new_full_quality_tokens.append(token)
         return new_full_quality_tokens
 
+    def expand_format_strings(self, tokens: list) -> list:
+        """Rewrites every f-string into a call to str.format on the literal
+        template, f"{a} and {b:>5}" becomes "{0} and {1:>5}".format(a, b)
+        """
+        expanded = []
+        for token in tokens:
+            if token.type != "FORMAT_STRING":
+                expanded.append(token)
+                continue
+
+            try:
+                template, expressions = split_f_string(token.value)
+            except FormatError as e:
+                error = f"{e}, at line number {token.lineno}"
+                raise LexerError(error) from e
+
+            line_number = token.lineno
+            template_token = new_token("STRING", line_number, token.lexpos)
+            template_token.value = template
+            method_token = new_token("NAME", line_number, token.lexpos)
+            method_token.value = "format"
+            expanded += [
+                template_token,
+                new_token("DOT", line_number, token.lexpos),
+                method_token,
+                new_token("L_PARENTHESIS", line_number, token.lexpos),
+            ]
+
+            for index, expression in enumerate(expressions):
+                if index > 0:
+                    expanded.append(
+                        new_token("COMMA", line_number, token.lexpos),
+                    )
+                expanded += self.expand_format_strings(
+                    self.lex_expression(expression, line_number),
+                )
+
+            expanded.append(
+                new_token("R_PARENTHESIS", line_number, token.lexpos),
+            )
+
+        return expanded
+
+    def reorder_comprehensions(self, tokens: list) -> list:
+        """Moves the element of every list comprehension behind its for
+        clause, [int(x) for x in row] becomes [for x in row : int(x)], so
+        the parser declares the loop names before it reads the element
+        """
+        reordered = []
+        position = 0
+        while position < len(tokens):
+            token = tokens[position]
+            end = None
+            if token.type == "L_BRACKET":
+                end = self.closing_bracket(tokens, position)
+            if end is None:
+                reordered.append(token)
+                position += 1
+                continue
+
+            inner = self.reorder_comprehensions(tokens[position + 1:end])
+            clause = self.top_level_for(inner)
+            if clause is not None and clause > 0:
+                colon = new_token("COLON", token.lineno, token.lexpos)
+                inner = inner[clause:] + [colon] + inner[:clause]
+
+            reordered += [token, *inner, tokens[end]]
+            position = end + 1
+
+        return reordered
+
+    def resolve_modules(self, tokens: list) -> list:
+        """Drops every import of a known module and joins the functions
+        used from it into a single name, import math and math.gcd(a, b)
+        become gcd(a, b) on the builtin named math.gcd
+        """
+        imported = set()
+        resolved = []
+        position = 0
+        while position < len(tokens):
+            window = tokens[position:position + 3]
+            if (
+                len(window) == 3
+                and [token.type for token in window] == [
+                    "NAME", "NAME", "NEWLINE"
+                ]
+                and window[0].value == "import"
+                and window[1].value in MODULE_FUNCTIONS
+            ):
+                imported.add(window[1].value)
+                position += 3
+                continue
+
+            if (
+                len(window) == 3
+                and [token.type for token in window] == ["NAME", "DOT", "NAME"]
+                and window[0].value in imported
+                and window[2].value in MODULE_FUNCTIONS[window[0].value]
+                and (position == 0 or tokens[position - 1].type != "DOT")
+            ):
+                window[0].value += f".{window[2].value}"
+                resolved.append(window[0])
+                position += 3
+                continue
+
+            resolved.append(tokens[position])
+            position += 1
+
+        return resolved
+
+    def closing_bracket(self, tokens: list, start: int) -> int | None:
+        depth = 0
+        for position in range(start, len(tokens)):
+            if tokens[position].type == "L_BRACKET":
+                depth += 1
+            elif tokens[position].type == "R_BRACKET":
+                depth -= 1
+                if depth == 0:
+                    return position
+        return None
+
+    def top_level_for(self, tokens: list) -> int | None:
+        depth = 0
+        for position, token in enumerate(tokens):
+            if token.type in {"L_PARENTHESIS", "L_BRACKET", "L_CURLY_BRACE"}:
+                depth += 1
+            elif token.type in {"R_PARENTHESIS", "R_BRACKET", "R_CURLY_BRACE"}:
+                depth -= 1
+            elif token.type == "FOR" and depth == 0:
+                return position
+        return None
+
+    def lex_expression(self, expression: str, line_number: int) -> list:
+        expression_lexer = self.lexer.clone()
+        expression_lexer.input(expression)
+
+        tokens = []
+        for token in iter(expression_lexer.token, None):
+            if token.type in {"WHITESPACE", "NEWLINE"}:
+                continue
+            token.lineno = line_number
+            tokens.append(token)
+        return tokens
+
     def token(self) -> lex.LexToken | None:
         if self.token_stream and len(self.token_stream) > 0:
             return self.token_stream.pop(0)
@@ -167,6 +315,12 @@ class FanglessLexer:
         r"[uU](\"(\\.|[^\"\n]|(\\\n))*\") | [uU](\'(\\.|[^\'\n]|(\\\n))*\')"
         return token
 
+    def t_FORMAT_STRING(self, token: lex.LexToken) -> lex.LexToken:
+        r"[fF](\"(\\.|[^\"\n]|(\\\n))*\") | [fF](\'(\\.|[^\'\n]|(\\\n))*\')"
+        token.value = str(token.value[2:-1])
+
+        return token
+
     def t_STRING(self, token: lex.LexToken) -> lex.LexToken:
         r"""((\").*?(\"))|((\').*?(\'))"""
         token.value = str(token.value[1:-1])
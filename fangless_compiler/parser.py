@@ -71,9 +71,26 @@ REVERSED_CPP_WORD_POSTFIX = f"This_Was_Reserved_{add_name()}"
 
 
 # =============================ERROR CHECKING==================================
+def is_key_argument(token_list: yacc.YaccProduction) -> bool:
+    """check the symbols before the name are the start of a 'key='
+    argument, e.g. sorted(words, key=len)
+    """
+    stack = token_list.stack
+    return (
+        len(stack) >= 3
+        and stack[-1].type == "EQUAL"
+        and stack[-2].type == "NAME"
+        and stack[-2].value == "key"
+        and stack[-3].type in {"L_PARENTHESIS", "COMMA"}
+    )
+
+
 def does_name_exist(token_list: yacc.YaccProduction) -> None:
+    # builtin functions can only be passed by name as a key function
     if (token_list.slice[1].type == "NAME"
-        and symbol_table[token_list[1]] is None):
+        and symbol_table[token_list[1]] is None
+        and not (token_list[1] in BUILTIN_FUNCTIONS
+                 and is_key_argument(token_list))):
         error = (
                f"--Name: '{token_list[1]}' is not defined "
                f"at {token_list.lineno(1)}--{add_remark()}"
@@ -199,7 +216,8 @@ def p_literal(token_list: yacc.YaccProduction) -> None:
     match token_list.slice[1].type:
         case "NAME":
             name = token_list[1]
-            if name in CPP_RESERVED_W:
+            # a builtin key function keeps its name, e.g. key=int
+            if name in CPP_RESERVED_W and symbol_table[name] is not None:
                 name = f"{name}_{REVERSED_CPP_WORD_POSTFIX}"
 
             token_list[0] = NameNode(name)
@@ -327,17 +345,39 @@ def p_non_mutable_literal(token_list: yacc.YaccProduction) -> None:
 # series of literals (general series) or empty
 def p_list(token_list: yacc.YaccProduction) -> None:
     """list :   L_BRACKET completed_general_series R_BRACKET
+            |   L_BRACKET comprehension_open for_symbols IN for_literal COLON scalar_statement R_BRACKET
             |   L_BRACKET R_BRACKET
     """
     # if we do not have elements inside the list
     if len(token_list) == 3:
         token_list[0] = []
         return
+    # the lexer moved the element of a comprehension behind its for clause
+    if len(token_list) == 9:
+        local_var = stack.pop()
+        while local_var != SCOPE_OPENED:
+            symbol_table[local_var] = None
+            local_var = stack.pop()
+
+        comprehension = OperatorNode(
+            OperatorType.LIST_COMPREHENSION, max_adjacents=3,
+        )
+        comprehension.add_named_adjacent(Operand.SYMBOLS, token_list[3])
+        comprehension.add_named_adjacent(Operand.FOR_LITERAL, token_list[5])
+        comprehension.add_named_adjacent(Operand.ELEMENT, token_list[7])
+        token_list[0] = comprehension
+        return
     # if we have elements inside
     series = token_list[2]
     token_list[0] = series
 
 
+def p_comprehension_open(token_list: yacc.YaccProduction) -> None:
+    """comprehension_open   :   FOR"""
+    stack.append(SCOPE_OPENED)
+    _ = token_list
+
+
 # sets can not be declared empty 
 def p_set(token_list: yacc.YaccProduction) -> None:
     """set  :   L_CURLY_BRACE completed_general_series R_CURLY_BRACE"""
@@ -1391,10 +1431,19 @@ def p_parameter(token_list: yacc.YaccProduction) -> None:
     """parameter    :   scalar_statement
                     |   binary_operand
                     |   unary_operation
+                    |   keyword_parameter
     """
     token_list[0] = token_list[1]
 
 
+def p_keyword_parameter(token_list: yacc.YaccProduction) -> None:
+    """keyword_parameter    :   NAME EQUAL scalar_statement"""
+    keyword_node = OperatorNode(OperatorType.KEYWORD_ARGUMENT)
+    keyword_node.add_named_adjacent(Operand.KEYWORD, token_list[1])
+    keyword_node.add_named_adjacent(Operand.VALUE, token_list[3])
+    token_list[0] = keyword_node
+
+
 def p_callable(token_list: yacc.YaccProduction) -> None:
     """callable   :   L_PARENTHESIS callable R_PARENTHESIS
                   |   scalar_statement
@@ -0,0 +1,289 @@
+"""Compile time parsing of formatted strings.
+
+f-strings are rewritten into str.format calls by the lexer. str.format
+templates, format specs and printf style templates for the % operator are
+split here into literal text and fields, so the code generator only emits
+the already parsed pieces.
+"""
+
+FORMAT_SPEC_TYPES = set("bcdeEfFgGnosxX%")
+PERCENT_TYPES = set("diouxXeEfFgGcrsa")
+ALIGNMENTS = set("<>=^")
+
+
+class FormatError(Exception):
+    def __init__(self, message: str) -> None:
+        super().__init__(message)
+
+
+def parse_format_spec(spec: str) -> dict:
+    """Splits [[fill]align][sign][z][#][0][width][grouping][.precision][type]
+    into the fields it sets, the ones it does not set are left out
+    """
+    fields = {}
+    position = 0
+
+    if len(spec) >= 2 and spec[1] in ALIGNMENTS:
+        fields["fill"] = spec[0]
+        fields["align"] = spec[1]
+        position = 2
+    elif len(spec) >= 1 and spec[0] in ALIGNMENTS:
+        fields["align"] = spec[0]
+        position = 1
+
+    if position < len(spec) and spec[position] in "+- ":
+        fields["sign"] = spec[position]
+        position += 1
+    if position < len(spec) and spec[position] == "z":
+        fields["noNegativeZero"] = True
+        position += 1
+    if position < len(spec) and spec[position] == "#":
+        fields["alternate"] = True
+        position += 1
+    if position < len(spec) and spec[position] == "0":
+        fields["zero"] = True
+        position += 1
+
+    start = position
+    while position < len(spec) and spec[position].isdigit():
+        position += 1
+    if position > start:
+        fields["width"] = int(spec[start:position])
+
+    if position < len(spec) and spec[position] in ",_":
+        fields["grouping"] = spec[position]
+        position += 1
+
+    if position < len(spec) and spec[position] == ".":
+        position += 1
+        start = position
+        while position < len(spec) and spec[position].isdigit():
+            position += 1
+        if position == start:
+            raise FormatError("Format specifier missing precision")
+        fields["precision"] = int(spec[start:position])
+
+    if position < len(spec) and spec[position] in FORMAT_SPEC_TYPES:
+        fields["type"] = spec[position]
+        position += 1
+
+    if position != len(spec):
+        raise FormatError(f"Invalid format specifier '{spec}'")
+
+    return fields
+
+
+def split_format_string(template: str) -> list:
+    """Splits a str.format template into literal text and fields, a field
+    is a (name, conversion, spec) tuple
+    """
+    pieces = []
+    text = ""
+    position = 0
+
+    while position < len(template):
+        char = template[position]
+
+        if char in "{}" and template[position + 1:position + 2] == char:
+            text += char
+            position += 2
+            continue
+
+        if char == "}":
+            raise FormatError("Single '}' encountered in format string")
+
+        if char != "{":
+            text += char
+            position += 1
+            continue
+
+        end = template.find("}", position)
+        if end == -1:
+            raise FormatError("Single '{' encountered in format string")
+
+        field = template[position + 1:end]
+        if "{" in field:
+            raise FormatError(
+                "Nested replacement fields are not supported in format specs"
+            )
+
+        name, _, spec = field.partition(":")
+        name, _, conversion = name.partition("!")
+        if conversion not in {"", "s", "r", "a"}:
+            raise FormatError(
+                f"Unknown conversion specifier {conversion}"
+            )
+
+        if text:
+            pieces.append(text)
+            text = ""
+        pieces.append((name, conversion, spec))
+        position = end + 1
+
+    if text:
+        pieces.append(text)
+
+    return pieces
+
+
+def split_f_string(source: str) -> tuple[str, list[str]]:
+    """Rewrites the body of an f-string into a str.format template with
+    numbered fields and the source of the expressions they take
+    """
+    template = ""
+    expressions = []
+    position = 0
+
+    while position < len(source):
+        char = source[position]
+
+        if char in "{}" and source[position + 1:position + 2] == char:
+            template += char * 2
+            position += 2
+            continue
+
+        if char == "}":
+            raise FormatError("f-string: single '}' is not allowed")
+
+        if char != "{":
+            template += char
+            position += 1
+            continue
+
+        expression, position = read_f_string_expression(source, position + 1)
+        suffix = ""
+        if position < len(source) and source[position] in "!:":
+            end = source.find("}", position)
+            if end == -1:
+                raise FormatError("f-string: expecting '}'")
+            suffix = source[position:end]
+            position = end
+        position += 1
+
+        # f"{value=}" shows the expression before its repr
+        if expression.rstrip().endswith("="):
+            template += expression.replace("{", "{{").replace("}", "}}")
+            expression = expression.rstrip()[:-1]
+            if not suffix:
+                suffix = "!r"
+
+        if not expression.strip():
+            raise FormatError("f-string: empty expression not allowed")
+
+        template += f"{{{len(expressions)}{suffix}}}"
+        expressions.append(expression.strip())
+
+    return template, expressions
+
+
+def read_f_string_expression(source: str, position: int) -> tuple[str, int]:
+    """Reads the expression of a replacement field up to its conversion,
+    format spec or closing brace, skipping over nested brackets and strings
+    """
+    start = position
+    depth = 0
+    quote = None
+
+    while position < len(source):
+        char = source[position]
+
+        if quote is not None:
+            if char == quote:
+                quote = None
+        elif char in "'\"":
+            quote = char
+        elif char in "([{":
+            depth += 1
+        elif char in ")]}" and depth > 0:
+            depth -= 1
+        elif depth == 0 and (
+            char in ":}"
+            or (char == "!" and source[position + 1:position + 2] != "=")
+        ):
+            return source[start:position], position
+
+        position += 1
+
+    raise FormatError("f-string: expecting '}'")
+
+
+def split_percent_string(template: str) -> list:
+    """Splits a printf style template into literal text and fields, a field
+    is the dict of format spec fields it sets
+    """
+    pieces = []
+    text = ""
+    position = 0
+
+    while position < len(template):
+        char = template[position]
+        position += 1
+
+        if char != "%":
+            text += char
+            continue
+
+        if template[position:position + 1] == "%":
+            text += "%"
+            position += 1
+            continue
+
+        if template[position:position + 1] == "(":
+            raise FormatError("Mapping keys are not supported in % formatting")
+
+        fields = {"percent": True}
+        while position < len(template) and template[position] in "-+ #0":
+            flag = template[position]
+            if flag == "-":
+                fields["align"] = "<"
+            elif flag in "+ ":
+                if fields.get("sign") != "+":
+                    fields["sign"] = flag
+            elif flag == "#":
+                fields["alternate"] = True
+            else:
+                fields["zero"] = True
+            position += 1
+
+        start = position
+        while position < len(template) and template[position].isdigit():
+            position += 1
+        if position > start:
+            fields["width"] = int(template[start:position])
+
+        if template[position:position + 1] == ".":
+            position += 1
+            start = position
+            while position < len(template) and template[position].isdigit():
+                position += 1
+            fields["precision"] = int(template[start:position] or "0")
+
+        if template[position:position + 1] == "*":
+            raise FormatError("'*' widths are not supported in % formatting")
+
+        if position >= len(template):
+            raise FormatError("incomplete format")
+        conversion = template[position]
+        position += 1
+        if conversion not in PERCENT_TYPES:
+            raise FormatError(
+                f"unsupported format character '{conversion}'"
+            )
+
+        if fields.get("align") == "<":
+            fields.pop("zero", None)
+
+        if conversion in "rsa":
+            fields["conversion"] = "s" if conversion == "s" else "r"
+        else:
+            fields["type"] = "d" if conversion in "iu" else conversion
+
+        if text:
+            pieces.append(text)
+            text = ""
+        pieces.append(fields)
+
+    if text:
+        pieces.append(text)
+
+    return pieces
@@ -0,0 +1,35 @@
+//Copyright 2024, code automatically generated by: A. Badilla, Joseph Valverde & Kenneth Villalobos
+
+ #include "../fangless_compiler/cpp_source/Headers.hpp"
+
+ namespace GF {
+
+};
+
+ int main() {
+ BF::print(String::spawn("Testing enumerate with a list"));
+BF::print(BF::enumerate(List::spawn({String::spawn("a"), String::spawn("b"), String::spawn("c")})));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with a tuple"));
+BF::print(BF::enumerate(Tuple::spawn({Number::spawn(10), Number::spawn(20), Number::spawn(30)})));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with a string"));
+BF::print(BF::enumerate(String::spawn("hello")));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with a set"));
+BF::print(BF::enumerate(Set::spawn({String::spawn("a"), String::spawn("c"), String::spawn("b")})));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with dictionaries"));
+BF::print(BF::enumerate(Dictionary::spawn({{ String::spawn("key1"), Number::spawn(100) }, { String::spawn("key2"), Number::spawn(200) }})));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with custom starting index"));
+BF::print(BF::enumerate(List::spawn({String::spawn("x"), String::spawn("y"), String::spawn("z")}), Number::spawn(5)));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with range"));
+BF::print(BF::enumerate(BF::range(Number::spawn(1), Number::spawn(4))));
+BF::print(String::spawn(""));
+BF::print(String::spawn("Testing enumerate with an empty iterable"));
+BF::print(BF::enumerate(List::spawn()));
+BF::print(String::spawn(""));
+return 0;
+ }
\ No newline at end of file
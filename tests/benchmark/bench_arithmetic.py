@@ -0,0 +1,34 @@
+# Tight arithmetic loops: int sums and products with + - * // % and **,
+# a float accumulation and a loop mixing bools into int arithmetic.
+print("int")
+total = 0
+i = 0
+while i < 5000000:
+    total = total + i * 3 - (i // 7) + (i % 11)
+    i = i + 1
+print(total)
+
+print("power")
+total = 0
+i = 0
+while i < 2000000:
+    total = (total + i ** 2) % 1000000007
+    i = i + 1
+print(total)
+
+print("float")
+x = 0.0
+i = 0
+while i < 3000000:
+    x = x + i * 0.5 - x / 3
+    i = i + 1
+print(x)
+
+print("bool")
+count = 0
+i = 0
+while i < 3000000:
+    even = i % 2 == 0
+    count = count + even * 2 - ((i % 3) == 0)
+    i = i + 1
+print(count)
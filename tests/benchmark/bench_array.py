@@ -0,0 +1,52 @@
+# Reductions and searches over typed arrays. The elements are stored as
+# unboxed C values, so sum, min, max, count and membership scan contiguous
+# memory, and the slices taken every round are views, not copies.
+import array
+
+print("building")
+values = array.array("q")
+samples = array.array("d")
+i = 0
+while i < 1000000:
+    values.append((i * 7919) % 1000003)
+    samples.append(((i * 31) % 1000) / 8)
+    i += 1
+print(len(values))
+print(len(samples))
+
+print("reductions")
+total = 0
+smallest = 0
+largest = 0
+hits = 0
+rounds = 0
+while rounds < 100:
+    total = total + sum(values)
+    smallest = smallest + min(values)
+    largest = largest + max(samples)
+    hits = hits + values.count(rounds)
+    rounds += 1
+print(total)
+print(smallest)
+print(largest)
+print(hits)
+
+print("float sums")
+float_total = 0.0
+rounds = 0
+while rounds < 100:
+    float_total = float_total + sum(samples)
+    rounds += 1
+print(float_total)
+
+print("windows")
+found = 0
+start = 0
+while start < 200:
+    window = values[start * 1000:start * 1000 + 500000]
+    probe = ((start * 1000 + 400000) * 7919) % 1000003
+    if probe in window:
+        found += 1
+    found = found + len(window) - 500000
+    start += 1
+print(found)
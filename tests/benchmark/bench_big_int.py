@@ -0,0 +1,42 @@
+# Big int workloads: a factorial and a Fibonacci number with tens of
+# thousands of digits converted to text, and an int64 loop that never
+# overflows to show the fast path is unchanged. CPython 3.11+ needs
+# -X int_max_str_digits=0 to convert them.
+print("Factorial")
+factorial = 1
+i = 1
+while i <= 20000:
+    factorial *= i
+    i += 1
+text = str(factorial)
+print(len(text))
+print(text[0:20])
+print("")
+
+print("Fibonacci")
+a = 0
+b = 1
+c = 0
+i = 0
+while i < 200000:
+    c = a + b
+    a = b
+    b = c
+    i += 1
+text = str(a)
+print(len(text))
+print(text[0:20])
+print("")
+
+print("Squares")
+square = factorial * factorial
+print(len(str(square)))
+print("")
+
+print("Int64 loop")
+total = 0
+i = 0
+while i < 20000000:
+    total += i * 7 % 1000
+    i += 1
+print(total)
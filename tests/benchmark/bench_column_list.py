@@ -0,0 +1,40 @@
+# Scans of single fields over 2M (id, group, price) records, kept as a
+# column_list and as a list of tuples. The column list sums the fields over
+# its stored columns, the list unpacks a tuple per record.
+records = []
+i = 0
+while i < 2000000:
+    group = i % 3
+    price = i * 0.25
+    records.append((i, group, price))
+    i += 1
+columns = column_list(records)
+print(len(columns))
+
+print("column list")
+ids = 0
+groups = 0
+prices = 0.0
+round_ = 0
+while round_ < 5:
+    ids += sum([r[0] for r in columns])
+    groups += sum([group for number, group, price in columns])
+    prices += sum([r[2] for r in columns])
+    round_ += 1
+print(ids)
+print(groups)
+print(prices)
+
+print("list of tuples")
+ids = 0
+groups = 0
+prices = 0.0
+round_ = 0
+while round_ < 5:
+    ids += sum([r[0] for r in records])
+    groups += sum([group for number, group, price in records])
+    prices += sum([r[2] for r in records])
+    round_ += 1
+print(ids)
+print(groups)
+print(prices)
@@ -0,0 +1,70 @@
+# Membership workload for every container kind, each section probes the
+# same keys so the timings can be compared side by side
+size = 2000
+probes = 20000
+
+print("Building containers")
+numbers = []
+unique = set()
+table = {}
+text = ""
+value = 0
+while value < size:
+    numbers.append(value * 3)
+    unique.add(value * 3)
+    table[value * 3] = value
+    text += "w" + str(value)
+    value += 1
+print(len(numbers))
+print("")
+
+print("Probing list")
+hits = 0
+value = 0
+while value < probes:
+    if value in numbers:
+        hits += 1
+    value += 1
+print(hits)
+print("")
+
+print("Probing set")
+hits = 0
+value = 0
+while value < probes:
+    if value in unique:
+        hits += 1
+    value += 1
+print(hits)
+print("")
+
+print("Probing dict")
+hits = 0
+value = 0
+while value < probes:
+    if value in table:
+        hits += 1
+    value += 1
+print(hits)
+print("")
+
+print("Probing string")
+hits = 0
+value = 0
+while value < probes:
+    key = "w" + str(value) + "w"
+    if key in text:
+        hits += 1
+    value += 1
+print(hits)
+print("")
+
+print("Probing range")
+hits = 0
+value = 0
+while value < probes:
+    if value in range(0, size * 3, 3):
+        hits += 1
+    value += 1
+print(hits)
+print("")
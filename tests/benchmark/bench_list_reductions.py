@@ -0,0 +1,43 @@
+# Reductions and searches over lists of a million plain ints and a million
+# plain floats: sum, min, max, count, index and membership tests.
+print("ints")
+ints = []
+i = 0
+while i < 1000000:
+    ints.append((i * 7919) % 1000003 - 500000)
+    i += 1
+total = 0
+round_ = 0
+while round_ < 20:
+    total = total + sum(ints)
+    if max(ints) > min(ints):
+        total += 1
+    total = total + ints.count(round_) + ints.index(round_ - 250000)
+    if -round_ in ints:
+        total += 1
+    round_ += 1
+print(total)
+print(max(ints))
+print(min(ints))
+
+print("floats")
+floats = []
+i = 0
+while i < 1000000:
+    floats.append(((i * 31) % 1009) / 4)
+    i += 1
+best = 0.0
+found = 0
+round_ = 0
+while round_ < 20:
+    best = best + sum(floats)
+    if max(floats) > min(floats):
+        found += 1
+    found = found + floats.count(round_ / 4) + floats.index(251.5)
+    if 300.25 in floats:
+        found += 1
+    round_ += 1
+print(best)
+print(found)
+print(max(floats))
+print(min(floats))
@@ -0,0 +1,66 @@
+# Number theory loops: Miller-Rabin on 64 bit odd numbers with pow(b, e, m),
+# modular powers with a 127 bit modulus, gcd over consecutive pairs and a
+# perfect square count with isqrt.
+import math
+
+print("Miller-Rabin")
+primes = 0
+n = 1000000000000000001
+last = n + 400000
+while n < last:
+    d = n - 1
+    s = 0
+    while d % 2 == 0:
+        d //= 2
+        s += 1
+    composite = False
+    base = 2
+    while base < 14 and not composite:
+        x = pow(base, d, n)
+        if x != 1 and x != n - 1:
+            round_ = 1
+            witness = True
+            while round_ < s and witness:
+                x = x * x % n
+                if x == n - 1:
+                    witness = False
+                round_ += 1
+            if witness:
+                composite = True
+        base += 1
+    if not composite:
+        primes += 1
+    n += 2
+print(primes)
+print("")
+
+print("Mersenne modulus")
+p127 = 2 ** 127
+m127 = p127 - 1
+total = 0
+i = 1
+while i <= 20000:
+    total = (total + pow(i, m127 - 2, m127)) % m127
+    i += 1
+print(total)
+print("")
+
+print("Gcd")
+total = 0
+a = 1
+while a <= 3000000:
+    total += math.gcd(a * 7919, a * a + 1234567)
+    a += 1
+print(total)
+print("")
+
+print("Isqrt")
+squares = 0
+n = 1000000000000
+last = n + 3000000
+while n < last:
+    r = math.isqrt(n)
+    if r * r == n:
+        squares += 1
+    n += 1
+print(squares)
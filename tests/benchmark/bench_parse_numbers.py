@@ -0,0 +1,36 @@
+# Parses 10M ints and 2M floats out of whitespace separated lines, the
+# [int(x) for x in line.split()] pattern reads the fields in place
+row = "12 -345 6789 0 42 100000 -7 31415 27182 99"
+line = " ".join([row] * 100000)
+print(len(line))
+print("")
+
+print("Parsing ints")
+total = 0
+numbers = []
+i = 0
+while i < 10:
+    numbers = [int(x) for x in line.split()]
+    total += sum(numbers)
+    i += 1
+print(len(numbers))
+print(total)
+print("")
+
+print("Parsing floats")
+samples = " ".join(["3.25 -0.5 1e3 2_000.125 0.1"] * 100000)
+total = 0.0
+values = []
+i = 0
+while i < 4:
+    values = [float(x) for x in samples.split()]
+    total += sum(values)
+    i += 1
+print(len(values))
+print(total)
+print("")
+
+print("Converting split strings one by one")
+words = line.split()
+numbers = [int(w) for w in words]
+print(sum(numbers))
@@ -0,0 +1,18 @@
+# Prints 1M ints and 1M floats, every line is formatted straight into a
+# small buffer instead of going through a temporary string
+count = 1000000
+
+i = 0
+while i < count:
+    print(i * 7919 - 3000000)
+    i += 1
+
+i = 0
+value = 0.1
+while i < count:
+    print(value)
+    value = value * 1.0001 + 0.37
+    i += 1
+
+print(i / 3)
+print(2.0 ** 1000)
@@ -0,0 +1,40 @@
+# Sorting a million plain ints, a million plain floats and 200000 strings,
+# through sorted() and list.sort().
+print("ints")
+ints = []
+i = 0
+while i < 1000000:
+    ints.append((i * 7919) % 1000003 - 500000)
+    i += 1
+ordered = sorted(ints)
+print(ordered[0])
+print(ordered[500000])
+print(ordered[999999])
+ints.sort()
+print(ints[1])
+
+print("floats")
+floats = []
+i = 0
+while i < 1000000:
+    floats.append(((i * 7919) % 1000003) / 16 - 30000)
+    i += 1
+ordered = sorted(floats)
+print(ordered[0])
+print(ordered[500000])
+print(ordered[999999])
+floats.sort()
+print(floats[1])
+
+print("strings")
+words = []
+i = 0
+while i < 200000:
+    words.append("item" + str((i * 7919) % 200003))
+    i += 1
+ordered = sorted(words)
+print(ordered[0])
+print(ordered[100000])
+print(ordered[199999])
+words.sort()
+print(words[1])
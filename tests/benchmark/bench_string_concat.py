@@ -0,0 +1,29 @@
+# Accumulates long strings piece by piece, every section is linear when
+# the accumulated string is appended to in place
+pieces = 200000
+
+print("Concatenating with +")
+text = ""
+value = 0
+while value < pieces:
+    text = text + str(value % 10)
+    value += 1
+print(len(text))
+print("")
+
+print("Concatenating with +=")
+text = ""
+value = 0
+while value < pieces:
+    text += "ab"
+    value += 1
+print(len(text))
+print("")
+
+print("Chained concatenation")
+text = ""
+value = 0
+while value < pieces:
+    text = text + "<" + str(value % 7) + ">"
+    value += 1
+print(len(text))
@@ -0,0 +1,23 @@
+# Joins 10M short strings, the result is sized in one pass over the
+# elements and filled with a single allocation
+parts = ["alpha", "be", "c", "delta", "", "epsilon", "zeta", "et"] * 1250000
+print(len(parts))
+print("")
+
+print("Joining with a separator")
+text = ", ".join(parts)
+print(len(text))
+print(text[0:20])
+print("")
+
+print("Joining without a separator")
+text = "".join(parts)
+print(len(text))
+print(text[0:20])
+print("")
+
+print("Joining a tuple")
+words = tuple(parts)
+text = "-".join(words)
+print(len(text))
+print(text.count("--"))
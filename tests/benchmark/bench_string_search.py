@@ -0,0 +1,84 @@
+# Substring searches over a multi megabyte log, the needles are rare so
+# most of the time is spent scanning the text
+lines = 1000
+copies = 100
+
+print("Building log")
+block = ""
+value = 0
+while value < lines:
+    level = "INFO"
+    if value % 97 == 0:
+        level = "WARN"
+    if value % 313 == 0:
+        level = "ERROR"
+    block += "2024-05-17 12:00:" + str(value % 60) + " " + level
+    block += " worker-" + str(value % 16) + " request served in "
+    block += str(value % 500) + "ms\n"
+    value += 1
+log = block * copies
+log += "2024-05-17 12:59:59 FATAL worker-0 shutting down after signal 15\n"
+print(len(log))
+print("")
+
+print("Counting")
+rounds = 0
+total = 0
+while rounds < 20:
+    total += log.count("ERROR")
+    total += log.count("WARN worker-3")
+    rounds += 1
+print(total)
+print("")
+
+print("Finding")
+rounds = 0
+total = 0
+while rounds < 50:
+    total += log.find("FATAL")
+    total += log.rfind("ERROR worker")
+    total += log.index("signal 15")
+    total += log.find("never logged")
+    rounds += 1
+print(total)
+print("")
+
+print("Finding long needles")
+needle = "FATAL worker-0 shutting down after signal 15, nothing else to do"
+rounds = 0
+total = 0
+while rounds < 50:
+    total += log.find(needle)
+    total += log.find("FATAL worker-0 shutting down after signal 15")
+    rounds += 1
+print(total)
+print("")
+
+print("Partitioning")
+rounds = 0
+total = 0
+while rounds < 50:
+    parts = log.partition("FATAL")
+    if parts[1] == "FATAL":
+        total += 1
+    parts = log.rpartition("WARN")
+    if parts[2] != "":
+        total += 1
+    rounds += 1
+print(total)
+print("")
+
+print("Replacing")
+replaced = log.replace("ERROR", "E")
+print(len(replaced))
+replaced = log.replace("request served", "ok")
+print(len(replaced))
+print("")
+
+print("Splitting")
+records = log.split("\n")
+print(len(records))
+records = log.split("ERROR")
+print(len(records))
+records = log.rsplit("WARN", 10)
+print(len(records))
@@ -0,0 +1,71 @@
+# Sorting data that arrives mostly in order, as in incremental pipelines:
+# batches appended to sorted lists of ints and of tuples are re-sorted,
+# then key functions and lists mixing ints and floats.
+print("appended batches")
+ints = []
+i = 0
+while i < 1000000:
+    ints.append(i * 3)
+    i += 1
+batch = 0
+while batch < 20:
+    j = 0
+    while j < 50:
+        ints.append((batch * 7919 + j * 104729) % 3000000)
+        j += 1
+    ints.sort()
+    batch += 1
+print(len(ints))
+print(ints[0])
+print(ints[500000])
+print(ints[1000999])
+
+print("tuples")
+records = []
+i = 0
+while i < 200000:
+    group = i // 4
+    name = "r" + str(i % 1000)
+    records.append((group, name))
+    i += 1
+batch = 0
+while batch < 10:
+    j = 0
+    while j < 20:
+        group = (batch * 7919 + j * 104729) % 50000
+        records.append((group, "late"))
+        j += 1
+    records.sort()
+    batch += 1
+print(records[0])
+print(records[100000])
+print(records[200199])
+
+print("keys")
+words = []
+i = 0
+while i < 200000:
+    words.append("w" * ((i * 7919) % 13) + str(i % 100))
+    i += 1
+by_length = sorted(words, key=len)
+print(by_length[0])
+print(by_length[199999])
+words.sort(key=len, reverse=True)
+print(words[0])
+print(words[100000])
+
+print("mixed numbers")
+mixed = []
+i = 0
+while i < 300000:
+    if i % 2 == 0:
+        mixed.append((i * 7919) % 300007)
+    else:
+        mixed.append(((i * 104729) % 300007) / 4)
+    i += 1
+ordered = sorted(mixed)
+print(ordered[0])
+print(ordered[150000])
+print(ordered[299999])
+mixed.sort(reverse=True)
+print(mixed[1])
@@ -0,0 +1,40 @@
+# Repeated lookups keyed by tuples: membership tests against a list of grid
+# coordinates, which is re-indexed after every replaced cell, and a memo
+# dict probed with the same coordinate tuples over and over.
+print("coordinates")
+cells = []
+y = 0
+while y < 100:
+    x = 0
+    while x < 100:
+        cells.append((x, y, "cell"))
+        x += 1
+    y += 1
+found = 0
+round_ = 0
+while round_ < 200:
+    cells[round_] = (round_, -1, "cell")
+    probe = 0
+    while probe < 50:
+        if cells[probe * 37] in cells:
+            found += 1
+        probe += 1
+    round_ += 1
+print(found)
+
+print("memo")
+memo = {}
+i = 0
+while i < 2000:
+    memo[cells[i]] = i
+    i += 1
+total = 0
+round_ = 0
+while round_ < 100:
+    i = 0
+    while i < 2000:
+        if memo[cells[i]] == i:
+            total += 1
+        i += 1
+    round_ += 1
+print(total)
@@ -0,0 +1,158 @@
+import array
+
+print("Testing construction and indexing")
+# Testing construction and indexing
+numbers = array.array("i", [3, 1, 4, 1, 5, 9, 2, 6])
+print(numbers)
+print(len(numbers))
+print(numbers[0])
+print(numbers[-1])
+# array('i', [3, 1, 4, 1, 5, 9, 2, 6])
+# 8
+# 3
+# 6
+numbers[1] = 10
+print(numbers)
+print(array.array("d"))
+print(array.array("f", [0.1, 0.5]))
+print("")
+# array('i', [3, 10, 4, 1, 5, 9, 2, 6])
+# array('d')
+# array('f', [0.10000000149011612, 0.5])
+#
+
+print("Testing slices")
+# Testing slices
+window = numbers[2:5]
+print(window)
+# array('i', [4, 1, 5])
+numbers[2] = 99
+print(window)
+print(numbers)
+# array('i', [4, 1, 5])
+# array('i', [3, 10, 99, 1, 5, 9, 2, 6])
+window.append(0)
+print(window)
+print(numbers)
+print("")
+# array('i', [4, 1, 5, 0])
+# array('i', [3, 10, 99, 1, 5, 9, 2, 6])
+#
+
+print("Testing list methods")
+# Testing list methods
+numbers.append(7)
+numbers.extend([8, 9])
+print(numbers)
+print(numbers.count(9))
+print(numbers.index(5))
+print(9 in numbers)
+print(100 in numbers)
+print(9.0 in numbers)
+print(9.5 in numbers)
+# array('i', [3, 10, 99, 1, 5, 9, 2, 6, 7, 8, 9])
+# 2
+# 4
+# True
+# False
+# True
+# False
+numbers.reverse()
+print(numbers)
+print(numbers.pop())
+print(numbers.pop(0))
+# array('i', [9, 8, 7, 6, 2, 9, 5, 1, 99, 10, 3])
+# 3
+# 9
+numbers.insert(0, 42)
+numbers.remove(99)
+print(numbers)
+print(numbers.tolist())
+print("")
+# array('i', [42, 8, 7, 6, 2, 9, 5, 1, 10])
+# [42, 8, 7, 6, 2, 9, 5, 1, 10]
+#
+
+print("Testing builtins")
+print(sum(numbers))
+print(min(numbers))
+print(max(numbers))
+print(list(array.array("q", [7, 8])))
+print(sorted(array.array("h", [3, 1, 2])))
+# Testing builtins
+# 90
+# 1
+# 42
+# [7, 8]
+# [1, 2, 3]
+floats = array.array("d", [1.5, 2.5, -0.0, 0.0])
+print(sum(floats))
+print(min(floats))
+print(max(floats))
+# 4.0
+# -0.0
+# 2.5
+largest = array.array("q", [9223372036854775807, 9223372036854775807])
+print(sum(largest))
+# 18446744073709551614
+for value in array.array("b", [5, 6]):
+    print(value)
+print("")
+# 5
+# 6
+#
+
+print("Testing operators")
+# Testing operators
+pair = array.array("b", [1, 2])
+times = 3
+print(pair + pair)
+print(pair * times)
+print(pair == array.array("d", [1.0, 2.0]))
+print(pair == array.array("b", [2, 1]))
+print("")
+# array('b', [1, 2, 1, 2])
+# array('b', [1, 2, 1, 2, 1, 2])
+# True
+# False
+#
+
+print("Testing files")
+# Testing files
+path = "/tmp/fangless_array_test.bin"
+out = open(path, "wb")
+floats.tofile(out)
+out.close()
+source = open(path, "rb")
+loaded = array.array("d")
+loaded.fromfile(source, 4)
+source.close()
+print(loaded)
+print(loaded == floats)
+print("")
+# array('d', [1.5, 2.5, -0.0, 0.0])
+# True
+#
+
+print("Testing reverse with live slices")
+# Testing reverse with live slices
+row = array.array("i", [1, 2, 3, 4, 5, 6, 7, 8])
+middle = row[2:6]
+middle.reverse()
+print(middle)
+print(row)
+# array('i', [6, 5, 4, 3])
+# array('i', [1, 2, 3, 4, 5, 6, 7, 8])
+head = row[0:3]
+row.reverse()
+print(row)
+print(head)
+print(middle)
+# array('i', [8, 7, 6, 5, 4, 3, 2, 1])
+# array('i', [1, 2, 3])
+# array('i', [6, 5, 4, 3])
+halves = array.array("d", [0.5, 1.5, 2.5])
+halves[0:2].reverse()
+halves.reverse()
+print(halves)
+# array('d', [2.5, 1.5, 0.5])
@@ -0,0 +1,62 @@
+import array
+
+# array.add, subtract, multiply, divide, dot, cumsum, compress, the
+# comparisons and the '?' typecode are extensions of the array module, the
+# rest of the module is covered by input_test_array.py
+ints = array.array("i", [1, 2, 3, 4])
+halves = array.array("d", [0.5, 1.5, 2.5, 3.5])
+largest = array.array("q", [9223372036854775807, 9223372036854775807])
+
+print("Testing vectorized arithmetic")
+# Testing vectorized arithmetic
+print(array.add(ints, halves))
+print(array.add(ints, 10))
+print(array.subtract(100, ints))
+print(array.multiply(ints, ints))
+print(array.divide(ints, 2))
+print(array.divide(ints, 0))
+# array('d', [1.5, 3.5, 5.5, 7.5])
+# array('i', [11, 12, 13, 14])
+# array('i', [99, 98, 97, 96])
+# array('i', [1, 4, 9, 16])
+# array('d', [0.5, 1.0, 1.5, 2.0])
+# array('d', [inf, inf, inf, inf])
+small = array.array("b", [100, -100])
+print(array.add(small, small))
+print("")
+# array('b', [-56, 56])
+#
+
+print("Testing masks")
+print(array.less(ints, 3))
+print(array.greater_equal(halves, ints))
+print(array.equal(ints, array.array("q", [1, 0, 3, 0])))
+print(array.not_equal(small, 1000))
+# Testing masks
+# array('?', [True, True, False, False])
+# array('?', [False, False, False, False])
+# array('?', [True, False, True, False])
+# array('?', [True, True])
+mask = array.greater(ints, 2)
+print(array.compress(mask, ints))
+print(sum(mask))
+print("")
+# array('i', [3, 4])
+# 2
+#
+
+print("Testing reductions")
+print(array.dot(ints, ints))
+print(array.dot(ints, halves))
+print(array.dot(largest, largest))
+# Testing reductions
+# 30
+# 25.0
+# 170141183460469231694793815568465002498
+huge = largest + largest
+print(array.dot(huge, huge))
+print(array.cumsum(ints))
+print(array.cumsum(halves))
+# 340282366920938463389587631136930004996
+# array('q', [1, 3, 6, 10])
+# array('d', [0.5, 2.0, 4.5, 8.0])
@@ -0,0 +1,154 @@
+# Names bound to the same int or str keep their value when one of them
+# is updated with an augmented assignment
+a = 5
+b = a
+a += 1
+print(a)
+print(b)
+# 6
+# 5
+a -= 10
+a *= 3
+print(a)
+print(b)
+# -12
+# 5
+big = 9223372036854775807
+other = big
+big += 1
+print(big)
+print(other)
+# 9223372036854775808
+# 9223372036854775807
+big -= 1
+print(big == other)
+# True
+
+s = "ab"
+t = s
+s += "cd"
+print(s)
+print(t)
+# abcd
+# ab
+s *= 2
+print(s)
+print(t)
+# abcdabcd
+# ab
+
+# An int stored in a container is not changed through another name
+numbers = [1, 2, 3]
+first = numbers[0]
+n = 10
+numbers.append(n)
+n += 5
+print(numbers)
+print(n)
+# [1, 2, 3, 10]
+# 15
+
+# Lists, sets and dicts are mutable: every name sees the change
+l = [1, 2]
+m = l
+l += [3]
+print(m)
+# [1, 2, 3]
+l *= 2
+print(m)
+# [1, 2, 3, 1, 2, 3]
+l += l
+print(len(m))
+# 12
+c = {1, 2}
+d = c
+c |= {3}
+print(d)
+# {1, 2, 3}
+c -= {1}
+print(d)
+# {2, 3}
+c &= {2, 3, 4}
+print(d)
+# {2, 3}
+c ^= {3, 5}
+print(d)
+# {2, 5}
+x = {"a": 1}
+y = x
+x |= {"b": 2}
+print(y)
+# {'a': 1, 'b': 2}
+
+# Every operator, with ints and floats
+i = 100
+i //= 7
+print(i)
+# 14
+i //= -3
+print(i)
+# -5
+i %= 3
+print(i)
+# 1
+i = -17
+i %= 5
+print(i)
+# 3
+i |= 8
+print(i)
+# 11
+i &= 12
+print(i)
+# 8
+i ^= 5
+print(i)
+# 13
+i <<= 3
+print(i)
+# 104
+i >>= 1
+print(i)
+# 52
+i **= 3
+print(i)
+# 140608
+i /= 4
+print(i)
+# 35152.0
+f = 7.5
+f //= 2
+print(f)
+# 3.0
+f **= 2
+print(f)
+# 9.0
+p = 3
+q = p
+p **= 40
+print(p)
+print(q)
+# 12157665459056928801
+# 3
+p //= 3
+print(p)
+# 4052555153018976267
+
+# A counter updated in a loop, the common case done in place
+total = 0
+i = 0
+while i < 1000:
+    total += i * i
+    i += 1
+print(total)
+# 332833500
+
+def bump(value):
+    value += 1
+    return value
+
+k = 41
+print(bump(k))
+print(k)
+# 42
+# 41
@@ -0,0 +1,171 @@
+# ints grow past 64 bits instead of wrapping
+factorial = 1
+i = 1
+while i <= 30:
+    factorial *= i
+    i += 1
+print(factorial)
+print(factorial // 1000000007)
+print(factorial % 1000000007)
+# 265252859812191058636308480000000
+# 265252857955421052948361
+# 109361473
+
+a = 0
+b = 1
+c = 0
+i = 0
+while i < 100:
+    c = a + b
+    a = b
+    b = c
+    i += 1
+print(a)
+# 354224848179261915075
+
+print("Literals and edges")
+print(9223372036854775807 + 1)
+print(-9223372036854775808 - 1)
+print(123456789012345678901234567890)
+print(-123456789012345678901234567890 * 3)
+print(4611686018427387904 * 2)
+print(-(-9223372036854775808))
+print(3037000500 * 3037000500)
+# Literals and edges
+# 9223372036854775808
+# -9223372036854775809
+# 123456789012345678901234567890
+# -370370367037037036703703703670
+# 9223372036854775808
+# 9223372036854775808
+# 9223372037000250000
+
+print("Back to int64")
+# Back to int64
+big = 2 ** 100
+p90 = 2 ** 90
+print(big - big + 5)
+print((big + 1) // p90)
+print(big // big)
+print(big > 9223372036854775807)
+print(-big < -9223372036854775807)
+print(big == 1267650600228229401496703205376)
+print(big != p90)
+# 5
+# 1024
+# 1
+# True
+# True
+# True
+# True
+
+print("Floor division and modulo")
+# Floor division and modulo
+p70 = 2 ** 70
+print(-p70 // 3)
+print(-p70 % 3)
+print(p70 // -3)
+print(p70 % -3)
+print(-7 // 2)
+print(-7 % 2)
+print(7 % -2)
+print((-9223372036854775808) // -1)
+print(divmod(-p70, 7))
+print(divmod(-7, 2))
+print(-7.5 // 2)
+print(-7.5 % 2)
+# -393530540239137101142
+# 2
+# -393530540239137101142
+# -2
+# -4
+# 1
+# -1
+# 9223372036854775808
+# (-168655945816773043347, 5)
+# (-4, 1)
+# -4.0
+# 0.5
+
+print("Powers")
+print(2 ** 64)
+print(3 ** 50)
+print((-3) ** 41)
+print(7 ** 0)
+print(2 ** 0.5)
+# Powers
+# 18446744073709551616
+# 717897987691852588770249
+# -36472996377170786403
+# 1
+# 1.4142135623730951
+p40 = 10 ** 40
+p38 = 10 ** 38
+print(p40 // p38)
+# 100
+
+print("Shifts and bits")
+print(1 << 100)
+print((1 << 100) >> 98)
+print(-(1 << 100) >> 99)
+print(-1 >> 200)
+print(5 >> 200)
+# Shifts and bits
+# 1267650600228229401496703205376
+# 4
+# -2
+# -1
+# 0
+p80 = 2 ** 80
+print((p80 - 1) & p70)
+print(-p80 | 255)
+print(p80 ^ -1)
+print(~p80)
+# 1180591620717411303424
+# -1208925819614629174705921
+# -1208925819614629174706177
+# -1208925819614629174706177
+
+print("Floats and text")
+# Floats and text
+p99 = 2 ** 99
+print(big / p99)
+print(0.5 * p80)
+print(p40 / 3)
+print(float(p70))
+print(big > 1.5)
+print(p70 > 10.0)
+print(str(p70) + "!")
+print(len(str(2 ** 1000)))
+print(int("123456789012345678901234567890") + 1)
+print(int("-0x1_0000_0000_0000_0000", 0))
+print(int(10.0 ** 30))
+print(abs(-p70))
+print(round(p70, -5))
+print(f"{p70:,} {p80:x} {-p70:>30}")
+# 2.0
+# 6.044629098073146e+23
+# 3.333333333333333e+39
+# 1.1805916207174113e+21
+# True
+# True
+# 1180591620717411303424!
+# 302
+# 123456789012345678901234567891
+# -18446744073709551616
+# 1000000000000000019884624838656
+# 1180591620717411303424
+# 1180591620717411300000
+# 1,180,591,620,717,411,303,424 100000000000000000000        -1180591620717411303424
+
+print("Hash mixing")
+# Hash mixing
+text = "fangless"
+modulus = 2 ** 64
+h = 14695981039346656037
+k = 0
+while k < len(text):
+    h = (h ^ ord(text[k])) * 1099511628211 % modulus
+    k += 1
+print(h)
+# 11209559096120439650
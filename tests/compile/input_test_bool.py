@@ -68,4 +68,27 @@ print("")
 print("Testing bool with None")
 # False
 print(bool(None))
-print("")
\ No newline at end of file
+print("")
+# Testing ordering between numbers and bools
+print("Testing ordering between numbers and bools")
+a = 5
+t = True
+f = False
+# True
+print(a > False)
+# False
+print(a < True)
+# True
+print(t > f)
+# True
+print(f < a)
+# False
+print(t > a)
+# True
+print(0.5 < t)
+elements = [0, 2]
+# True
+print(elements[1] > t)
+# False
+print(elements[0] > f)
+print("")
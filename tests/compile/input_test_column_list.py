@@ -0,0 +1,90 @@
+# Lists of same-arity tuples stored column by column
+rows = column_list([(1, "alpha", 2.5), (2, "beta", 0.5)])
+rows.append((3, "gamma", 1.0))
+print(rows)
+print(len(rows))
+print(rows[0])
+print(rows[-1][1])
+# [(1, 'alpha', 2.5), (2, 'beta', 0.5), (3, 'gamma', 1.0)]
+# 3
+# (1, 'alpha', 2.5)
+# gamma
+
+print("Records are tuples when taken whole")
+record = rows[1]
+print(record == (2, "beta", 0.5))
+print(rows[1:3])
+print(rows == [(1, "alpha", 2.5), (2, "beta", 0.5), (3, "gamma", 1.0)])
+rows[0] = (10, "delta", 4.0)
+print(rows[0])
+print(rows.pop())
+print(rows)
+# Records are tuples when taken whole
+# True
+# [(2, 'beta', 0.5), (3, 'gamma', 1.0)]
+# True
+# (10, 'delta', 4.0)
+# (3, 'gamma', 1.0)
+# [(10, 'delta', 4.0), (2, 'beta', 0.5)]
+
+print("Unpacking loops read the columns")
+for number, name, weight in rows:
+    print(name)
+    print(weight)
+for record in rows:
+    print(record)
+# Unpacking loops read the columns
+# delta
+# 4.0
+# beta
+# 0.5
+# (10, 'delta', 4.0)
+# (2, 'beta', 0.5)
+
+print("Field scans")
+points = column_list()
+i = 0
+while i < 1000:
+    flag = bool(i % 7 == 0)
+    weight = i * 0.5
+    points.append((i, flag, weight))
+    i += 1
+print(sum([p[0] for p in points]))
+print(sum([p[1] for p in points]))
+print(sum([w for n, flag, w in points]))
+print([name for number, name, weight in rows])
+print([r[2] for r in rows])
+# Field scans
+# 499500
+# 143
+# 249750.0
+# ['delta', 'beta']
+# [4.0, 0.5]
+
+print("Mixed columns and plain lists")
+mixed = column_list([(1, "a"), (2.5, "b"), (3, "c")])
+print(mixed)
+print(sum([m[0] for m in mixed]))
+print([m[1] for m in mixed])
+pairs = [(1, 2), (3, 4)]
+print(sum([p[1] for p in pairs]))
+print([b for a, b in pairs])
+# Mixed columns and plain lists
+# [(1, 'a'), (2.5, 'b'), (3, 'c')]
+# 6.5
+# ['a', 'b', 'c']
+# 6
+# [2, 4]
+
+print("Loops see records added and replaced on the way")
+for number, name, weight in rows:
+    if number == 10:
+        rows[1] = (20, "epsilon", 3.0)
+        rows.append((30, "zeta", 1.5))
+    print(name)
+print(sum([r[0] for r in rows]))
+# Loops see records added and replaced on the way
+# delta
+# epsilon
+# zeta
+# 60
@@ -0,0 +1,85 @@
+print("Testing membership in sets")
+numbers = {1, 5, 9, 13}
+# True
+print(5 in numbers)
+# False
+print(6 in numbers)
+# True
+print(9.0 in numbers)
+# True
+print(7 not in numbers)
+# True
+print(True in {1})
+# True
+print(0 in {False, "zero"})
+words = {"apple", "pear"}
+# True
+print("pear" in words)
+# False
+print("plum" in words)
+print("")
+
+print("Testing membership in dictionaries")
+ages = {"ana": 31, "luis": 27, 3: "three"}
+# True
+print("ana" in ages)
+# False
+print(31 in ages)
+# True
+print(3 in ages)
+# True
+print("pedro" not in ages)
+# True
+print(True in {1: "one"})
+# True
+print(0.0 in {False: "no"})
+print("")
+
+print("Testing substring membership")
+text = "the quick brown fox"
+# True
+print("quick" in text)
+# True
+print("k b" in text)
+# False
+print("quack" in text)
+# True
+print("" in text)
+# True
+print("fox!" not in text)
+print("")
+
+print("Testing membership in ranges")
+# True
+print(4 in range(10))
+# False
+print(10 in range(10))
+# True
+print(12 in range(2, 20, 5))
+# False
+print(13 in range(2, 20, 5))
+# True
+print(-1 in range(5, -5, -2))
+# False
+print(0 in range(5, -5, -2))
+# True
+print(6.0 in range(0, 10, 2))
+# False
+print(6.5 in range(0, 10, 2))
+# True
+print(3 not in range(0, 10, 2))
+huge = 2 ** 70
+# False
+print(huge in range(10))
+# True
+print(huge in range(huge // 2, huge * 2, huge // 4))
+odd = huge + 1
+# False
+print(odd in range(huge // 2, huge * 2, huge // 4))
+# True
+print(True in range(3))
+# False
+print(False in range(1, 3))
+# True
+print(9223372036854775806 in range(-9223372036854775807, 9223372036854775807))
+print("")
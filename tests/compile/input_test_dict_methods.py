@@ -101,3 +101,16 @@ for value in d.values():
 print(list(d.values()))  # Outputs: [1, 2]
 empty_dict = {}
 print(empty_dict.values())  # Outputs: dict_values([])
+
+# equal int, float and bool keys are a single key
+print("\nmixed numeric keys examples:")
+e = {}
+e[1] = "a"
+e[1.0] = "b"
+print(e)  # Outputs: {1: 'b'}
+e[True] = "c"
+e[2.5] = "d"
+print(e)  # Outputs: {1: 'c', 2.5: 'd'}
+print(len(e))  # Outputs: 2
+print(e[1.0])  # Outputs: c
+print(len({0: "int", 0.0: "float", False: "bool"}))  # Outputs: 1
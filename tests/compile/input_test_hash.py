@@ -0,0 +1,108 @@
+# equal numbers hash alike, whatever their type
+print(hash(1) == hash(1.0))
+print(hash(True) == hash(1))
+print(hash(0) == hash(False))
+print(hash(0.0) == hash(-0.0))
+# True
+# True
+# True
+# True
+
+# ints hash to their value mod 2^61 - 1, and -1 is never a hash
+print(hash(-1))
+print(hash(-2))
+print(hash(12345678901234567))
+print(hash(2305843009213693951))
+print(hash(2305843009213693952))
+print(hash(-9223372036854775808))
+# -2
+# -2
+# 12345678901234567
+# 0
+# 1
+# -4
+big = 10 ** 30
+print(hash(big))
+print(hash(-big))
+# 465258685558744706
+# -465258685558744706
+
+# floats hash through their exact value
+print(hash(0.5))
+print(hash(-2.75))
+# 1152921504606846976
+# -1729382256910270466
+huge = 10.0 ** 100
+print(hash(huge))
+# 1822893315824342674
+tiny = 0.1 ** 300
+print(hash(tiny))
+print(hash(3.141592653589793))
+print(hash(float("inf")))
+print(hash(float("-inf")))
+# 538744578094411663
+# 326490430436040707
+# 314159
+# -314159
+f70 = 2.0 ** 70
+i70 = 2 ** 70
+print(hash(f70) == hash(i70))
+# True
+
+# tuples mix their elements in order
+print(hash((1, 2)))
+print(hash((2, 1)))
+print(hash((5, 5)))
+print(hash(()))
+print(hash((-1,)))
+print(hash((1, (2, 3.5), True)))
+print(hash((1, 2)) == hash((1.0, 2.0)))
+print(hash((1, 2)) == hash((2, 1)))
+# -3550055125485641917
+# 6794810172467074373
+# 2283807709307846243
+# 5740354900026072187
+# 8078679518589016365
+# 7245000938040378342
+# True
+# False
+
+# pairs as list members
+points = []
+x = 0
+while x < 40:
+    points.append((x, x))
+    x += 1
+print((7, 7) in points)
+print((7, 8) in points)
+# True
+# False
+
+# a cached hash never changes the outcome of ==
+near = (0.1 + 0.2, 1)
+exact = (0.3, 1)
+before = near == exact
+hash(near)
+hash(exact)
+after = near == exact
+print(before == after)
+nested = ((0.1 + 0.2, "x"), 2)
+other = ((0.3, "x"), 2)
+before = nested == other
+hash(nested)
+hash(other)
+print(before == (nested == other))
+# True
+# True
+
+# 1, 1.0 and True hash alike and are a single key of a dict or a set
+print(hash(1) == hash(1.0) and hash(1.0) == hash(True))
+keys = {}
+keys[1] = "int"
+keys[1.0] = "float"
+keys[True] = "bool"
+print(keys)
+print({1, 1.0, True})
+# True
+# {1: 'bool'}
+# {1}
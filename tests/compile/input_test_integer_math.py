@@ -0,0 +1,143 @@
+import math
+
+# pow with a modulus
+print(pow(3, 200, 1000007))
+print(pow(2, 10, 1000))
+print(pow(7, 0, 13))
+print(pow(5, 3, 1))
+print(pow(-3, 5, 7))
+print(pow(3, 5, -7))
+print(pow(-3, 5, -7))
+print(pow(2, 64, 18446744073709551557))
+print(pow(12345678901, 98765, 9223372036854775783))
+print(pow(10, 18, 9223372036854775808))
+# 959082
+# 24
+# 1
+# 0
+# 2
+# -2
+# -5
+# 59
+# 4453232985659837799
+# 1000000000000000000
+
+# negative exponents invert the base first
+print(pow(3, -1, 7))
+print(pow(38, -1, 97))
+print(pow(2, -3, 11))
+print(pow(10, -1, -7))
+# 5
+# 23
+# 7
+# -2
+
+# moduli beyond 64 bits
+p127 = 2 ** 127
+m127 = p127 - 1
+print(pow(3, m127 - 1, m127))
+print(pow(2, 1000, m127))
+# 1
+# 2596148429267413814265248164610048
+p200 = 2 ** 200
+big = p200 + 235
+print(pow(123456789, 987654321, big))
+print(pow(p200, 3, big))
+print(pow(5, -1, big))
+print(pow(-7, 12345, -big))
+# 1429835316702513454477897568947970621859547068621592625605459
+# 1606938044258990275541962092341162602522202993782792822323736
+# 1285550435407192220433569673872930082017762395026234268241289
+# -608630462027022404207909276171562384993852153182356507460543
+
+# Fermat test with a 61 bit prime
+p61 = 2 ** 61
+m61 = p61 - 1
+witness = 2
+prime = True
+while witness < 20:
+    if pow(witness, m61 - 1, m61) != 1:
+        prime = False
+    witness += 1
+print(prime)
+# True
+
+# exact powers
+p = 3 ** 40
+print(p)
+print(p == 12157665459056928801)
+print(7 ** 23)
+print((-2) ** 63)
+print(2 ** -2)
+# 12157665459056928801
+# True
+# 27368747340080916343
+# -9223372036854775808
+# 0.25
+
+# gcd and lcm
+print(math.gcd(12, 18))
+print(math.gcd(0, 0))
+print(math.gcd(0, -9))
+print(math.gcd(-12, 18))
+print(math.gcd(1071, 462))
+print(math.gcd(2 ** 40, 6 ** 20))
+print(math.gcd(p200, 6 ** 80))
+print(math.gcd(p127 * 3, p127 * 5))
+print(math.gcd(12, 18, 27))
+print(math.gcd(7))
+print(math.gcd())
+print(math.lcm(4, 6))
+print(math.lcm(0, 5))
+print(math.lcm(-4, 6))
+print(math.lcm(4, 6, 10))
+print(math.lcm(4294967296, 4294967295))
+print(math.lcm(p127, 3))
+print(math.lcm())
+# 6
+# 0
+# 9
+# 6
+# 21
+# 1048576
+# 1208925819614629174706176
+# 170141183460469231731687303715884105728
+# 3
+# 7
+# 0
+# 12
+# 0
+# 12
+# 60
+# 18446744069414584320
+# 510423550381407695195061911147652317184
+# 1
+
+# isqrt
+print(math.isqrt(0))
+print(math.isqrt(1))
+print(math.isqrt(15))
+print(math.isqrt(16))
+print(math.isqrt(17))
+print(math.isqrt(9223372036854775807))
+print(math.isqrt(p200))
+print(math.isqrt(p200 - 1))
+print(math.isqrt(10 ** 50))
+# 0
+# 1
+# 3
+# 4
+# 4
+# 3037000499
+# 1267650600228229401496703205376
+# 1267650600228229401496703205375
+# 10000000000000000000000000
+n = 0
+total = 0
+while n < 1000:
+    r = math.isqrt(n)
+    if r * r <= n and n < (r + 1) * (r + 1):
+        total += 1
+    n += 1
+print(total)
+# 1000
@@ -0,0 +1,37 @@
+# List comprehensions with a single for clause
+lengths = [len(w) for w in ["alpha", "beta", "gamma"]]
+print(lengths)
+print(sum(lengths))
+# [5, 4, 5]
+# 14
+
+print("Over ranges, strings and tuples")
+print([n for n in range(2, 6)])
+print([c for c in "abc"])
+print([str(n) for n in (1, 2.5, True)])
+print([abs(n) for n in [-3, 4, -5.5]])
+# Over ranges, strings and tuples
+# [2, 3, 4, 5]
+# ['a', 'b', 'c']
+# ['1', '2.5', 'True']
+# [3, 4, 5.5]
+
+print("Nested and unpacked")
+rows = [[c for c in "ab"] for n in range(2)]
+print(rows)
+pairs = [(1, "one"), (2, "two")]
+print([name for number, name in pairs])
+print([])
+# Nested and unpacked
+# [['a', 'b'], ['a', 'b']]
+# ['one', 'two']
+# []
+
+print("Loop names stay local")
+x = "outer"
+copies = [x for x in ["a", "b"]]
+print(copies)
+print(x)
+# Loop names stay local
+# ['a', 'b']
+# outer
@@ -0,0 +1,54 @@
+print("Testing repeated membership on a large list")
+seen = []
+repeated = 0
+value = 0
+while value < 300:
+    key = value % 40
+    if key in seen:
+        repeated += 1
+    else:
+        seen.append(key)
+    value += 1
+# 260
+print(repeated)
+# 40
+print(len(seen))
+print("")
+
+print("Testing index and count after appends")
+seen.append(7)
+# 7
+print(seen.index(7))
+# 2
+print(seen.count(7))
+# True
+print(39 in seen)
+# False
+print(40 in seen)
+print("")
+
+print("Testing membership after pop")
+seen.pop()
+seen.pop()
+# False
+print(39 in seen)
+# 1
+print(seen.count(7))
+print("")
+
+print("Testing membership after mutation")
+seen.remove(0)
+# 0
+print(seen.index(1))
+seen.insert(0, 100)
+# 0
+print(seen.index(100))
+seen[1] = "one"
+# 1
+print(seen.index("one"))
+# False
+print(1 in seen)
+seen.append(5.0)
+# 2
+print(seen.count(5))
+print("")
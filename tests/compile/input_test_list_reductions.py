@@ -0,0 +1,109 @@
+# lists of plain ints and floats take the unboxed kernels
+print("ints")
+# ints
+values = []
+i = 0
+while i < 1000:
+    values.append((i * 7919) % 1009 - 500)
+    i += 1
+print(sum(values))
+print(sum(values, 10))
+print(max(values))
+print(min(values))
+print(values.count(3))
+print(values.index(3))
+print(3 in values)
+print(5000 in values)
+print(values.count(3.0))
+print(values.index(-500.0))
+# 4678
+# 4688
+# 508
+# -500
+# 1
+# 643
+# True
+# False
+# 1
+# 0
+
+# int sums are exact past 64 bits
+print("big sums")
+# big sums
+big = [9223372036854775807, 9223372036854775807, 5]
+print(sum(big))
+# 18446744073709551619
+neg = [-9223372036854775807, -9223372036854775807, -9]
+print(sum(neg))
+# -18446744073709551623
+
+print("floats")
+# floats
+floats = []
+i = 0
+while i < 1000:
+    floats.append(((i * 31) % 97) / 8)
+    i += 1
+print(sum(floats))
+print(max(floats))
+print(min(floats))
+print(floats.count(1.5))
+print(floats.index(2.0))
+print(2 in floats)
+print(2.0625 in floats)
+# 6002.125
+# 12.0
+# 0.0
+# 10
+# 85
+# True
+# False
+tenths = [0.5, 0.25, 0.125]
+print(sum(tenths))
+# 0.875
+
+# a NaN never compares smaller or larger, so it wins only when it comes first
+print("nan")
+# nan
+nan = float("nan")
+first_nan = [nan, 1.0, -2.0]
+print(max(first_nan))
+print(min(first_nan))
+# nan
+# nan
+later_nan = [3.0, nan, 1.0, 7.0]
+print(max(later_nan))
+print(min(later_nan))
+# 7.0
+# 1.0
+zeros = [0.0, -0.0]
+print(min(zeros))
+print(max(zeros))
+# 0.0
+# 0.0
+
+# anything else takes the generic path
+print("mixed")
+# mixed
+mixed = [1, 2.5, 3]
+print(sum(mixed))
+print(max(mixed))
+print(min(mixed))
+print(mixed.count(3))
+print(2.5 in mixed)
+# 6.5
+# 3
+# 1
+# 1
+# True
+words = ["pear", "apple", "fig"]
+print(max(words))
+print(min(words))
+print(max("hello"))
+print(max(range(5)))
+print(min((4, 2, 8)))
+# pear
+# apple
+# o
+# 4
+# 2
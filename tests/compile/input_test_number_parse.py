@@ -0,0 +1,87 @@
+# int() of text, with surrounding whitespace, signs and underscores
+print(int("42"))
+print(int("  -17\n"))
+print(int("+1_000_000"))
+print(int("9223372036854775807"))
+print(int("-9223372036854775808"))
+# 42
+# -17
+# 1000000
+# 9223372036854775807
+# -9223372036854775808
+
+print("Bases and prefixes")
+print(int("ff", 16))
+print(int("0xff", 16))
+print(int("0x_ff", 0))
+print(int("0o17", 0))
+print(int("0b1010", 0))
+print(int("1010", 2))
+print(int("zz", 36))
+print(int("00", 0))
+# Bases and prefixes
+# 255
+# 255
+# 255
+# 15
+# 10
+# 10
+# 1295
+# 0
+
+print("Floats and bools")
+print(int(7.9))
+print(int(-7.9))
+print(int(True))
+print(int(False))
+# Floats and bools
+# 7
+# -7
+# 1
+# 0
+
+print("float() of text")
+print(float("3.25"))
+print(float("  -0.5  "))
+print(float("1e3"))
+print(float("1_000.000_5"))
+print(float(".5"))
+print(float("5."))
+print(float("inf"))
+print(float("-Infinity"))
+print(float("nan"))
+print(float("1e999"))
+print(float("1e-999"))
+# float() of text
+# 3.25
+# -0.5
+# 1000.0
+# 1000.0005
+# 0.5
+# 5.0
+# inf
+# -inf
+# nan
+# inf
+# 0.0
+
+print("List comprehensions")
+# List comprehensions
+line = "  10 -20   30\t40 "
+numbers = [int(x) for x in line.split()]
+print(numbers)
+print(sum(numbers))
+# [10, -20, 30, 40]
+# 60
+values = [float(x) for x in "1.5 2_000.25 -inf 1e3".split()]
+print(values)
+# [1.5, 2000.25, -inf, 1000.0]
+parts = ["7", " 8 ", "0x10"]
+print([int(p, 0) for p in parts])
+print([str(w) for w in "a b c".split()])
+print([int(n) for n in [1.5, 2.5, True]])
+print(line.split())
+# [7, 8, 16]
+# ['a', 'b', 'c']
+# [1, 2, 1]
+# ['10', '-20', '30', '40']
@@ -0,0 +1,67 @@
+# floats print their shortest round-trip repr, like python
+print(0.1 + 0.2)
+print(1.0 / 3.0)
+print(2.0 / 3.0)
+print(100.0)
+print(-456.0)
+print(0.0)
+print(-0.0)
+print(123456789.125)
+# 0.30000000000000004
+# 0.3333333333333333
+# 0.6666666666666666
+# 100.0
+# -456.0
+# 0.0
+# -0.0
+# 123456789.125
+
+print("Exponent notation outside [1e-4, 1e16)")
+print(0.0001)
+print(0.00001)
+print(0.000015)
+print(1000000000000000.0)
+print(10000000000000000.0)
+print(2.0 ** 100)
+print(2.0 ** -30)
+print(10.0 ** 300)
+# Exponent notation outside [1e-4, 1e16)
+# 0.0001
+# 1e-05
+# 1.5e-05
+# 1000000000000000.0
+# 1e+16
+# 1.2676506002282294e+30
+# 9.313225746154785e-10
+# 1e+300
+
+print("Floats inside strings and containers")
+# Floats inside strings and containers
+values = [0.5]
+values.append(0.1 * 3.0)
+values.append(1.0 / 7.0)
+print(values)
+print(str(1.5 * 1.5))
+print(str(0.1 + 0.7))
+# [0.5, 0.30000000000000004, 0.14285714285714285]
+# 2.25
+# 0.7999999999999999
+
+print("Integers")
+print(0)
+print(7)
+print(-100)
+print(1234567890)
+print(9223372036854775807)
+print(-9223372036854775807 - 1)
+print(str(-98765))
+print([10, -20, 300])
+# Integers
+# 0
+# 7
+# -100
+# 1234567890
+# 9223372036854775807
+# -9223372036854775808
+# -98765
+# [10, -20, 300]
@@ -133,3 +133,13 @@ s.update(set())
 print(s)  # Outputs: {1, 2, 3, 4, 5}
 s.update({6})
 print(s)  # Outputs: {1, 2, 3, 4, 5, 6}
+
+# equal int, float and bool elements are a single element
+print("\nmixed numeric elements examples:")
+s = {1, 1.0, True}
+print(len(s))  # Outputs: 1
+print(s)  # Outputs: {1}
+s.add(2.0)
+s.add(2)
+print(s)  # Outputs: {1, 2.0}
+print({0, False, 0.0, 3})  # Outputs: {0, 3}
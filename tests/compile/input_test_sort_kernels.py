@@ -0,0 +1,85 @@
+# lists of plain ints, floats or strings are sorted by the unboxed kernels
+print("ints")
+# ints
+values = []
+i = 0
+while i < 300:
+    values.append((i * 7919) % 1009 - 500)
+    i += 1
+values.append(9223372036854775807)
+values.append(-9223372036854775807)
+values.sort()
+print(values[0])
+print(values[1])
+print(values[150])
+print(values[301])
+print(values[0:12])
+# -9223372036854775807
+# -500
+# 5
+# 9223372036854775807
+# [-9223372036854775807, -500, -499, -495, -491, -487, -483, -479, -475, -474, -471, -470]
+values.sort(reverse=True)
+print(values[0:12])
+print(sorted([5, 3, 9, 3, -1, 0]))
+print(sorted([5, 3, 9, 3, -1, 0], reverse=True))
+# [9223372036854775807, 506, 505, 501, 497, 493, 489, 485, 481, 477, 476, 473]
+# [-1, 0, 3, 3, 5, 9]
+# [9, 5, 3, 3, 0, -1]
+
+# -0.0 and 0.0 are equal and keep their order
+print("floats")
+# floats
+floats = []
+i = 0
+while i < 300:
+    floats.append(((i * 31) % 97) / 8 - 6)
+    i += 1
+floats.sort()
+print(floats[0:10])
+print(floats[290:300])
+# [-6.0, -6.0, -6.0, -6.0, -5.875, -5.875, -5.875, -5.75, -5.75, -5.75]
+# [5.625, 5.75, 5.75, 5.75, 5.875, 5.875, 5.875, 6.0, 6.0, 6.0]
+zeros = [0.0, -0.0, 1.5, -0.0, 0.0, -2.5]
+print(sorted(zeros))
+print(sorted(zeros, reverse=True))
+# [-2.5, 0.0, -0.0, -0.0, 0.0, 1.5]
+# [1.5, 0.0, -0.0, -0.0, 0.0, -2.5]
+zeros.sort()
+print(zeros)
+# [-2.5, 0.0, -0.0, -0.0, 0.0, 1.5]
+
+# strings order by their utf-8 bytes, which is code point order
+print("strings")
+# strings
+words = "the quick brown fox jumps over the lazy dog and then the fox naps".split()
+print(sorted(words))
+print(sorted(words, reverse=True))
+# ['and', 'brown', 'dog', 'fox', 'fox', 'jumps', 'lazy', 'naps', 'over', 'quick', 'the', 'the', 'the', 'then']
+# ['then', 'the', 'the', 'the', 'quick', 'over', 'naps', 'lazy', 'jumps', 'fox', 'fox', 'dog', 'brown', 'and']
+many = []
+i = 0
+while i < 200:
+    many.append(str((i * 37) % 101))
+    i += 1
+many.sort()
+print(many[0:15])
+print(many[185:200])
+# ['0', '0', '1', '1', '10', '10', '100', '100', '11', '11', '12', '12', '13', '13', '14']
+# ['92', '93', '93', '94', '94', '95', '95', '96', '96', '97', '97', '98', '98', '99', '99']
+accents = ["zoo", "éclair", "apple", "Zebra", "", "a", "ab", "über", "aa"]
+accents.sort()
+print(accents)
+# ['', 'Zebra', 'a', 'aa', 'ab', 'apple', 'zoo', 'éclair', 'über']
+
+# other lists take the comparison sort
+print("generic")
+# generic
+pairs = [(2, "b"), (1, "z"), (2, "a")]
+pairs.sort()
+print(pairs)
+# [(1, 'z'), (2, 'a'), (2, 'b')]
+mixed_big = [5, 100000000000000000000, -3]
+mixed_big.sort()
+print(mixed_big)
+# [-3, 5, 100000000000000000000]
@@ -0,0 +1,152 @@
+def text(value):
+    return str(value)
+
+# key functions are called once per element, equal keys keep their order
+print("keys")
+# keys
+words = ["pear", "fig", "banana", "kiwi", "apple", "date", "plum"]
+print(sorted(words, key=len))
+print(sorted(words, key=len, reverse=True))
+print(sorted(words, reverse=True))
+# ['fig', 'pear', 'kiwi', 'date', 'plum', 'apple', 'banana']
+# ['banana', 'apple', 'pear', 'kiwi', 'date', 'plum', 'fig']
+# ['plum', 'pear', 'kiwi', 'fig', 'date', 'banana', 'apple']
+words.sort(key=len)
+print(words)
+# ['fig', 'pear', 'kiwi', 'date', 'plum', 'apple', 'banana']
+words.sort(key=len, reverse=True)
+print(words)
+# ['banana', 'apple', 'pear', 'kiwi', 'date', 'plum', 'fig']
+numbers = [10, 9, 100, 1, 25]
+print(sorted(numbers, key=text))
+# [1, 10, 100, 25, 9]
+groups = [[1, 2], [3], [], [4, 5, 6], [7]]
+groups.sort(key=len)
+print(groups)
+print(sorted(words, key=None))
+print("")
+# [[], [3], [7], [1, 2], [4, 5, 6]]
+# ['apple', 'banana', 'date', 'fig', 'kiwi', 'pear', 'plum']
+#
+
+# builtins that take any object can be keys
+print("builtin keys")
+# builtin keys
+offsets = [-3, 1, -2.5, 0, 2]
+print(sorted(offsets, key=abs))
+print(sorted(offsets, key=abs, reverse=True))
+# [0, 1, 2, -2.5, -3]
+# [-3, -2.5, 2, 1, 0]
+flags = [3, 0, "", "a", [], 1]
+print(sorted(flags, key=bool))
+# [0, '', [], 3, 'a', 1]
+digits = ["10", "9", "100", "-1"]
+digits.sort(key=int)
+print(digits)
+print(sorted(["2.5", "-1", "0.75"], key=float))
+print("")
+# ['-1', '9', '10', '100']
+# ['-1', '0.75', '2.5']
+#
+
+# ints, floats and bools sort together as numbers
+print("mixed numbers")
+# mixed numbers
+mixed = [3, 1.5, True, -2, 0.0, False, 2.5, 1, 0]
+print(sorted(mixed))
+print(sorted(mixed, reverse=True))
+# [-2, 0.0, False, 0, True, 1, 1.5, 2.5, 3]
+# [3, 2.5, 1.5, True, 1, 0.0, False, 0, -2]
+mixed.sort()
+print(mixed)
+# [-2, 0.0, False, 0, True, 1, 1.5, 2.5, 3]
+big = [2.5, 100000000000000000000, -1, 0.5]
+big.sort()
+print(big)
+print("")
+# [-1, 0.5, 2.5, 100000000000000000000]
+#
+
+# runs already in order are merged instead of sorted again
+print("runs")
+# runs
+pairs = []
+i = 0
+while i < 500:
+    group = i // 3
+    name = "p" + str(i)
+    pairs.append((group, name))
+    i += 1
+pairs.append((7, "late"))
+pairs.append((0, "first"))
+pairs.sort()
+print(pairs[0:4])
+print(pairs[21:26])
+print(pairs[501])
+# [(0, 'first'), (0, 'p0'), (0, 'p1'), (0, 'p2')]
+# [(6, 'p20'), (7, 'late'), (7, 'p21'), (7, 'p22'), (7, 'p23')]
+# (166, 'p499')
+descending = []
+i = 300
+while i > 0:
+    descending.append(i * 0.5)
+    i -= 1
+descending.append(75)
+descending.sort()
+print(descending[0:5])
+print(descending[148:153])
+print(descending[300])
+print("")
+# [0.5, 1.0, 1.5, 2.0, 2.5]
+# [74.5, 75.0, 75, 75.5, 76.0]
+# 150.0
+#
+
+print("reversed")
+print(list(reversed([1, "two", 3.0, (4, 5)])))
+print(list(reversed([])))
+# reversed
+# [(4, 5), 3.0, 'two', 1]
+# []
+
+# key functions can index the elements they receive
+print("indexing keys")
+# indexing keys
+
+
+def first(record):
+    return record[0]
+
+
+def second(record):
+    return record[1]
+
+
+def last_letter(word):
+    return word[-1]
+
+
+def nested(record):
+    return record[1][0]
+
+
+def price(entry):
+    return entry["price"]
+
+
+records = [(3, "c"), (1, "z"), (2, "a"), (1, "b")]
+print(sorted(records, key=first))
+print(sorted(records, key=second))
+records.sort(key=second, reverse=True)
+print(records)
+# [(1, 'z'), (1, 'b'), (2, 'a'), (3, 'c')]
+# [(2, 'a'), (1, 'b'), (3, 'c'), (1, 'z')]
+# [(1, 'z'), (3, 'c'), (1, 'b'), (2, 'a')]
+print(sorted(["pear", "fig", "kiwi"], key=last_letter))
+print(sorted([[1, "b"], [2, "a"]], key=nested))
+print(sorted([{"price": 2.5}, {"price": 1}], key=price))
+print(sorted([(True, "t"), (False, "f"), (0.5, "h")], key=first))
+# ['fig', 'kiwi', 'pear']
+# [[2, 'a'], [1, 'b']]
+# [{'price': 1}, {'price': 2.5}]
+# [(False, 'f'), (0.5, 'h'), (True, 't')]
@@ -0,0 +1,124 @@
+print("Testing append and len on a spilled list")
+records = spilled_list()
+value = 0
+while value < 1000:
+    records.append((value * 37) % 1000)
+    value += 1
+# 1000
+print(len(records))
+# 0
+print(records[0])
+# 963
+print(records[-1])
+print("")
+
+print("Testing slicing and iteration")
+# [37, 74, 111]
+print(records[1:4])
+# [0, 37, 74]
+print(records[:3])
+total = 0
+for record in records:
+    total += 1
+# 1000
+print(total)
+print("")
+
+print("Testing sort and sorted")
+backwards = sorted(records, reverse=True)
+# 999
+print(backwards[0])
+records.sort()
+# [0, 1, 2, 3, 4]
+print(records[:5])
+# 999
+print(records[999])
+print("")
+
+print("Testing spilled records of several types")
+rows = spilled_list([("ana", 31, 1.5), ("luis", None, True)])
+rows.append(["nested", [1, 2]])
+# [('ana', 31, 1.5), ('luis', None, True), ['nested', [1, 2]]]
+print(rows)
+# ('luis', None, True)
+print(rows[1])
+print("")
+
+print("Testing sort runs, merge passes and window moves")
+# 64 byte sort runs (8 ints each), 4 runs merged at once, one page mapped
+numbers = spilled_list([], 64, 4, 4096)
+value = 0
+while value < 1000:
+    numbers.append((value * 7919) % 1000)
+    value += 1
+ordered = []
+value = 0
+while value < 1000:
+    ordered.append(value)
+    value += 1
+numbers.sort()
+# True
+print(list(numbers) == ordered)
+# [997, 998, 999]
+print(numbers[997:1000])
+numbers.sort(reverse=True)
+# [999, 998, 997]
+print(numbers[:3])
+# 0
+print(numbers[-1])
+print("")
+
+print("Testing records across window boundaries")
+words = spilled_list([], 4096, 2, 4096)
+value = 0
+while value < 40:
+    words.append(str(value % 7) * 1500)
+    value += 1
+# True
+print(words[2] == "2" * 1500)
+# True
+print(words[39] == "4" * 1500)
+words.sort()
+# True
+print(words[0] == "0" * 1500)
+# True
+print(words[39] == "6" * 1500)
+count = 0
+for word in words:
+    if word == "3" * 1500:
+        count += 1
+# 6
+print(count)
+print("")
+
+print("Testing mixed numbers and big ints")
+# 64 byte sort runs, so mixed keys also meet in the merge passes
+mixed = spilled_list([], 64, 2, 4096)
+mixed.append(3)
+mixed.append(2.5)
+mixed.append(True)
+mixed.append(2 ** 100)
+mixed.append(0 - 2 ** 70)
+mixed.append(0.5)
+mixed.append(False)
+mixed.append(7)
+mixed.append(-3)
+mixed.append(1)
+mixed.sort()
+# [-1180591620717411303424, -3, False, 0.5, True, 1, 2.5, 3, 7, 1267650600228229401496703205376]
+print(mixed)
+# 1267650600228229401496703205376
+print(mixed[9])
+descending = sorted(mixed, reverse=True)
+# [1267650600228229401496703205376, 7, 3]
+print(descending[0:3])
+limit = 2 ** 64
+half = 2 ** 63
+big = spilled_list([limit, half])
+big.append(-limit - 1)
+big.append(-half)
+# [18446744073709551616, 9223372036854775808, -18446744073709551617, -9223372036854775808]
+print(big)
+# -18446744073709551617
+print(big[2])
+print("")
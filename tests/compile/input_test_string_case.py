@@ -0,0 +1,68 @@
+# Case transforms and classification on short and long strings
+short: str = "Hello World 42"
+long_text: str = "The Quick Brown Fox Jumps Over The Lazy Dog 0123456789 " * 3
+print(short.upper())
+print(short.lower())
+print(short.swapcase())
+print(short.casefold())
+print("hELLO wORLD".capitalize())
+print("".capitalize())
+print(long_text.upper())
+print(long_text.swapcase())
+# HELLO WORLD 42
+# hello world 42
+# hELLO wORLD 42
+# hello world 42
+# Hello world
+#
+# THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789
+# tHE qUICK bROWN fOX jUMPS oVER tHE lAZY dOG 0123456789 tHE qUICK bROWN fOX jUMPS oVER tHE lAZY dOG 0123456789 tHE qUICK bROWN fOX jUMPS oVER tHE lAZY dOG 0123456789
+
+print("abcdefghijklmnopqrstuvwxyz".isalpha())
+print("abcdefghijklmnopqrstuvwxyz1".isalpha())
+print("0123456789012345678901234".isdigit())
+print("01234567890123456789x1234".isdigit())
+print("abc123ABC456def789GHI".isalnum())
+print("abc123ABC456 def789GHI".isalnum())
+print("      \t\n          ".isspace())
+print("".isspace())
+print("ALL UPPER CASE WITH DIGITS 123".isupper())
+print("ALL UPPER CASE WITH ONE lower".isupper())
+print("all lower case with digits 123".islower())
+print("123".islower())
+print(long_text.isprintable())
+print("tab\tinside".isprintable())
+print(long_text.isascii())
+print("héllo".isascii())
+# True
+# False
+# True
+# False
+# True
+# False
+# True
+# False
+# True
+# False
+# True
+# False
+# True
+# False
+# True
+# False
+
+padded: str = "  \t  text with spaces  \t "
+print("[" + padded.strip() + "]")
+print("[" + padded.lstrip() + "]")
+print("[" + padded.rstrip() + "]")
+print("xxyyhelloyyxx".strip("xy"))
+print("xxyyhelloyyxx".lstrip("xy"))
+print("xxyyhelloyyxx".rstrip("xy"))
+print("[" + "xyxy".strip("xy") + "]")
+# [text with spaces]
+# [text with spaces  	 ]
+# [  	  text with spaces]
+# hello
+# helloyyxx
+# xxyyhello
+# []
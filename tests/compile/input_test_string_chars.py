@@ -0,0 +1,44 @@
+# Single characters come from a shared table, so they compare by identity
+word: str = "hello world"
+first: str = word[0]
+last: str = word[-1]
+print(first)
+print(last)
+print(first == "h")
+print(word[4] is word[7])
+# h
+# d
+# True
+# True
+
+# Taking a character and changing it leaves the table untouched
+letter: str = word[1]
+letter += "!"
+print(letter)
+print(word[1])
+# e!
+# e
+
+print(list("abca"))
+print(tuple("xyz"))
+print(len(set("mississippi")))
+print(list(enumerate("ab")))
+# ['a', 'b', 'c', 'a']
+# ('x', 'y', 'z')
+# 4
+# [(0, 'a'), (1, 'b')]
+
+seen: set = set()
+text: str = "abracadabra"
+index: int = 0
+while index < len(text):
+    character: str = text[index]
+    if character not in seen:
+        seen.add(character)
+    index += 1
+print(len(seen))
+print("c" in text)
+print("z" in text)
+# 5
+# True
+# False
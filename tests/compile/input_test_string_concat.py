@@ -0,0 +1,59 @@
+# Accumulating a string in a loop appends in place
+text: str = ""
+counter: int = 0
+while counter < 5:
+    text = text + str(counter)
+    counter += 1
+print(text)
+# 01234
+
+# Other references keep the old value
+alias: str = text
+text = text + "x"
+print(alias)
+print(text)
+# 01234
+# 01234x
+
+saved: str = text
+text += "y"
+print(saved)
+print(text)
+# 01234x
+# 01234xy
+
+# Strings stored in a container are not modified either
+pieces: list = []
+piece: str = "ab"
+pieces.append(piece)
+piece += "cd"
+print(pieces)
+print(piece)
+# ['ab']
+# abcd
+
+# Chained concatenation
+first: str = "a"
+second: str = "b"
+third: str = "c"
+joined: str = first + second + third + first
+print(joined)
+print(first)
+# abca
+# a
+
+# Interned strings are detached before being appended to
+name: str = "key"
+other: str = "key"
+name += "s"
+print(name)
+print(other)
+print(name == "keys")
+# keys
+# key
+# True
+
+print("".join(reversed("hello world")))
+print("".join(reversed("")))
+# dlrow olleh
+#
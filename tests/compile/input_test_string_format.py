@@ -0,0 +1,52 @@
+# f-strings, the fields are compiled into a single builder call
+name = "Ada"
+count = 3
+price = 1234.5678
+print(f"{name} has {count} items")
+print(f"[{name:>6}] [{name:<6}] [{name:^7}] [{name:*^9}]")
+print(f"{count:04d} {count:+d} {-count:5d} {count:<4}|")
+print(f"{price:.2f} {price:10.3f} {price:,.1f} {price:e} {price:.3g}")
+print(f"{255:x} {255:#X} {255:#o} {5:b} {1234567:,} {1234567:_}")
+print(f"{0.25:.1%} {-0.0001:z.2f} {1234:012,} {3.0:.3} {100.0:.3}")
+print(f"{count * 2 + 1} {name.upper()} {len(name)}")
+print(f"{name!r} {count=} {{literal}}")
+print(f"{True} {True:>5} {None} {[1, 2]}")
+print(f"{'ñandú':>7}|{'ñandú':.3}|")
+# Ada has 3 items
+# [   Ada] [Ada   ] [  Ada  ] [***Ada***]
+# 0003 +3    -3 3   |
+# 1234.57   1234.568 1,234.6 1.234568e+03 1.23e+03
+# ff 0XFF 0o377 101 1,234,567 1_234_567
+# 25.0% 0.00 0,000,001,234 3.0 1e+02
+# 7 ADA 3
+# 'Ada' count=3 {literal}
+# True     1 None [1, 2]
+#   ñandú|ñan|
+
+# str.format with automatic and numbered fields
+print("{} + {} = {}".format(1, 2, 1 + 2))
+print("{1} {0} {1}".format("a", "b"))
+print("{:>8.3f}|{:<6}|{:^6}|".format(3.14159, "ab", "cd"))
+# 1 + 2 = 3
+# b a b
+#    3.142|ab    |  cd  |
+
+# printf style formatting
+print("%d items" % count)
+print("%s is %d years old" % (name, 36))
+print("%5.2f|%-6s|%06.2f|%x|%o|%e" % (price, name, -2.5, 255, 8, 0.5))
+print("%r %c%c %5s %% %.2s" % (name, 65, "b", "abc", "xyz"))
+print("%+d % d %05d %.3d" % (7, 7, -42, 5))
+# 3 items
+# Ada is 36 years old
+# 1234.57|Ada   |-02.50|ff|10|5.000000e-01
+# 'Ada' Ab   abc % xy
+# +7  7 -0042 005
+
+# format() builtin
+print(format(price, ".1f"))
+print(format(42, "08b"))
+print(format("x", "^5") + "|")
+# 1234.6
+# 00101010
+#   x  |
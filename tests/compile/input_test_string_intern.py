@@ -0,0 +1,88 @@
+import sys
+
+print("Testing interned dictionary keys")
+ages = {"ana": 31, "luis": 27}
+name = "an"
+name += "a"
+# 31
+print(ages[name])
+# True
+print(name in ages)
+# True
+print(name == "ana")
+print("")
+
+print("Testing explicit interning")
+first = sys.intern("hello world")
+second = sys.intern("hello " + "world")
+# True
+print(first is second)
+# True
+print(first == second)
+third = "hello world!"
+# False
+print(first == third)
+print("")
+
+print("Testing identity of built strings")
+literal = "abc"
+same_literal = "abc"
+# True
+print(literal is same_literal)
+built = "ab"
+built += "c"
+rebuilt = "a"
+rebuilt += "bc"
+# True
+print(built == rebuilt)
+# False
+print(built is rebuilt)
+# True
+print(sys.intern(built) is sys.intern(rebuilt))
+# True
+print(sys.intern(built) is literal)
+print("")
+
+print("Testing mutation of interned strings")
+key = "total"
+other = "total"
+# True
+print(key == other)
+key += "s"
+# False
+print(key == other)
+# totals
+print(key)
+# total
+print(other)
+counts = {"totals": 1}
+# 1
+print(counts[key])
+print("")
+
+print("Testing set probes with built strings")
+built = "ab"
+built += "c"
+words = {"abc", "def"}
+# True
+print(built in words)
+print("")
+
+print("Testing literals evaluated again")
+def label():
+    return "shared"
+
+# True
+print(label() is label())
+i = 0
+while i < 3:
+    word = "loop"
+    word += str(i)
+    print(word)
+    i += 1
+# loop0
+# loop1
+# loop2
+# loop
+print("loop")
+print("")
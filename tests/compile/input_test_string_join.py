@@ -0,0 +1,20 @@
+# join copies every element as is, quotes included
+quoted = ["'single'", "'quoted'", "plain"]
+print(", ".join(quoted))
+print("".join(["a", "b", "c"]))
+print("-".join(("x", "y", "z")))
+print("|".join([]))
+print("+".join(["only"]))
+print(len(" ".join(["", "", ""])))
+# 'single', 'quoted', plain
+# abc
+# x-y-z
+#
+# only
+# 2
+
+# joining a string joins its characters
+print(".".join("abc"))
+print("·".join("año"))
+# a.b.c
+# a·ñ·o
@@ -40,6 +40,9 @@ print("\nsplit examples:")
 print("a,b,c".split(","))                 # Outputs: ['a', 'b', 'c']
 print("hello world".split())              # Outputs: ['hello', 'world']
 print("hello world".split(" ", 1))        # Outputs: ['hello', 'world']
+print("  a  b\tc\n".split())              # Outputs: ['a', 'b', 'c']
+print(" \t ".split())                      # Outputs: []
+print("a  b".split(" "))                  # Outputs: ['a', '', 'b']
 
 # capitalize
 print("\ncapitalize example:")
@@ -155,6 +158,7 @@ print("hello world".rpartition(" "))  # Outputs: ('hello', ' ', 'world')
 # rsplit
 print("\nrsplit example:")
 print("a,b,c".rsplit(",", 1))  # Outputs: ['a,b', 'c']
+print(" x  y ".rsplit())       # Outputs: ['x', 'y']
 
 # rstrip
 print("\nrstrip example:")
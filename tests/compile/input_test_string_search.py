@@ -0,0 +1,71 @@
+# Searches over short and long texts, with short and long needles
+text: str = "one two three two one"
+print(text.find("two"))
+print(text.find("two", 5))
+print(text.find("two", 5, 10))
+print(text.find("two", 5, 17))
+print(text.rfind("two"))
+print(text.rfind("two", 0, 10))
+print(text.rfind("one", 1))
+print(text.find("four"))
+print(text.index("three"))
+print(text.rindex("o"))
+print(text.count("o"))
+print(text.count("two", 5))
+print(text.count(""))
+# 4
+# 14
+# -1
+# 14
+# 14
+# 4
+# 18
+# -1
+# 8
+# 18
+# 4
+# 1
+# 22
+
+long_text: str = "abc" * 100 + "needle in a haystack" + "xyz" * 100
+print(long_text.find("needle"))
+print(long_text.rfind("c"))
+print(long_text.find("abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcneedle"))
+print(long_text.count("abc"))
+print(long_text.count("needle in a haystack"))
+# 300
+# 318
+# 231
+# 100
+# 1
+
+print(text.replace("two", "2"))
+print(text.replace("o", ""))
+print("abc".replace("", "-"))
+print(text.replace("missing", "found"))
+# one 2 three 2 one
+# ne tw three tw ne
+# -a-b-c-
+# one two three two one
+
+print(text.split(" "))
+print(text.split("two"))
+print(text.split(" ", 2))
+print(text.rsplit(" ", 2))
+print("a,b,,c".rsplit(","))
+print("xx".rsplit("x"))
+# ['one', 'two', 'three', 'two', 'one']
+# ['one ', ' three ', ' one']
+# ['one', 'two', 'three two one']
+# ['one two three', 'two', 'one']
+# ['a', 'b', '', 'c']
+# ['', '', '']
+
+print(text.partition("two"))
+print(text.rpartition("two"))
+print(text.partition("four"))
+print(text.rpartition("four"))
+# ('one ', 'two', ' three two one')
+# ('one two three ', 'two', ' one')
+# ('one two three two one', '', '')
+# ('', '', 'one two three two one')
@@ -0,0 +1,93 @@
+# Lengths, indices and slices count code points, not bytes
+word: str = "año"
+print(len(word))
+print(word[1])
+print(word[-1])
+print(word[1:3])
+# 3
+# ñ
+# o
+# ño
+
+greeting: str = "καλημέρα κόσμε"
+print(len(greeting))
+print(greeting[0])
+print(greeting[9:14])
+print(greeting.find("κόσμε"))
+print(greeting.index("μ"))
+print(greeting.rfind("α"))
+print(greeting.count("α"))
+# 14
+# κ
+# κόσμε
+# 9
+# 4
+# 7
+# 2
+
+# Long text, indices past the first checkpoints
+long_text: str = "ünïcödé " * 40
+print(len(long_text))
+print(long_text[300])
+print(long_text[-2])
+print(long_text[317:320])
+print(long_text.find("d", 300))
+# 320
+# ö
+# é
+# dé
+# 301
+
+print(list("día"))
+print("€".isascii())
+# ['d', 'í', 'a']
+# False
+
+print(ord("A"))
+print(ord("ñ"))
+print(ord("€"))
+print(ord("😀"))
+print(chr(241))
+print(chr(8364))
+print(chr(128512))
+print(chr(ord("é")) == "é")
+# 65
+# 241
+# 8364
+# 128512
+# ñ
+# €
+# 😀
+# True
+
+# Loops walk code points too
+for letter in "añ€😀":
+    print(letter)
+# a
+# ñ
+# €
+# 😀
+letters = []
+for letter in long_text:
+    letters.append(letter)
+print(len(letters))
+print(letters[2])
+# 320
+# ï
+text: str = "día"
+for letter in text:
+    text += "!"
+print(text)
+# día!!!
+
+# The empty string matches between code points
+print("ñ".count(""))
+print(greeting.count(""))
+print(greeting.count("", 9))
+print(greeting.count("", 20))
+print("".count(""))
+# 2
+# 15
+# 6
+# 0
+# 1
@@ -0,0 +1,51 @@
+# Pieces of a string share its buffer until one of them changes
+record: str = "first field of the record, long enough to be shared|second field of the record, also long enough|x"
+fields: list = record.split("|")
+print(len(fields))
+print(fields[0])
+print(fields[2])
+# 3
+# first field of the record, long enough to be shared
+# x
+
+piece: str = record[0:40]
+print(piece)
+# first field of the record, long enough t
+piece += " (edited)"
+print(piece)
+print(record[0:40])
+# first field of the record, long enough t (edited)
+# first field of the record, long enough t
+
+parts: tuple = record.partition("|")
+print(parts[0] == "first field of the record, long enough to be shared")
+print(parts[2])
+# True
+# second field of the record, also long enough|x
+
+# Views compare, hash and sort like any other string
+counts: dict = {}
+lines: str = "a line that repeats more than thirty two bytes\n" * 3
+for line in lines.split("\n"):
+    counts[line] = 1
+print(len(counts))
+print("a line that repeats more than thirty two bytes" in counts)
+# 2
+# True
+
+sentence: str = "zeta alpha " * 2
+words: list = sentence.split(" ")
+words.sort()
+print(words)
+# ['', 'alpha', 'alpha', 'zeta', 'zeta']
+
+# Views outlive the string they were cut from
+text: str = "header|" + "payload " * 8
+pieces: list = text.rsplit("|", 1)
+text = "replaced"
+print(text)
+print(pieces)
+print(pieces[1] == "payload payload payload payload payload payload payload payload ")
+# replaced
+# ['header', 'payload payload payload payload payload payload payload payload ']
+# True
@@ -0,0 +1,52 @@
+print("Testing unpacking loops over tuple records")
+rows = [(1, 2.5, "a"), (2, 3.5, "b"), (3, 4.5, "c")]
+for number, price, name in rows:
+    print(number)
+    print(price)
+    print(name)
+print("")
+
+print("Testing repeated loops and appends")
+rows.append((4, 5.5, "d"))
+for number, price, name in rows:
+    print(name)
+for number, price, name in rows:
+    if name == "b":
+        rows.append((5, 6.5, "e"))
+    print(number)
+# 5
+print(len(rows))
+print("")
+
+print("Testing loops after mutation")
+rows[0] = (10, 0.5, "z")
+rows.pop()
+for number, price, name in rows:
+    print(name)
+rows.append([7, 7.5, "list"])
+for number, price, name in rows:
+    print(number)
+print("")
+
+print("Testing unpacking other records")
+ages = {"ana": 31, "luis": 27}
+for key, value in ages.items():
+    print(key)
+    print(value)
+for index, letter in enumerate("xyz"):
+    print(index)
+    print(letter)
+pairs = ((1, 2), (3, 4))
+for first, second in pairs:
+    print(second)
+print("")
+
+print("Testing mutation inside the loop")
+rows = [(1, "a"), (2, "b"), (3, "c")]
+for number, name in rows:
+    if number == 1:
+        rows[2] = (30, "replaced")
+    if number == 2:
+        rows.append((4, "appended"))
+    print(name)
+print(len(rows))
@@ -253,3 +253,46 @@ def test_complex_case(lexer: FanglessLexer) -> None:
     assert tokens[index].type == "R_PARENTHESIS"
     index += 1
     assert tokens[index].type == "END_TOKEN"
+
+
+def test_format_string(lexer: FanglessLexer) -> None:
+    lexer.lex_stream('f"{a} and {b + 1:>5}!"')
+    tokens = [(token.type, token.value) for token in lexer.token_stream]
+
+    assert tokens[1:-1] == [
+        ("STRING", "{0} and {1:>5}!"),
+        ("DOT", None),
+        ("NAME", "format"),
+        ("L_PARENTHESIS", None),
+        ("NAME", "a"),
+        ("COMMA", None),
+        ("NAME", "b"),
+        ("PLUS", "+"),
+        ("INTEGER_NUMBER", 1),
+        ("R_PARENTHESIS", None),
+    ]
+
+
+def test_list_comprehension(lexer: FanglessLexer) -> None:
+    lexer.lex_stream("[int(x) for x in [y for y in z]]")
+    tokens = [token.type for token in lexer.token_stream]
+
+    assert tokens[1:-1] == [
+        "L_BRACKET",
+        "FOR", "NAME", "IN",
+        "L_BRACKET", "FOR", "NAME", "IN", "NAME", "COLON", "NAME",
+        "R_BRACKET",
+        "COLON", "NAME", "L_PARENTHESIS", "NAME", "R_PARENTHESIS",
+        "R_BRACKET",
+    ]
+
+
+def test_module_functions(lexer: FanglessLexer) -> None:
+    lexer.lex_stream("import math\nx = math.gcd(a, b)\n")
+    tokens = [token.type for token in lexer.token_stream]
+
+    assert tokens[1:9] == [
+        "NAME", "EQUAL", "NAME",
+        "L_PARENTHESIS", "NAME", "COMMA", "NAME", "R_PARENTHESIS",
+    ]
+    assert lexer.token_stream[3].value == "math.gcd"